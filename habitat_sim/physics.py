@@ -3,8 +3,10 @@
 # LICENSE file in the root directory of this source tree.
 
 from habitat_sim._ext.habitat_sim_bindings import (
+    ContactPairInfo,
     MotionType,
     PhysicsSimulationLibrary,
+    RaycastBatchResults,
     RaycastResults,
     RayHitInfo,
     VelocityControl,
@@ -16,4 +18,6 @@ __all__ = [
     "VelocityControl",
     "RayHitInfo",
     "RaycastResults",
+    "RaycastBatchResults",
+    "ContactPairInfo",
 ]
@@ -32,7 +32,7 @@ from habitat_sim.bindings import cuda_enabled
 from habitat_sim.logging import logger
 from habitat_sim.metadata import MetadataMediator
 from habitat_sim.nav import GreedyGeodesicFollower, NavMeshSettings, PathFinder
-from habitat_sim.sensor import SensorSpec, SensorType
+from habitat_sim.sensor import CameraSensor, SensorSpec, SensorType
 from habitat_sim.sensors.noise_models import make_sensor_noise_model
 from habitat_sim.sim import SimulatorBackend, SimulatorConfiguration
 from habitat_sim.utils.common import quat_from_angle_axis
@@ -318,18 +318,18 @@ class Simulator(SimulatorBackend):
 
     @overload
     def get_sensor_observations(
-        self, agent_ids: int = 0
+        self, agent_ids: int = 0, draw: bool = True
     ) -> Dict[str, Union[ndarray, "Tensor"]]:
         ...
 
     @overload
     def get_sensor_observations(
-        self, agent_ids: List[int]
+        self, agent_ids: List[int], draw: bool = True
     ) -> Dict[int, Dict[str, Union[ndarray, "Tensor"]]]:
         ...
 
     def get_sensor_observations(
-        self, agent_ids: Union[int, List[int]] = 0
+        self, agent_ids: Union[int, List[int]] = 0, draw: bool = True
     ) -> Union[
         Dict[str, Union[ndarray, "Tensor"]],
         Dict[int, Dict[str, Union[ndarray, "Tensor"]]],
@@ -340,10 +340,8 @@ class Simulator(SimulatorBackend):
         else:
             return_single = False
 
-        for agent_id in agent_ids:
-            agent_sensorsuite = self.__sensors[agent_id]
-            for _sensor_uuid, sensor in agent_sensorsuite.items():
-                sensor.draw_observation()
+        if draw:
+            self._draw_sensor_observations(agent_ids)
 
         # As backport. All Dicts are ordered in Python >= 3.7
         observations: Dict[int, Dict[str, Union[ndarray, "Tensor"]]] = OrderedDict()
@@ -356,6 +354,43 @@ class Simulator(SimulatorBackend):
             return next(iter(observations.values()))
         return observations
 
+    def _draw_sensor_observations(self, agent_ids: List[int]) -> None:
+        for agent_id in agent_ids:
+            agent_sensorsuite = self.__sensors[agent_id]
+            # co-located sensors read their observations from the frame drawn
+            # for the first of them instead of drawing the scene again
+            drawn: List[Sensor] = []
+            for _sensor_uuid, sensor in agent_sensorsuite.items():
+                shared = None
+                if self.fused_sensor_rendering:
+                    shared = next(
+                        (other for other in drawn if sensor.can_share_draw(other)),
+                        None,
+                    )
+                if shared is None:
+                    sensor.draw_observation()
+                    drawn.append(sensor)
+                else:
+                    sensor.share_draw(shared)
+
+    def start_sensor_observations(self, agent_ids: Union[int, List[int]] = 0) -> None:
+        r"""Draws the observations of the sensors of the given agents and starts
+        reading them back without waiting for the GPU.
+
+        The simulation can be stepped in the meantime, e.g. with
+        `step_physics`, while the observations drawn here are read. They
+        are then returned by the next call to `get_sensor_observations`
+        with `draw=False`.
+        """
+        if isinstance(agent_ids, int):
+            agent_ids = [agent_ids]
+        self._draw_sensor_observations(agent_ids)
+
+        # start all the reads before waiting for any of them
+        for agent_id in agent_ids:
+            for _sensor_uuid, sensor in self.__sensors[agent_id].items():
+                sensor.start_readback()
+
     @property
     def _default_agent(self) -> Agent:
         # TODO Deprecate and remove
@@ -531,6 +566,11 @@ class Sensor:
                     dtype=np.uint8,
                 )
 
+        self._pending_readback = None
+        # the sensor whose frame the observation is read from, if not drawn
+        # by this sensor itself
+        self._drawn_by: Optional["Sensor"] = None
+
         noise_model_kwargs = self._spec.noise_model_kwargs
         self._noise_model = make_sensor_noise_model(
             self._spec.noise_model,
@@ -542,7 +582,34 @@ class Sensor:
             self._spec.noise_model, self._spec.uuid
         )
 
+    def can_share_draw(self, other: "Sensor") -> bool:
+        r"""Whether the observation of this sensor can be read from the frame
+        drawn for the other sensor instead of being drawn again.
+        """
+        return (
+            isinstance(self._sensor_object, CameraSensor)
+            and isinstance(other._sensor_object, CameraSensor)
+            and self._sensor_object.can_share_observation_draw(
+                self._sim, other._sensor_object
+            )
+        )
+
+    def share_draw(self, other: "Sensor") -> None:
+        r"""Reads the observation from the frame drawn by the other sensor,
+        see `can_share_draw`, instead of drawing it.
+        """
+        self._discard_readback()
+        self._drawn_by = other
+
+    def _render_target(self):
+        if self._drawn_by is not None:
+            return self._drawn_by._sensor_object.render_target
+        return self._sensor_object.render_target
+
     def draw_observation(self) -> None:
+        self._discard_readback()
+        self._drawn_by = None
+
         # sanity check:
 
         # see if the sensor is attached to a scene graph, otherwise it is invalid,
@@ -573,11 +640,16 @@ class Sensor:
         agent_node = self._agent.scene_node
         agent_node.parent = scene.get_root_node()
 
-        render_flags = habitat_sim.gfx.Camera.Flags.NONE
+        # copies of the same asset are merged into instanced draws where possible
+        render_flags = habitat_sim.gfx.Camera.Flags.INSTANCING
 
         if self._sim.frustum_culling:
             render_flags |= habitat_sim.gfx.Camera.Flags.FRUSTUM_CULLING
 
+        # simplified meshes would shift the boundaries between semantic ids
+        if self._spec.sensor_type != SensorType.SEMANTIC:
+            render_flags |= habitat_sim.gfx.Camera.Flags.MESH_LOD
+
         with self._sensor_object.render_target:
             self._sim.renderer.draw(self._sensor_object, scene, render_flags)
 
@@ -593,9 +665,48 @@ class Sensor:
                 self._sensor_object, self._sim.get_active_scene_graph(), render_flags
             )
 
+    def _buffer_view(self) -> mn.MutableImageView2D:
+        size = self._sensor_object.framebuffer_size
+        if self._spec.sensor_type == SensorType.SEMANTIC:
+            return mn.MutableImageView2D(mn.PixelFormat.R32UI, size, self._buffer)
+        elif self._spec.sensor_type == SensorType.DEPTH:
+            return mn.MutableImageView2D(mn.PixelFormat.R32F, size, self._buffer)
+        else:
+            return mn.MutableImageView2D(
+                mn.PixelFormat.RGBA8_UNORM,
+                size,
+                self._buffer.reshape(self._spec.resolution[0], -1),
+            )
+
+    def _discard_readback(self) -> None:
+        # a readback of an older frame still writes into the buffer, and the
+        # frame drawn next is read synchronously unless it's started again
+        if self._pending_readback is not None:
+            self._pending_readback.wait()
+            self._pending_readback = None
+
+    def start_readback(self) -> None:
+        r"""Starts reading the drawn observation into the sensor's buffer without
+        waiting for the GPU. `get_observation` then waits for it.
+        """
+        if self._spec.gpu2gpu_transfer:
+            return
+
+        tgt = self._render_target()
+        self._discard_readback()
+
+        if self._spec.sensor_type == SensorType.SEMANTIC:
+            self._pending_readback = tgt.read_frame_object_id_async(
+                self._buffer_view()
+            )
+        elif self._spec.sensor_type == SensorType.DEPTH:
+            self._pending_readback = tgt.read_frame_depth_async(self._buffer_view())
+        else:
+            self._pending_readback = tgt.read_frame_rgba_async(self._buffer_view())
+
     def get_observation(self) -> Union[ndarray, "Tensor"]:
 
-        tgt = self._sensor_object.render_target
+        tgt = self._render_target()
 
         if self._spec.gpu2gpu_transfer:
             with torch.cuda.device(self._buffer.device):  # type: ignore[attr-defined]
@@ -608,24 +719,15 @@ class Sensor:
 
                 obs = self._buffer.flip(0)
         else:
-            size = self._sensor_object.framebuffer_size
-
-            if self._spec.sensor_type == SensorType.SEMANTIC:
-                tgt.read_frame_object_id(
-                    mn.MutableImageView2D(mn.PixelFormat.R32UI, size, self._buffer)
-                )
+            if self._pending_readback is not None:
+                self._pending_readback.wait()
+                self._pending_readback = None
+            elif self._spec.sensor_type == SensorType.SEMANTIC:
+                tgt.read_frame_object_id(self._buffer_view())
             elif self._spec.sensor_type == SensorType.DEPTH:
-                tgt.read_frame_depth(
-                    mn.MutableImageView2D(mn.PixelFormat.R32F, size, self._buffer)
-                )
+                tgt.read_frame_depth(self._buffer_view())
             else:
-                tgt.read_frame_rgba(
-                    mn.MutableImageView2D(
-                        mn.PixelFormat.RGBA8_UNORM,
-                        size,
-                        self._buffer.reshape(self._spec.resolution[0], -1),
-                    )
-                )
+                tgt.read_frame_rgba(self._buffer_view())
 
             obs = np.flip(self._buffer, axis=0)
 
@@ -635,3 +737,4 @@ class Sensor:
         self._sim = None
         self._agent = None
         self._sensor_object = None
+        self._drawn_by = None
@@ -50,6 +50,13 @@ Use "HEADLESS=True pip install ." to build in headless mode with pip""",
         action="store_true",
         help="""Build with Bullet simulation engine.""",
     )
+    parser.add_argument(
+        "--bullet-mt",
+        "--with-bullet-mt",
+        dest="with_bullet_mt",
+        action="store_true",
+        help="""Build the bundled Bullet thread-safe, for multithreaded physics worlds.""",
+    )
     parser.add_argument(
         "--cmake",
         "--force-cmake",
@@ -254,6 +261,9 @@ class CMakeBuild(build_ext):
         cmake_args += [
             "-DBUILD_WITH_BULLET={}".format("ON" if args.with_bullet else "OFF")
         ]
+        cmake_args += [
+            "-DBUILD_WITH_BULLET_MT={}".format("ON" if args.with_bullet_mt else "OFF")
+        ]
         cmake_args += [
             "-DBUILD_DATATOOL={}".format("ON" if args.build_datatool else "OFF")
         ]
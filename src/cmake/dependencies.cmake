@@ -97,6 +97,7 @@ set(RECASTNAVIGATION_EXAMPLES OFF CACHE BOOL "RECASTNAVIGATION_EXAMPLES" FORCE)
 set(RECASTNAVIGATION_STATIC ON CACHE BOOL "RECASTNAVIGATION_STATIC" FORCE)
 add_subdirectory("${DEPS_DIR}/recastnavigation/Recast")
 add_subdirectory("${DEPS_DIR}/recastnavigation/Detour")
+add_subdirectory("${DEPS_DIR}/recastnavigation/DetourCrowd")
 # Needed so that Detour doesn't hide the implementation of the method on dtQueryFilter
 target_compile_definitions(Detour PUBLIC DT_VIRTUAL_QUERYFILTER)
 
@@ -141,6 +142,14 @@ if(BUILD_WITH_BULLET AND NOT USE_SYSTEM_BULLET)
   set(BUILD_CLSOCKET OFF CACHE BOOL "" FORCE)
   set(BUILD_EXTRAS OFF CACHE BOOL "" FORCE)
   set(BUILD_BULLET3 OFF CACHE BOOL "" FORCE)
+  # Thread-safe Bullet with its own task scheduler, needed by the
+  # multithreaded dynamics world. It makes the single-threaded world slower,
+  # so it's opt-in. There are no threads on Emscripten.
+  if(BUILD_WITH_BULLET_MT AND NOT CORRADE_TARGET_EMSCRIPTEN)
+    set(BULLET2_MULTITHREADING ON CACHE BOOL "" FORCE)
+  else()
+    set(BULLET2_MULTITHREADING OFF CACHE BOOL "" FORCE)
+  endif()
   # This is needed in case BUILD_EXTRAS is enabled, as you'd get a CMake syntax
   # error otherwise
   set(PKGCONFIG_INSTALL_PREFIX "lib${LIB_SUFFIX}/pkgconfig/")
@@ -24,6 +24,9 @@
 #include "esp/gfx/magnum.h"
 
 namespace esp {
+namespace gfx {
+struct MeshLODs;
+}
 namespace assets {
 
 /**
@@ -121,6 +124,17 @@ class BaseMesh {
    * sub-component of the asset.
    */
   virtual Magnum::GL::Mesh* getMagnumGLMesh(int) { return nullptr; }
+
+  /**
+   * @brief Get a pointer to the coarser levels of detail of the compiled
+   * rendering buffer, see @ref gfx::Drawable::setMeshLODs().
+   *
+   * Always nullptr for @ref BaseMesh.
+   * @return A pointer to the levels of detail, nullptr if none were
+   * generated.
+   */
+  virtual gfx::MeshLODs* getMeshLODs() { return nullptr; }
+
   Corrade::Containers::Optional<Magnum::Trade::MeshData>& getMeshData() {
     return meshData_;
   }
@@ -32,6 +32,9 @@ void GenericMeshData::uploadBuffersToGPU(bool forceReload) {
   }
   // position, normals, uv, colors are bound to corresponding attributes
   renderingBuffer_->mesh = Magnum::MeshTools::compile(*meshData_, compileFlags);
+  if (generateLODs_) {
+    renderingBuffer_->lods = gfx::generateMeshLODs(*meshData_, compileFlags);
+  }
 
   buffersOnGPU_ = true;
 }
@@ -44,6 +47,14 @@ Magnum::GL::Mesh* GenericMeshData::getMagnumGLMesh() {
   return &(renderingBuffer_->mesh);
 }
 
+gfx::MeshLODs* GenericMeshData::getMeshLODs() {
+  if (renderingBuffer_ == nullptr || renderingBuffer_->lods.levels.empty()) {
+    return nullptr;
+  }
+
+  return &(renderingBuffer_->lods);
+}
+
 void GenericMeshData::setMeshData(Magnum::Trade::MeshData&& meshData) {
   /* Interleave the mesh, if not already. This makes the GPU happier (better
      cache locality for vertex fetching) and is a no-op if the source data is
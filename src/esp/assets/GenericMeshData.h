@@ -16,6 +16,7 @@
 
 #include "BaseMesh.h"
 #include "esp/core/esp.h"
+#include "esp/gfx/MeshLOD.h"
 
 namespace esp {
 namespace assets {
@@ -34,6 +35,12 @@ class GenericMeshData : public BaseMesh {
      * @brief Compiled openGL render data for the mesh.
      */
     Magnum::GL::Mesh mesh;
+
+    /**
+     * @brief Coarser levels of detail of @ref mesh, see
+     * @ref setGenerateLODs().
+     */
+    gfx::MeshLODs lods;
   };
 
   /** @brief Constructor. Sets @ref SupportedMeshType::GENERIC_MESH to identify
@@ -97,6 +104,19 @@ class GenericMeshData : public BaseMesh {
    */
   virtual Magnum::GL::Mesh* getMagnumGLMesh() override;
 
+  /**
+   * @brief Set whether @ref uploadBuffersToGPU also simplifies the mesh into
+   * coarser levels of detail, see @ref gfx::generateMeshLODs().
+   */
+  void setGenerateLODs(bool generateLODs) { generateLODs_ = generateLODs; }
+
+  /**
+   * @brief Returns a pointer to the levels of detail stored in the @ref
+   * renderingBuffer_.
+   * @return Pointer to the levels of detail, nullptr if the mesh has none.
+   */
+  virtual gfx::MeshLODs* getMeshLODs() override;
+
  protected:
   /**
    * @brief Storage structure for compiled render data. We will use a smart
@@ -107,6 +127,8 @@ class GenericMeshData : public BaseMesh {
 
   bool needsNormals_ = true;
 
+  bool generateLODs_ = false;
+
  private:
   /* Internal; can store data referenced by positions / indices if the original
      MeshData doesn't have them in desired type */
@@ -1643,6 +1643,7 @@ void ResourceManager::loadMeshes(Importer& importer,
     auto gltfMeshData = std::make_unique<GenericMeshData>(
         loadedAssetData.assetInfo.requiresLighting);
     gltfMeshData->importAndSetMeshData(importer, iMesh);
+    gltfMeshData->setGenerateLODs(generateMeshLODs_);
 
     // compute the mesh bounding box
     gltfMeshData->BB = computeMeshBB(gltfMeshData.get());
@@ -1934,7 +1935,8 @@ void ResourceManager::addComponent(
                    node,                // scene node
                    lightSetupKey,       // lightSetup Key
                    materialKey,         // material key
-                   drawables);          // drawable group
+                   drawables,           // drawable group
+                   meshes_.at(meshID)->getMeshLODs());  // levels of detail
 
     // compute the bounding box for the mesh we are adding
     if (computeAbsoluteAABBs) {
@@ -1976,6 +1978,12 @@ void ResourceManager::addPrimitiveToDrawables(int primitiveID,
 
 void ResourceManager::removePrimitiveMesh(int primitiveID) {
   CHECK(primitive_meshes_.count(primitiveID));
+  // release the per-instance buffer the mesh may have been drawn with, so
+  // that a mesh later allocated at the same address does not pick it up
+  shaderManager_.set<Mn::GL::Buffer>(
+      gfx::GenericDrawable::getInstanceBufferKey(
+          *primitive_meshes_.at(primitiveID)),
+      nullptr, Mn::ResourceDataState::Mutable, Mn::ResourcePolicy::Manual);
   primitive_meshes_.erase(primitiveID);
 }
 
@@ -1984,15 +1992,17 @@ void ResourceManager::createDrawable(Mn::GL::Mesh& mesh,
                                      scene::SceneNode& node,
                                      const Mn::ResourceKey& lightSetupKey,
                                      const Mn::ResourceKey& materialKey,
-                                     DrawableGroup* group /* = nullptr */) {
+                                     DrawableGroup* group /* = nullptr */,
+                                     gfx::MeshLODs* meshLODs /* = nullptr */) {
   const auto& materialDataType =
       shaderManager_.get<gfx::MaterialData>(materialKey)->type;
+  gfx::Drawable* drawable = nullptr;
   switch (materialDataType) {
     case gfx::MaterialDataType::None:
       CORRADE_INTERNAL_ASSERT_UNREACHABLE();
       break;
     case gfx::MaterialDataType::Phong:
-      node.addFeature<gfx::GenericDrawable>(
+      drawable = &node.addFeature<gfx::GenericDrawable>(
           mesh,                // render mesh
           meshAttributeFlags,  // mesh attribute flags
           shaderManager_,      // shader manager
@@ -2001,7 +2011,7 @@ void ResourceManager::createDrawable(Mn::GL::Mesh& mesh,
           group);              // drawable group
       break;
     case gfx::MaterialDataType::Pbr:
-      node.addFeature<gfx::PbrDrawable>(
+      drawable = &node.addFeature<gfx::PbrDrawable>(
           mesh,                // render mesh
           meshAttributeFlags,  // mesh attribute flags
           shaderManager_,      // shader manager
@@ -2010,6 +2020,9 @@ void ResourceManager::createDrawable(Mn::GL::Mesh& mesh,
           group);              // drawable group
       break;
   }
+  if (drawable) {
+    drawable->setMeshLODs(meshLODs);
+  }
 }
 
 bool ResourceManager::loadSUNCGHouseFile(const AssetInfo& houseInfo,
@@ -309,6 +309,12 @@ class ResourceManager {
                          DEFAULT_LIGHTING_KEY}) {
     shaderManager_.set(key, std::move(setup), Mn::ResourceDataState::Mutable,
                        Mn::ResourcePolicy::Manual);
+    // the uniform buffer shared by drawables still holds the old lights
+    Mn::Resource<gfx::LightBuffer> lightBuffer =
+        shaderManager_.get<gfx::LightBuffer>(key);
+    if (lightBuffer) {
+      lightBuffer->invalidate();
+    }
   }
 
   /**
@@ -429,6 +435,13 @@ class ResourceManager {
    */
   inline void setRequiresTextures(bool newVal) { requiresTextures_ = newVal; }
 
+  /**
+   * @brief Sets whether or not meshes loaded from now on are simplified into
+   * coarser levels of detail, drawn instead of the full-detail meshes by
+   * render passes with @ref gfx::RenderCamera::Flag::MeshLOD.
+   */
+  inline void setGenerateMeshLODs(bool newVal) { generateMeshLODs_ = newVal; }
+
   /**
    * @brief Set a replay recorder so that ResourceManager can notify it about
    * render assets.
@@ -866,6 +879,7 @@ class ResourceManager {
    * meshes_
    * @param group Optional @ref DrawableGroup with which the render the @ref
    * gfx::Drawable.
+   * @param meshLODs Optional coarser levels of detail of the render mesh.
    * @param texture Optional texture for the mesh.
    * @param color Optional color parameter for the shader program. Defaults to
    * white.
@@ -876,7 +890,8 @@ class ResourceManager {
                       scene::SceneNode& node,
                       const Mn::ResourceKey& lightSetupKey,
                       const Mn::ResourceKey& materialKey,
-                      DrawableGroup* group = nullptr);
+                      DrawableGroup* group = nullptr,
+                      gfx::MeshLODs* meshLODs = nullptr);
 
   Flags flags_;
 
@@ -969,6 +984,11 @@ class ResourceManager {
    */
   bool requiresTextures_ = true;
 
+  /**
+   * @brief Flag to generate levels of detail of meshes
+   */
+  bool generateMeshLODs_ = false;
+
   /**
    * @brief See @ref setRecorder.
    */
@@ -315,7 +315,24 @@ void initAttributesBindings(py::module& m) {
           &PhysicsManagerAttributes::getRestitutionCoefficient,
           &PhysicsManagerAttributes::setRestitutionCoefficient,
           R"(Default restitution coefficient for contact modeling.  Can be overridden by
-          stage and object values.)");
+          stage and object values.)")
+      .def_property(
+          "stage_bvh_cache_directory",
+          &PhysicsManagerAttributes::getStageBvhCacheDirectory,
+          &PhysicsManagerAttributes::setStageBvhCacheDirectory,
+          R"(Directory where the bounding volume hierarchies of the stage collision
+          meshes are cached between loads, so that loading a stage again skips
+          building them. Empty to always build them.)")
+      .def_property(
+          "multithreaded", &PhysicsManagerAttributes::getMultithreaded,
+          &PhysicsManagerAttributes::setMultithreaded,
+          R"(Whether to step the simulation with Bullet's multithreaded dynamics
+          world. Requires Bullet built with BULLET2_MULTITHREADING.)")
+      .def_property(
+          "num_threads", &PhysicsManagerAttributes::getNumThreads,
+          &PhysicsManagerAttributes::setNumThreads,
+          R"(The number of threads of the multithreaded dynamics world. 0 to use
+          one per hardware thread.)");
 
   // ==== AbstractPrimitiveAttributes ====
   py::class_<AbstractPrimitiveAttributes, AbstractAttributes,
@@ -51,6 +51,8 @@ void initGfxBindings(py::module& m) {
 
   flags.value("FRUSTUM_CULLING", RenderCamera::Flag::FrustumCulling)
       .value("OBJECTS_ONLY", RenderCamera::Flag::ObjectsOnly)
+      .value("INSTANCING", RenderCamera::Flag::Instancing)
+      .value("MESH_LOD", RenderCamera::Flag::MeshLOD)
       .value("NONE", RenderCamera::Flag{});
   corrade::enumOperators(flags);
 
@@ -96,7 +98,45 @@ void initGfxBindings(py::module& m) {
           },
           R"(Draw given scene using the camera)", "camera"_a, "scene"_a,
           "flags"_a = RenderCamera::Flag{RenderCamera::Flag::FrustumCulling})
-      .def("bind_render_target", &Renderer::bindRenderTarget);
+      .def("bind_render_target", &Renderer::bindRenderTarget)
+      .def("create_batch_render_target", &Renderer::createBatchRenderTarget,
+           R"(Creates a render target with num_tiles tiles of tile_size for
+          draw_batch.)",
+           "tile_size"_a, "num_tiles"_a, "depth_unprojection"_a)
+      .def(
+          "draw_batch",
+          [](Renderer& self, RenderTarget& target,
+             const std::vector<RenderCamera*>& cameras,
+             const std::vector<scene::SceneGraph*>& scenes,
+             RenderCamera::Flag flags) {
+            if (cameras.size() != scenes.size()) {
+              throw py::value_error{
+                  "cameras and scenes must have the same length"};
+            }
+            std::vector<Renderer::BatchView> views;
+            views.reserve(cameras.size());
+            for (std::size_t i = 0; i < cameras.size(); ++i) {
+              views.push_back({cameras[i], scenes[i]});
+            }
+            return self.drawBatch(target, views, RenderCamera::Flags{flags});
+          },
+          R"(Draws scenes[i] using cameras[i] into tile i of target, which was
+          created by create_batch_render_target. Returns the number of
+          drawables drawn.)",
+          "target"_a, "cameras"_a, "scenes"_a,
+          "flags"_a = RenderCamera::Flag{RenderCamera::Flag::FrustumCulling});
+
+  py::class_<PendingReadback, PendingReadback::ptr>(
+      m, "PendingReadback",
+      R"(Rendering results being read asynchronously by one of the
+      read_frame_*_async functions of RenderTarget.)")
+      .def_property_readonly(
+          "is_ready", &PendingReadback::isReady,
+          R"(Whether the GPU finished writing the results, so wait() won't block.)")
+      .def_property_readonly("is_done", &PendingReadback::isDone)
+      .def("wait", &PendingReadback::wait,
+           R"(Waits for the results and copies them into the image passed to the
+          read.)");
 
   py::class_<RenderTarget>(m, "RenderTarget")
       .def("__enter__",
@@ -107,10 +147,25 @@ void initGfxBindings(py::module& m) {
       .def("__exit__",
            [](RenderTarget& self, const py::object&, const py::object&,
               const py::object&) { self.renderExit(); })
+      .def_property_readonly("tile_size", &RenderTarget::tileSize)
+      .def_property_readonly("num_tiles", &RenderTarget::numTiles)
+      .def_property_readonly(
+          "read_frame_size", &RenderTarget::readFrameSize,
+          R"(Size of the images read by the read_frame_* functions, the tiles
+          of a batch render target stacked on top of each other.)")
       .def("read_frame_rgba", &RenderTarget::readFrameRgba,
            "Reads RGBA frame into passed img in uint8 byte format.")
       .def("read_frame_depth", &RenderTarget::readFrameDepth)
       .def("read_frame_object_id", &RenderTarget::readFrameObjectId)
+      .def("read_frame_rgba_async", &RenderTarget::readFrameRgbaAsync,
+           R"(Starts reading the RGBA frame into img without waiting for the GPU.
+          img is only populated once the returned PendingReadback was waited
+          on.)",
+           py::keep_alive<0, 2>())
+      .def("read_frame_depth_async", &RenderTarget::readFrameDepthAsync,
+           py::keep_alive<0, 2>())
+      .def("read_frame_object_id_async", &RenderTarget::readFrameObjectIdAsync,
+           py::keep_alive<0, 2>())
       .def("blit_rgba_to_default", &RenderTarget::blitRgbaToDefault)
 #ifdef ESP_BUILD_WITH_CUDA
       .def("read_frame_rgba_gpu",
@@ -8,6 +8,15 @@ using py::literals::operator""_a;
 namespace esp {
 namespace physics {
 
+namespace {
+Eigen::Matrix<float, Eigen::Dynamic, 3, Eigen::RowMajor> vector3ArrayToMatrix(
+    const std::vector<Magnum::Vector3>& vectors) {
+  return Eigen::Map<
+      const Eigen::Matrix<float, Eigen::Dynamic, 3, Eigen::RowMajor>>(
+      reinterpret_cast<const float*>(vectors.data()), vectors.size(), 3);
+}
+}  // namespace
+
 void initPhysicsBindings(py::module& m) {
   // ==== enum object PhysicsSimulationLibrary ====
   py::enum_<PhysicsManager::PhysicsSimulationLibrary>(
@@ -48,6 +57,49 @@ void initPhysicsBindings(py::module& m) {
       .def_readonly("hits", &RaycastResults::hits)
       .def_readonly("ray", &RaycastResults::ray)
       .def("has_hits", &RaycastResults::hasHits);
+
+  // ==== struct object RaycastBatchResults ====
+  // the arrays are returned as numpy arrays, one row per hit
+  py::class_<RaycastBatchResults, RaycastBatchResults::ptr>(
+      m, "RaycastBatchResults")
+      .def(py::init(&RaycastBatchResults::create<>))
+      .def_property_readonly(
+          "ray_hit_offsets",
+          [](const RaycastBatchResults& self) {
+            return Eigen::VectorXi{Eigen::Map<const Eigen::VectorXi>(
+                self.rayHitOffsets.data(), self.rayHitOffsets.size())};
+          },
+          R"(The index of the first hit of each ray, followed by the number of hits. The hits of ray i are the rows ray_hit_offsets[i] to ray_hit_offsets[i + 1] of the other arrays.)")
+      .def_property_readonly("object_ids",
+                             [](const RaycastBatchResults& self) {
+                               return Eigen::VectorXi{
+                                   Eigen::Map<const Eigen::VectorXi>(
+                                       self.objectIds.data(),
+                                       self.objectIds.size())};
+                             })
+      .def_property_readonly("points",
+                             [](const RaycastBatchResults& self) {
+                               return vector3ArrayToMatrix(self.points);
+                             })
+      .def_property_readonly("normals",
+                             [](const RaycastBatchResults& self) {
+                               return vector3ArrayToMatrix(self.normals);
+                             })
+      .def_property_readonly(
+          "ray_distances",
+          [](const RaycastBatchResults& self) {
+            return Eigen::VectorXd{Eigen::Map<const Eigen::VectorXd>(
+                self.rayDistances.data(), self.rayDistances.size())};
+          })
+      .def("num_rays", &RaycastBatchResults::numRays)
+      .def("num_hits", &RaycastBatchResults::numHits, "ray_index"_a);
+
+  // ==== struct object ContactPairInfo ====
+  py::class_<ContactPairInfo, ContactPairInfo::ptr>(m, "ContactPairInfo")
+      .def(py::init(&ContactPairInfo::create<>))
+      .def_readonly("object_id_a", &ContactPairInfo::objectIdA)
+      .def_readonly("object_id_b", &ContactPairInfo::objectIdB)
+      .def_readonly("num_contact_points", &ContactPairInfo::numContactPoints);
 }
 
 }  // namespace physics
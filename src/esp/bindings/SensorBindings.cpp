@@ -16,6 +16,7 @@
 #ifdef ESP_BUILD_WITH_CUDA
 #include "esp/sensor/RedwoodNoiseModel.h"
 #endif
+#include "esp/sensor/RedwoodNoiseModelCPU.h"
 #include "esp/sensor/Sensor.h"
 #include "esp/sim/Simulator.h"
 
@@ -150,7 +151,29 @@ void initSensorBindings(py::module& m) {
           R"(The distance to the near clipping plane for this CameraSensor uses.)")
       .def_property(
           "far_plane_dist", &CameraSensor::getFar, &CameraSensor::setFar,
-          R"(The distance to the far clipping plane for this CameraSensor uses.)");
+          R"(The distance to the far clipping plane for this CameraSensor uses.)")
+      .def(
+          "can_share_observation_draw", &CameraSensor::canShareObservationDraw,
+          R"(Whether the observation of this CameraSensor can be read from the
+          frame drawn for the other sensor instead of being drawn again: both
+          are at the same pose, with the same resolution and projection, and
+          draw the same scene graphs.)",
+          "sim"_a, "other"_a);
+
+  py::class_<RedwoodNoiseModelCPUImpl, RedwoodNoiseModelCPUImpl::uptr>(
+      m, "RedwoodNoiseModelCPUImpl")
+      .def(py::init(&RedwoodNoiseModelCPUImpl::create_unique<
+                    const Eigen::Ref<const Eigen::RowMatrixXf>&, float,
+                    uint64_t>),
+           "model"_a, "noise_multiplier"_a, "seed"_a = 0)
+      .def("simulate",
+           py::overload_cast<const Eigen::Ref<const Eigen::RowMatrixXf>>(
+               &RedwoodNoiseModelCPUImpl::simulate),
+           R"(Simulates noisy depth from clean depth. Every call draws new
+          noise, the sequence of calls is reproducible for a given seed.)",
+           "depth"_a)
+      .def("set_seed", &RedwoodNoiseModelCPUImpl::setSeed,
+           R"(Restart the sequence of simulations from a seed.)", "seed"_a);
 
 #ifdef ESP_BUILD_WITH_CUDA
   py::class_<RedwoodNoiseModelGPUImpl, RedwoodNoiseModelGPUImpl::uptr>(
@@ -31,6 +31,12 @@ void initShortestPathBindings(py::module& m) {
       .def_readwrite("hit_normal", &HitRecord::hitNormal)
       .def_readwrite("hit_dist", &HitRecord::hitDist);
 
+  py::class_<PointsQueryResult>(m, "PointsQueryResult")
+      .def_readonly("snapped_points", &PointsQueryResult::snappedPoints)
+      .def_readonly("navigable", &PointsQueryResult::navigable)
+      .def_readonly("distances_to_closest_obstacle",
+                    &PointsQueryResult::distancesToClosestObstacle);
+
   py::class_<ShortestPath, ShortestPath::ptr>(m, "ShortestPath")
       .def(py::init(&ShortestPath::create<>))
       .def_readwrite("requested_start", &ShortestPath::requestedStart)
@@ -48,6 +54,15 @@ void initShortestPathBindings(py::module& m) {
       .def_readwrite("geodesic_distance",
                      &MultiGoalShortestPath::geodesicDistance);
 
+  py::class_<PathCorridor, PathCorridor::ptr>(m, "PathCorridor")
+      .def(py::init(&PathCorridor::create<>))
+      .def_readwrite("requested_start", &PathCorridor::requestedStart)
+      .def_readwrite("requested_end", &PathCorridor::requestedEnd)
+      .def_readwrite("points", &PathCorridor::points)
+      .def_readwrite("geodesic_distance", &PathCorridor::geodesicDistance)
+      .def_readwrite("max_update_distance", &PathCorridor::maxUpdateDistance)
+      .def("reset", &PathCorridor::reset);
+
   py::class_<NavMeshSettings, NavMeshSettings::ptr>(m, "NavMeshSettings")
       .def(py::init(&NavMeshSettings::create<>))
       .def_readwrite("cell_size", &NavMeshSettings::cellSize)
@@ -64,6 +79,7 @@ void initShortestPathBindings(py::module& m) {
       .def_readwrite("detail_sample_dist", &NavMeshSettings::detailSampleDist)
       .def_readwrite("detail_sample_max_error",
                      &NavMeshSettings::detailSampleMaxError)
+      .def_readwrite("tile_size", &NavMeshSettings::tileSize)
       .def_readwrite("filter_low_hanging_obstacles",
                      &NavMeshSettings::filterLowHangingObstacles)
       .def_readwrite("filter_ledge_spans", &NavMeshSettings::filterLedgeSpans)
@@ -80,11 +96,53 @@ void initShortestPathBindings(py::module& m) {
            "meters_per_pixel"_a, "height"_a)
       .def("get_random_navigable_point", &PathFinder::getRandomNavigablePoint,
            "max_tries"_a = 10)
+      .def("get_random_navigable_points",
+           &PathFinder::getRandomNavigablePoints,
+           R"(Returns num_points random navigable points, distributed uniformly
+          over the navmesh area.)",
+           "num_points"_a)
       .def("find_path", py::overload_cast<ShortestPath&>(&PathFinder::findPath),
            "path"_a)
       .def("find_path",
            py::overload_cast<MultiGoalShortestPath&>(&PathFinder::findPath),
            "path"_a)
+      .def("find_path", py::overload_cast<PathCorridor&>(&PathFinder::findPath),
+           R"(Finds the shortest path, moving the corridor found by the previous
+          call along with small changes of requested_start and requested_end
+          instead of searching again.)",
+           "path"_a)
+      .def(
+          "find_paths",
+          [](PathFinder& self, const std::vector<ShortestPath::ptr>& paths) {
+            std::vector<ShortestPath> batch;
+            batch.reserve(paths.size());
+            for (const auto& path : paths) {
+              batch.emplace_back(*path);
+            }
+            std::vector<bool> found = self.findPaths(batch);
+            for (size_t i = 0; i < paths.size(); ++i) {
+              paths[i]->geodesicDistance = batch[i].geodesicDistance;
+              paths[i]->points = std::move(batch[i].points);
+            }
+            return found;
+          },
+          R"(Finds the shortest path for each ShortestPath in paths using a pool
+          of worker threads. Returns whether or not a path exists for each one.)",
+          "paths"_a)
+      .def("add_distance_oracle_goal", &PathFinder::addDistanceOracleGoal,
+           R"(Precomputes the geodesic distance field to goal. Returns the id of
+          the goal, or -1 if it is not navigable.)",
+           "goal"_a)
+      .def_property_readonly("num_distance_oracle_goals",
+                             &PathFinder::getNumDistanceOracleGoals)
+      .def("clear_distance_oracle", &PathFinder::clearDistanceOracle)
+      .def("get_oracle_geodesic_distance",
+           &PathFinder::getOracleGeodesicDistance,
+           R"(Returns the precomputed geodesic distance from start to the goal
+          with id goal_id.)",
+           "start"_a, "goal_id"_a)
+      .def("save_distance_oracle", &PathFinder::saveDistanceOracle, "path"_a)
+      .def("load_distance_oracle", &PathFinder::loadDistanceOracle, "path"_a)
       .def("try_step", &PathFinder::tryStep<Magnum::Vector3>, "start"_a,
            "end"_a)
       .def("try_step", &PathFinder::tryStep<vec3f>, "start"_a, "end"_a)
@@ -103,6 +161,11 @@ void initShortestPathBindings(py::module& m) {
            [](PathFinder& self) { return self.getNavMeshData()->ibo; })
       .def("load_nav_mesh", &PathFinder::loadNavMesh)
       .def("save_nav_mesh", &PathFinder::saveNavMesh, "path"_a)
+      .def("load_nav_mesh_cache", &PathFinder::loadNavMeshCache,
+           R"(Loads a navmesh cache saved by save_nav_mesh_cache. The tiles are
+          memory mapped and shared between processes loading the same file.)",
+           "path"_a)
+      .def("save_nav_mesh_cache", &PathFinder::saveNavMeshCache, "path"_a)
       .def("distance_to_closest_obstacle",
            &PathFinder::distanceToClosestObstacle,
            R"(Returns the distance to the closest obstacle.)", "pt"_a,
@@ -114,7 +177,23 @@ void initShortestPathBindings(py::module& m) {
            "pt"_a, "max_search_radius"_a = 2.0)
       .def("is_navigable", &PathFinder::isNavigable,
            R"(Checks to see if the agent can stand at the specified point.)",
-           "pt"_a, "max_y_delta"_a = 0.5);
+           "pt"_a, "max_y_delta"_a = 0.5)
+      .def("query_points", &PathFinder::queryPoints,
+           R"(Snaps each row of the Nx3 array points to the navmesh, checks
+          whether it is navigable and finds its distance to the closest
+          obstacle, projecting every point only once.)",
+           "points"_a, "max_y_delta"_a = 0.5, "max_search_radius"_a = 2.0)
+      .def("snap_points", &PathFinder::snapPoints,
+           R"(Batched version of snap_point for an Nx3 array of points.)",
+           "points"_a)
+      .def("are_navigable", &PathFinder::areNavigable,
+           R"(Batched version of is_navigable for an Nx3 array of points.)",
+           "points"_a, "max_y_delta"_a = 0.5)
+      .def("distances_to_closest_obstacle",
+           &PathFinder::distancesToClosestObstacle,
+           R"(Batched version of distance_to_closest_obstacle for an Nx3 array
+          of points.)",
+           "points"_a, "max_search_radius"_a = 2.0);
 
   // this enum is used by GreedyGeodesicFollowerImpl so it needs to be defined
   // before it
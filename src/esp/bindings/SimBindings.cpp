@@ -69,6 +69,10 @@ void initSimBindings(py::module& m) {
           stage with a semantic mesh. Set to false otherwise.)")
       .def_readwrite("requires_textures",
                      &SimulatorConfiguration::requiresTextures)
+      .def_readwrite(
+          "generate_mesh_lods", &SimulatorConfiguration::generateMeshLODs,
+          R"(Simplify loaded meshes into coarser levels of detail, drawn by
+          camera sensors where the simplification is not visible.)")
       .def(py::self == py::self)
       .def(py::self != py::self);
 
@@ -110,6 +114,11 @@ void initSimBindings(py::module& m) {
       .def_property("frustum_culling", &Simulator::isFrustumCullingEnabled,
                     &Simulator::setFrustumCullingEnabled,
                     R"(Enable or disable the frustum culling)")
+      .def_property(
+          "fused_sensor_rendering", &Simulator::isFusedSensorRenderingEnabled,
+          &Simulator::setFusedSensorRenderingEnabled,
+          R"(Enable or disable drawing co-located camera sensors of an agent
+          once and reading all their observations from that single frame)")
       .def_property(
           "active_dataset", &Simulator::getActiveSceneDatasetName,
           &Simulator::setActiveSceneDatasetName,
@@ -278,10 +287,22 @@ void initSimBindings(py::module& m) {
           "contact_test", &Simulator::contactTest, "object_id"_a,
           "scene_id"_a = 0,
           R"(Run collision detection and return a binary indicator of penetration between the specified object and any other collision object. Physics must be enabled.)")
+      .def(
+          "contact_test_batch", &Simulator::contactTestBatch, "object_ids"_a,
+          "scene_id"_a = 0,
+          R"(Run collision detection once and return, for each of the specified objects, a binary indicator of penetration between the object and any other collision object. Faster than calling contact_test for each object. Physics must be enabled.)")
+      .def(
+          "get_contact_pairs", &Simulator::getContactPairs, "scene_id"_a = 0,
+          R"(Run collision detection and return all the pairs of objects in contact, with their number of contact points. Stage contacts have the object id -1. Physics must be enabled.)")
       .def(
           "cast_ray", &Simulator::castRay, "ray"_a, "max_distance"_a = 100.0,
           "scene_id"_a = 0,
           R"(Cast a ray into the collidable scene and return hit results. Physics must be enabled. max_distance in units of ray length.)")
+      .def(
+          "cast_rays", &Simulator::castRays, "rays"_a,
+          "max_distance"_a = 100.0, "closest_hit_only"_a = false,
+          "scene_id"_a = 0,
+          R"(Cast a batch of rays into the collidable scene in parallel and return the hits of all of them in flat arrays. Faster than calling cast_ray for each ray. Physics must be enabled. max_distance in units of ray length.)")
       .def("set_object_bb_draw", &Simulator::setObjectBBDraw, "draw_bb"_a,
            "object_id"_a, "scene_id"_a = 0,
            R"(Enable or disable bounding box visualization for an object.)")
@@ -293,6 +314,10 @@ void initSimBindings(py::module& m) {
           "recompute_navmesh", &Simulator::recomputeNavMesh, "pathfinder"_a,
           "navmesh_settings"_a, "include_static_objects"_a = false,
           R"(Recompute the NavMesh for a given PathFinder instance using configured NavMeshSettings. Optionally include all MotionType::STATIC objects in the navigability constraints.)")
+      .def(
+          "update_navmesh_tiles", &Simulator::updateNavMeshTiles,
+          "pathfinder"_a,
+          R"(Rebuild only the tiles of a tiled NavMesh (NavMeshSettings.tile_size > 0) overlapped by MotionType::STATIC objects that were added, removed or moved since the NavMesh was last computed with include_static_objects=True.)")
       .def("add_trajectory_object", &Simulator::addTrajectoryObject,
            "traj_vis_name"_a, "points"_a, "num_segments"_a = 3,
            "radius"_a = .001, "color"_a = Mn::Color4{0.9, 0.1, 0.1, 1.0},
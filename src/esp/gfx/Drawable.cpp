@@ -5,6 +5,8 @@
 #include "Drawable.h"
 #include <Corrade/Utility/Assert.h>
 #include "DrawableGroup.h"
+#include "MeshLOD.h"
+#include "RenderCamera.h"
 #include "esp/scene/SceneNode.h"
 
 namespace esp {
@@ -29,6 +31,30 @@ Drawable::~Drawable() {
   }
 }
 
+void Drawable::drawInstances(Instances instances,
+                             Magnum::SceneGraph::Camera3D& camera) {
+  for (const auto& instance : instances) {
+    static_cast<Drawable&>(instance.first.get()).draw(instance.second, camera);
+  }
+}
+
+Magnum::GL::Mesh& Drawable::selectMesh(
+    const Magnum::Matrix4& transformationMatrix,
+    Magnum::SceneGraph::Camera3D& camera) {
+  auto& renderCamera = static_cast<RenderCamera&>(camera);
+  Magnum::GL::Mesh* mesh = &mesh_;
+  int level = -1;
+  if (meshLODs_ && renderCamera.useMeshLODs()) {
+    level = selectMeshLOD(*meshLODs_, transformationMatrix,
+                          camera.projectionMatrix(), camera.viewport());
+    if (level >= 0) {
+      mesh = &meshLODs_->levels[level].mesh;
+    }
+  }
+  renderCamera.countDraw(*mesh, 1, level >= 0);
+  return *mesh;
+}
+
 DrawableGroup* Drawable::drawables() {
   auto* group = Magnum::SceneGraph::Drawable3D::drawables();
   if (!group) {
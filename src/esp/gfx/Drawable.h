@@ -5,7 +5,10 @@
 #ifndef ESP_GFX_DRAWABLE_H_
 #define ESP_GFX_DRAWABLE_H_
 
+#include <Corrade/Containers/ArrayView.h>
 #include <Corrade/Containers/EnumSet.h>
+#include <functional>
+#include <tuple>
 
 #include "esp/core/esp.h"
 #include "magnum.h"
@@ -17,6 +20,7 @@ class SceneNode;
 namespace gfx {
 
 class DrawableGroup;
+struct MeshLODs;
 
 /**
  * @brief Drawable for use with @ref DrawableGroup.
@@ -87,6 +91,63 @@ class Drawable : public Magnum::SceneGraph::Drawable3D {
    */
   virtual Magnum::GL::Mesh& getVisualizerMesh() { return mesh_; }
 
+  /**
+   * @brief The GL state bound to draw this drawable, in the order it is
+   * sorted by: drawables sharing a shader, then a material, then a mesh are
+   * drawn one after another so that the state is bound once for all of them
+   */
+  struct StateKey {
+    const void* shader = nullptr;
+    const void* material = nullptr;
+    const void* mesh = nullptr;
+
+    bool operator<(const StateKey& other) const {
+      return std::tie(shader, material, mesh) <
+             std::tie(other.shader, other.material, other.mesh);
+    }
+    bool operator==(const StateKey& other) const {
+      return shader == other.shader && material == other.material &&
+             mesh == other.mesh;
+    }
+  };
+
+  /**
+   * @brief Get the state key of this drawable, see @ref StateKey
+   *
+   * By default, only the mesh is known. Sub-classes should override this
+   * function to report the shader and material they bind.
+   */
+  virtual StateKey getStateKey() { return {nullptr, nullptr, &mesh_}; }
+
+  /**
+   * @brief Drawables sharing a @ref StateKey, paired with their
+   * transformations relative to camera
+   */
+  typedef Corrade::Containers::ArrayView<
+      const std::pair<std::reference_wrapper<Magnum::SceneGraph::Drawable3D>,
+                      Magnum::Matrix4>>
+      Instances;
+
+  /**
+   * @brief Whether this drawable can currently be drawn together with other
+   * drawables of the same @ref StateKey in one instanced draw call, see
+   * @ref drawInstances()
+   */
+  virtual bool isInstanceable() { return false; }
+
+  /**
+   * @brief Set the coarser levels of detail of the mesh, drawn instead of it
+   * when its projected size is small enough, see @ref selectMesh()
+   * @param lods, the levels of detail, which must outlive the drawable, or
+   * nullptr to always draw the full-detail mesh
+   */
+  void setMeshLODs(MeshLODs* lods) { meshLODs_ = lods; }
+
+  /**
+   * @brief Get the levels of detail of the mesh, nullptr if it has none
+   */
+  MeshLODs* getMeshLODs() const { return meshLODs_; }
+
  protected:
   /**
    * @brief Draw the object using given camera
@@ -100,11 +161,37 @@ class Drawable : public Magnum::SceneGraph::Drawable3D {
   virtual void draw(const Magnum::Matrix4& transformationMatrix,
                     Magnum::SceneGraph::Camera3D& camera) = 0;
 
+  /**
+   * @brief Draw @p instances, this drawable and the following ones sharing
+   * its @ref StateKey, using given camera
+   *
+   * Sub-classes returning true from @ref isInstanceable() should override
+   * this function to draw all of them in a single instanced draw call. The
+   * default implementation draws them one by one.
+   */
+  virtual void drawInstances(Instances instances,
+                             Magnum::SceneGraph::Camera3D& camera);
+
+  /**
+   * @brief Select the mesh to draw from given camera and count it in the
+   * camera's draw statistics
+   *
+   * @return the coarsest level of detail whose error projects to at most a
+   * pixel if the camera's render pass uses levels of detail and the drawable
+   * has them, @ref mesh_ otherwise
+   */
+  Magnum::GL::Mesh& selectMesh(const Magnum::Matrix4& transformationMatrix,
+                               Magnum::SceneGraph::Camera3D& camera);
+
+  // draws the (sorted, possibly instanced) draw lists
+  friend class RenderCamera;
+
   static uint64_t drawableIdCounter;
   uint64_t drawableId_;
 
   scene::SceneNode& node_;
   Magnum::GL::Mesh& mesh_;
+  MeshLODs* meshLODs_ = nullptr;
 };
 
 CORRADE_ENUMSET_OPERATORS(Drawable::Flags)
@@ -0,0 +1,135 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "DrawableBVH.h"
+
+#include <algorithm>
+
+#include <Magnum/Math/Functions.h>
+
+namespace Mn = Magnum;
+
+namespace esp {
+namespace gfx {
+
+namespace {
+
+// maximum number of drawables stored in a leaf
+constexpr uint32_t MaxLeafSize = 4;
+
+enum class Containment { Outside, Intersecting, Inside };
+
+/**
+ * @brief classify an axis-aligned bounding box against a frustum, using the
+ * same plane test as the per-drawable culling in RenderCamera
+ */
+Containment rangeFrustumContainment(const Mn::Range3D& range,
+                                    const Mn::Frustum& frustum) {
+  const Mn::Vector3 center = range.min() + range.max();
+  const Mn::Vector3 extent = range.max() - range.min();
+
+  bool inside = true;
+  for (int iPlane = 0; iPlane < 6; ++iPlane) {
+    const Mn::Vector4& plane = frustum[iPlane];
+    const float d = Mn::Math::dot(center, plane.xyz());
+    const float r = Mn::Math::dot(extent, Mn::Math::abs(plane.xyz()));
+    if (d + r < -2.0f * plane.w())
+      return Containment::Outside;
+    if (d - r < -2.0f * plane.w())
+      inside = false;
+  }
+  return inside ? Containment::Inside : Containment::Intersecting;
+}
+
+}  // namespace
+
+DrawableBVH::DrawableBVH(std::vector<Item> items) : items_(std::move(items)) {
+  if (items_.empty())
+    return;
+  // a binary tree with at least one item per leaf
+  nodes_.reserve(2 * items_.size() - 1);
+  build(0, items_.size());
+}
+
+uint32_t DrawableBVH::build(uint32_t begin, uint32_t end) {
+  Mn::Range3D bounds = items_[begin].second;
+  Mn::Range3D centroidBounds{items_[begin].second.center(),
+                             items_[begin].second.center()};
+  for (uint32_t i = begin + 1; i < end; ++i) {
+    bounds = Mn::Math::join(bounds, items_[i].second);
+    const Mn::Vector3 center = items_[i].second.center();
+    centroidBounds =
+        Mn::Math::join(centroidBounds, Mn::Range3D{center, center});
+  }
+
+  const uint32_t index = nodes_.size();
+  nodes_.push_back({bounds, begin, end - begin, 0});
+
+  const Mn::Vector3 extent = centroidBounds.size();
+  const int axis = extent.x() > extent.y()
+                       ? (extent.x() > extent.z() ? 0 : 2)
+                       : (extent.y() > extent.z() ? 1 : 2);
+  // stop at small leaves, or when all centroids coincide and no split can
+  // separate the items
+  if (end - begin <= MaxLeafSize || extent[axis] <= 0.0f)
+    return index;
+
+  const uint32_t mid = begin + (end - begin) / 2;
+  std::nth_element(items_.begin() + begin, items_.begin() + mid,
+                   items_.begin() + end, [axis](const Item& a, const Item& b) {
+                     return a.second.center()[axis] < b.second.center()[axis];
+                   });
+
+  build(begin, mid);
+  // nodes_ may have been reallocated, do not hold references across build()
+  const uint32_t secondChild = build(mid, end);
+  nodes_[index].secondChild = secondChild;
+  return index;
+}
+
+size_t DrawableBVH::cull(
+    const Mn::Frustum& frustum,
+    std::vector<std::reference_wrapper<MagnumDrawable>>& visible) const {
+  const size_t numVisibleBefore = visible.size();
+  if (nodes_.empty())
+    return 0;
+
+  std::vector<uint32_t> stack{0};
+  while (!stack.empty()) {
+    const uint32_t index = stack.back();
+    stack.pop_back();
+    const Node& node = nodes_[index];
+
+    const Containment containment =
+        rangeFrustumContainment(node.bounds, frustum);
+    if (containment == Containment::Outside)
+      continue;
+
+    if (containment == Containment::Inside) {
+      // the whole subtree is visible, no need to test any further
+      for (uint32_t i = node.firstItem; i < node.firstItem + node.numItems;
+           ++i) {
+        visible.emplace_back(items_[i].first);
+      }
+    } else if (node.secondChild == 0) {
+      // partially visible leaf, test its drawables one by one
+      for (uint32_t i = node.firstItem; i < node.firstItem + node.numItems;
+           ++i) {
+        if (node.numItems == 1 || rangeFrustumContainment(
+                                      items_[i].second, frustum) !=
+                                      Containment::Outside) {
+          visible.emplace_back(items_[i].first);
+        }
+      }
+    } else {
+      stack.push_back(node.secondChild);
+      stack.push_back(index + 1);
+    }
+  }
+
+  return visible.size() - numVisibleBefore;
+}
+
+}  // namespace gfx
+}  // namespace esp
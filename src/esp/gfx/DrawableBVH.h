@@ -0,0 +1,85 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_GFX_DRAWABLEBVH_H_
+#define ESP_GFX_DRAWABLEBVH_H_
+
+#include <Magnum/Math/Frustum.h>
+#include <Magnum/Math/Range.h>
+#include <functional>
+#include <vector>
+
+#include "esp/core/esp.h"
+#include "esp/gfx/magnum.h"
+
+namespace esp {
+namespace gfx {
+
+/**
+ * @brief Bounding volume hierarchy over the absolute AABBs of static
+ * drawables, used to frustum cull them without visiting (or computing the
+ * transformation of) every single one.
+ *
+ * The hierarchy is built once, top-down, by splitting the drawables at the
+ * median of the longest axis of their centroids. Nodes are stored in a flat
+ * array in depth-first order, the drawables of each leaf contiguously.
+ */
+class DrawableBVH {
+ public:
+  /**
+   * @brief A drawable with the absolute AABB of its mesh
+   */
+  typedef std::pair<std::reference_wrapper<MagnumDrawable>, Magnum::Range3D>
+      Item;
+
+  /**
+   * @brief Constructor, builds the hierarchy
+   * @param items, the static drawables and their absolute AABBs
+   */
+  explicit DrawableBVH(std::vector<Item> items);
+
+  /**
+   * @brief Collect the drawables whose AABBs intersect the frustum
+   * @param frustum, the camera frustum in world space
+   * @param visible, the vector to which the visible drawables are appended
+   * @return the number of drawables appended
+   */
+  size_t cull(
+      const Magnum::Frustum& frustum,
+      std::vector<std::reference_wrapper<MagnumDrawable>>& visible) const;
+
+  /**
+   * @brief Number of drawables in the hierarchy
+   */
+  size_t size() const { return items_.size(); }
+
+  /**
+   * @brief Number of nodes in the hierarchy
+   */
+  size_t numNodes() const { return nodes_.size(); }
+
+ protected:
+  struct Node {
+    Magnum::Range3D bounds;
+    // items of the subtree are items_[firstItem, firstItem + numItems)
+    uint32_t firstItem;
+    uint32_t numItems;
+    // index of the second child, 0 for a leaf (the first child of an inner
+    // node directly follows it)
+    uint32_t secondChild;
+  };
+
+  // builds the subtree over items_[begin, end) and returns its node index
+  uint32_t build(uint32_t begin, uint32_t end);
+
+  std::vector<Item> items_;
+  std::vector<Node> nodes_;
+
+  ESP_SMART_POINTERS(DrawableBVH)
+};
+
+}  // namespace gfx
+}  // namespace esp
+
+#endif  // ESP_GFX_DRAWABLEBVH_H_
@@ -3,6 +3,7 @@
 // LICENSE file in the root directory of this source tree.
 #include "DrawableGroup.h"
 #include "Drawable.h"
+#include "esp/scene/SceneNode.h"
 
 namespace esp {
 namespace gfx {
@@ -37,9 +38,42 @@ Drawable* DrawableGroup::getDrawable(uint64_t id) const {
   return nullptr;
 }
 
+const DrawableBVH& DrawableGroup::getStaticBVH() {
+  if (!staticBVH_) {
+    buildStaticBVH();
+  }
+  return *staticBVH_;
+}
+
+const std::vector<std::reference_wrapper<MagnumDrawable>>&
+DrawableGroup::getDynamicDrawables() {
+  if (!staticBVH_) {
+    buildStaticBVH();
+  }
+  return dynamicDrawables_;
+}
+
+void DrawableGroup::buildStaticBVH() {
+  std::vector<DrawableBVH::Item> staticItems;
+  dynamicDrawables_.clear();
+  for (size_t i = 0; i < size(); ++i) {
+    MagnumDrawable& drawable = (*this)[i];
+    auto& node = static_cast<scene::SceneNode&>(drawable.object());
+    Corrade::Containers::Optional<Magnum::Range3D> aabb =
+        node.getAbsoluteAABB();
+    if (aabb) {
+      staticItems.emplace_back(drawable, *aabb);
+    } else {
+      dynamicDrawables_.emplace_back(drawable);
+    }
+  }
+  staticBVH_ = DrawableBVH::create_unique(std::move(staticItems));
+}
+
 bool DrawableGroup::registerDrawable(Drawable& drawable) {
   // if it is already registered, emplace will do nothing
   if (idToDrawable_.emplace(drawable.getDrawableId(), &drawable).second) {
+    staticBVH_ = nullptr;
     return true;
   }
   return false;
@@ -49,6 +83,7 @@ bool DrawableGroup::unregisterDrawable(Drawable& drawable) {
   if (idToDrawable_.erase(drawable.getDrawableId()) == 0) {
     return false;
   }
+  staticBVH_ = nullptr;
   return true;
 }
 
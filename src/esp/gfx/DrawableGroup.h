@@ -12,6 +12,7 @@
 
 #include <functional>
 #include "esp/core/esp.h"
+#include "esp/gfx/DrawableBVH.h"
 
 namespace esp {
 namespace gfx {
@@ -64,7 +65,27 @@ class DrawableGroup : public Magnum::SceneGraph::DrawableGroup3D {
    */
   virtual bool prepareForDraw(const RenderCamera&) { return true; }
 
+  /**
+   * @brief The bounding volume hierarchy over the drawables of this group
+   * whose nodes have a precomputed absolute AABB (i.e. static meshes)
+   *
+   * It is built on first use after the stage was loaded, and rebuilt only if
+   * drawables were added to or removed from the group since.
+   */
+  const DrawableBVH& getStaticBVH();
+
+  /**
+   * @brief The drawables of this group which are not in @ref getStaticBVH()
+   */
+  const std::vector<std::reference_wrapper<MagnumDrawable>>&
+  getDynamicDrawables();
+
  protected:
+  /**
+   * @brief Split the drawables into the static BVH and the dynamic list
+   */
+  void buildStaticBVH();
+
   /**
    * Why a friend class here?
    * class Drawable has to update idToDrawable_, and it is the ONLY class that
@@ -87,6 +108,14 @@ class DrawableGroup : public Magnum::SceneGraph::DrawableGroup3D {
    * a lookup table, that maps a drawable id to the drawable object
    */
   std::unordered_map<uint64_t, Drawable*> idToDrawable_;
+  /**
+   * the hierarchy over the static drawables, nullptr if it needs a rebuild
+   */
+  DrawableBVH::uptr staticBVH_ = nullptr;
+  /**
+   * the drawables not in staticBVH_
+   */
+  std::vector<std::reference_wrapper<MagnumDrawable>> dynamicDrawables_;
   ESP_SMART_POINTERS(DrawableGroup)
 };
 
@@ -6,6 +6,7 @@
 
 #include <Corrade/Containers/ArrayViewStl.h>
 #include <Corrade/Utility/FormatStl.h>
+#include <Magnum/GL/Buffer.h>
 #include <Magnum/Math/Color.h>
 #include <Magnum/Math/Matrix3.h>
 
@@ -70,26 +71,55 @@ void GenericDrawable::setLightSetup(const Mn::ResourceKey& resourceKey) {
   updateShader();
 }
 
-void GenericDrawable::updateShaderLightingParameters(
+Drawable::StateKey GenericDrawable::getStateKey() {
+  updateShader();
+  return {&*shader_, &*materialData_, &mesh_};
+}
+
+bool GenericDrawable::isInstanceable() {
+  // per-vertex object ids occupy the attribute per-instance ids go to, and
+  // object-relative lights would need per-instance light positions
+  return !materialData_->perVertexObjectId &&
+         !hasObjectRelativeLights(*lightSetup_);
+}
+
+Mn::ResourceKey GenericDrawable::getInstanceBufferKey(
+    const Mn::GL::Mesh& mesh) {
+  return Corrade::Utility::formatString(
+      "instances-{}", reinterpret_cast<std::uintptr_t>(&mesh));
+}
+
+void GenericDrawable::updateShaderParameters(
+    Mn::Shaders::Phong& shader,
+    RenderCamera::StateChanges changes,
     const Mn::Matrix4& transformationMatrix,
     Mn::SceneGraph::Camera3D& camera) {
-  const Mn::Matrix4 cameraMatrix = camera.cameraMatrix();
+  if (changes & RenderCamera::StateChange::Shader) {
+    shader.setProjectionMatrix(camera.projectionMatrix());
+  }
+  if (changes & RenderCamera::StateChange::Lights) {
+    updateShaderLightParameters(shader);
+  }
+  if ((changes & RenderCamera::StateChange::Lights) ||
+      hasObjectRelativeLights(*lightSetup_)) {
+    updateShaderLightDirectionParameters(shader, transformationMatrix, camera);
+  }
+  // the ambient color depends on both the material and the lights
+  if (changes & (RenderCamera::StateChange::Material |
+                 RenderCamera::StateChange::Lights)) {
+    updateShaderMaterialParameters(shader);
+  }
+}
 
-  std::vector<Mn::Vector4> lightPositions;
-  lightPositions.reserve(lightSetup_->size());
+void GenericDrawable::updateShaderLightParameters(Mn::Shaders::Phong& shader) {
   std::vector<Mn::Color3> lightColors;
   lightColors.reserve(lightSetup_->size());
   std::vector<Mn::Color3> lightSpecularColors;
   lightSpecularColors.reserve(lightSetup_->size());
   constexpr float dummyRange = Mn::Constants::inf();
   std::vector<float> lightRanges(lightSetup_->size(), dummyRange);
-  const Mn::Color4 ambientLightColor = getAmbientLightColor(*lightSetup_);
 
   for (Mn::UnsignedInt i = 0; i < lightSetup_->size(); ++i) {
-    const auto& lightInfo = (*lightSetup_)[i];
-    lightPositions.emplace_back(Mn::Vector4(getLightPositionRelativeToCamera(
-        lightInfo, transformationMatrix, cameraMatrix)));
-
     const auto& lightColor = (*lightSetup_)[i].color;
     lightColors.emplace_back(lightColor);
 
@@ -101,21 +131,64 @@ void GenericDrawable::updateShaderLightingParameters(
   }
 
   // See documentation in src/deps/magnum/src/Magnum/Shaders/Phong.h
-  (*shader_)
-      .setAmbientColor(materialData_->ambientColor * ambientLightColor)
+  shader.setLightColors(lightColors).setLightRanges(lightRanges);
+}
+
+void GenericDrawable::updateShaderLightDirectionParameters(
+    Mn::Shaders::Phong& shader,
+    const Mn::Matrix4& transformationMatrix,
+    Mn::SceneGraph::Camera3D& camera) {
+  const Mn::Matrix4 cameraMatrix = camera.cameraMatrix();
+
+  std::vector<Mn::Vector4> lightPositions;
+  lightPositions.reserve(lightSetup_->size());
+  for (Mn::UnsignedInt i = 0; i < lightSetup_->size(); ++i) {
+    const auto& lightInfo = (*lightSetup_)[i];
+    lightPositions.emplace_back(Mn::Vector4(getLightPositionRelativeToCamera(
+        lightInfo, transformationMatrix, cameraMatrix)));
+  }
+
+  shader.setLightPositions(lightPositions);
+}
+
+void GenericDrawable::updateShaderMaterialParameters(
+    Mn::Shaders::Phong& shader) {
+  const Mn::Color4 ambientLightColor = getAmbientLightColor(*lightSetup_);
+
+  shader.setAmbientColor(materialData_->ambientColor * ambientLightColor)
       .setDiffuseColor(materialData_->diffuseColor)
       .setSpecularColor(materialData_->specularColor)
-      .setShininess(materialData_->shininess)
-      .setLightPositions(lightPositions)
-      .setLightColors(lightColors)
-      .setLightRanges(lightRanges);
+      .setShininess(materialData_->shininess);
+
+  if ((flags_ & Mn::Shaders::Phong::Flag::TextureTransformation) &&
+      materialData_->textureMatrix != Mn::Matrix3{}) {
+    shader.setTextureMatrix(materialData_->textureMatrix);
+  }
+
+  if (flags_ & Mn::Shaders::Phong::Flag::AmbientTexture) {
+    shader.bindAmbientTexture(*(materialData_->ambientTexture));
+  }
+  if (flags_ & Mn::Shaders::Phong::Flag::DiffuseTexture) {
+    shader.bindDiffuseTexture(*(materialData_->diffuseTexture));
+  }
+  if (flags_ & Mn::Shaders::Phong::Flag::SpecularTexture) {
+    shader.bindSpecularTexture(*(materialData_->specularTexture));
+  }
+  if (flags_ & Mn::Shaders::Phong::Flag::NormalTexture) {
+    shader.bindNormalTexture(*(materialData_->normalTexture));
+  }
 }
 
 void GenericDrawable::draw(const Mn::Matrix4& transformationMatrix,
                            Mn::SceneGraph::Camera3D& camera) {
   updateShader();
 
-  updateShaderLightingParameters(transformationMatrix, camera);
+  // only bind what the previous drawable of the render pass did not leave
+  // bound already
+  const RenderCamera::StateChanges changes =
+      static_cast<RenderCamera&>(camera).bindDrawState(
+          &*shader_, &*materialData_, &*lightSetup_);
+  updateShaderParameters(*shader_, changes, transformationMatrix, camera);
 
   (*shader_)
       // e.g., semantic mesh has its own per vertex annotation, which has been
@@ -126,50 +199,120 @@ void GenericDrawable::draw(const Mn::Matrix4& transformationMatrix,
               ? drawableId_
               : (materialData_->perVertexObjectId ? 0 : node_.getSemanticId()))
       .setTransformationMatrix(transformationMatrix)
-      .setProjectionMatrix(camera.projectionMatrix())
       .setNormalMatrix(transformationMatrix.normalMatrix());
 
-  if ((flags_ & Mn::Shaders::Phong::Flag::TextureTransformation) &&
-      materialData_->textureMatrix != Mn::Matrix3{}) {
-    shader_->setTextureMatrix(materialData_->textureMatrix);
-  }
+  shader_->draw(selectMesh(transformationMatrix, camera));
+}
 
-  if (flags_ & Mn::Shaders::Phong::Flag::AmbientTexture) {
-    shader_->bindAmbientTexture(*(materialData_->ambientTexture));
+namespace {
+// layout of the per-instance attributes of the instanced Phong shader
+struct InstanceData {
+  Mn::Matrix4 transformationMatrix;
+  Mn::Matrix3x3 normalMatrix;
+  Mn::UnsignedInt objectId;
+};
+}  // namespace
+
+void GenericDrawable::drawInstances(Instances instances,
+                                    Mn::SceneGraph::Camera3D& camera) {
+  // instances lit by different light setups cannot share the light uniforms,
+  // split them into runs lit alike
+  auto litAlike = [](const std::pair<std::reference_wrapper<MagnumDrawable>,
+                                     Mn::Matrix4>& instance,
+                     const GenericDrawable& drawable) {
+    return &*static_cast<GenericDrawable&>(instance.first.get()).lightSetup_ ==
+           &*drawable.lightSetup_;
+  };
+  size_t end = 1;
+  while (end < instances.size() && litAlike(instances[end], *this)) {
+    ++end;
   }
-  if (flags_ & Mn::Shaders::Phong::Flag::DiffuseTexture) {
-    shader_->bindDiffuseTexture(*(materialData_->diffuseTexture));
+  if (end < instances.size()) {
+    for (size_t begin = 0; begin < instances.size(); begin = end) {
+      auto& first = static_cast<GenericDrawable&>(instances[begin].first.get());
+      end = begin + 1;
+      while (end < instances.size() && litAlike(instances[end], first)) {
+        ++end;
+      }
+      first.drawInstances(instances.slice(begin, end), camera);
+    }
+    return;
   }
-  if (flags_ & Mn::Shaders::Phong::Flag::SpecularTexture) {
-    shader_->bindSpecularTexture(*(materialData_->specularTexture));
+
+  auto& renderCamera = static_cast<RenderCamera&>(camera);
+  updateShader(instancedShader_,
+               flags_ | Mn::Shaders::Phong::Flag::InstancedTransformation |
+                   Mn::Shaders::Phong::Flag::InstancedObjectId);
+
+  const RenderCamera::StateChanges changes = renderCamera.bindDrawState(
+      &*instancedShader_, &*materialData_, &*lightSetup_);
+  // no light is object-relative, so no light depends on the transformation
+  updateShaderParameters(*instancedShader_, changes, Mn::Matrix4{}, camera);
+
+  // the buffer is shared by all drawables of the mesh and attached to it the
+  // first time the mesh is drawn instanced
+  Mn::Resource<Mn::GL::Buffer> instanceBuffer =
+      shaderManager_.get<Mn::GL::Buffer>(getInstanceBufferKey(mesh_));
+  if (!instanceBuffer) {
+    shaderManager_.set<Mn::GL::Buffer>(
+        instanceBuffer.key(), new Mn::GL::Buffer{},
+        Mn::ResourceDataState::Mutable, Mn::ResourcePolicy::Manual);
+    mesh_.addVertexBufferInstanced(*instanceBuffer, 1, 0,
+                                   Mn::Shaders::Phong::TransformationMatrix{},
+                                   Mn::Shaders::Phong::NormalMatrix{},
+                                   Mn::Shaders::Phong::ObjectId{});
   }
-  if (flags_ & Mn::Shaders::Phong::Flag::NormalTexture) {
-    shader_->bindNormalTexture(*(materialData_->normalTexture));
+
+  // the ids of the instances go through the per-instance object id, which
+  // the shader adds to the uniform one
+  std::vector<InstanceData> instanceData;
+  instanceData.reserve(instances.size());
+  for (const auto& instance : instances) {
+    auto& drawable = static_cast<GenericDrawable&>(instance.first.get());
+    instanceData.push_back(
+        {instance.second, instance.second.normalMatrix(),
+         static_cast<Mn::UnsignedInt>(renderCamera.useDrawableIds()
+                                          ? drawable.drawableId_
+                                          : drawable.node_.getSemanticId())});
   }
+  instanceBuffer->setData(instanceData, Mn::GL::BufferUsage::StreamDraw);
+
+  (*instancedShader_)
+      .setObjectId(0)
+      .setTransformationMatrix(Mn::Matrix4{})
+      .setNormalMatrix(Mn::Matrix3x3{});
 
-  shader_->draw(mesh_);
+  mesh_.setInstanceCount(instanceData.size());
+  renderCamera.countDraw(mesh_, instanceData.size());
+  instancedShader_->draw(mesh_);
+  mesh_.setInstanceCount(1);
 }
 
 void GenericDrawable::updateShader() {
+  updateShader(shader_, flags_);
+}
+
+void GenericDrawable::updateShader(PhongResource& shader,
+                                   Mn::Shaders::Phong::Flags flags) {
   Mn::UnsignedInt lightCount = lightSetup_->size();
 
-  if (!shader_ || shader_->lightCount() != lightCount ||
-      shader_->flags() != flags_) {
+  if (!shader || shader->lightCount() != lightCount ||
+      shader->flags() != flags) {
     // if the number of lights or flags have changed, we need to fetch a
     // compatible shader
-    shader_ =
+    shader =
         shaderManager_.get<Mn::GL::AbstractShaderProgram, Mn::Shaders::Phong>(
-            getShaderKey(lightCount, flags_));
+            getShaderKey(lightCount, flags));
 
     // if no shader with desired number of lights and flags exists, create one
-    if (!shader_) {
+    if (!shader) {
       shaderManager_.set<Mn::GL::AbstractShaderProgram>(
-          shader_.key(), new Mn::Shaders::Phong{flags_, lightCount},
+          shader.key(), new Mn::Shaders::Phong{flags, lightCount},
           Mn::ResourceDataState::Final, Mn::ResourcePolicy::ReferenceCounted);
     }
 
-    CORRADE_INTERNAL_ASSERT(shader_ && shader_->lightCount() == lightCount &&
-                            shader_->flags() == flags_);
+    CORRADE_INTERNAL_ASSERT(shader && shader->lightCount() == lightCount &&
+                            shader->flags() == flags);
   }
 }
 
@@ -8,6 +8,7 @@
 #include <Magnum/Shaders/Phong.h>
 
 #include "esp/gfx/Drawable.h"
+#include "esp/gfx/RenderCamera.h"
 #include "esp/gfx/ShaderManager.h"
 
 namespace esp {
@@ -27,24 +28,51 @@ class GenericDrawable : public Drawable {
                            DrawableGroup* group = nullptr);
 
   void setLightSetup(const Magnum::ResourceKey& lightSetupKey) override;
+  StateKey getStateKey() override;
+  //! Instanceable unless the mesh has per-vertex object ids or lights move
+  //! with the object
+  bool isInstanceable() override;
   static constexpr const char* SHADER_KEY_TEMPLATE = "Phong-lights={}-flags={}";
 
+  //! Key of the per-instance buffer attached to @p mesh in the ShaderManager
+  static Magnum::ResourceKey getInstanceBufferKey(const Magnum::GL::Mesh& mesh);
+
  protected:
+  typedef Magnum::Resource<Magnum::GL::AbstractShaderProgram,
+                           Magnum::Shaders::Phong>
+      PhongResource;
+
   virtual void draw(const Magnum::Matrix4& transformationMatrix,
                     Magnum::SceneGraph::Camera3D& camera) override;
+  void drawInstances(Instances instances,
+                     Magnum::SceneGraph::Camera3D& camera) override;
 
   void updateShader();
-  void updateShaderLightingParameters(
+  //! fetch (or create) a shader with the current light count and @p flags
+  void updateShader(PhongResource& shader, Magnum::Shaders::Phong::Flags flags);
+  //! upload what @p changes since the previous drawable of the render pass
+  void updateShaderParameters(Magnum::Shaders::Phong& shader,
+                              RenderCamera::StateChanges changes,
+                              const Magnum::Matrix4& transformationMatrix,
+                              Magnum::SceneGraph::Camera3D& camera);
+  //! upload the color and range of every light
+  void updateShaderLightParameters(Magnum::Shaders::Phong& shader);
+  //! upload the light positions relative to the camera
+  void updateShaderLightDirectionParameters(
+      Magnum::Shaders::Phong& shader,
       const Magnum::Matrix4& transformationMatrix,
       Magnum::SceneGraph::Camera3D& camera);
+  //! upload the material colors and bind the material textures
+  void updateShaderMaterialParameters(Magnum::Shaders::Phong& shader);
 
   Magnum::ResourceKey getShaderKey(Magnum::UnsignedInt lightCount,
                                    Magnum::Shaders::Phong::Flags flags) const;
 
   // shader parameters
   ShaderManager& shaderManager_;
-  Magnum::Resource<Magnum::GL::AbstractShaderProgram, Magnum::Shaders::Phong>
-      shader_;
+  PhongResource shader_;
+  //! the shader drawing all instances of a run at once
+  PhongResource instancedShader_;
   Magnum::Resource<MaterialData, PhongMaterialData> materialData_;
   Magnum::Resource<LightSetup> lightSetup_;
 
@@ -0,0 +1,47 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "LightBuffer.h"
+
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Magnum/Math/Constants.h>
+
+namespace Mn = Magnum;
+
+namespace esp {
+namespace gfx {
+
+void LightBuffer::bind(const LightSetup& lightSetup,
+                       const Mn::Matrix4& cameraMatrix) {
+  CORRADE_ASSERT(!hasObjectRelativeLights(lightSetup),
+                 "LightBuffer::bind(): object-relative lights cannot be "
+                 "shared by drawables", );
+
+  const size_t lightCount = lightSetup.size();
+  if (!valid_ || lightSetup_ != &lightSetup ||
+      data_.size() != 2 * lightCount || cameraMatrix_ != cameraMatrix) {
+    data_.resize(2 * lightCount);
+    for (size_t iLight = 0; iLight < lightCount; ++iLight) {
+      const LightInfo& light = lightSetup[iLight];
+      // the transformation matrix is unused for non-object-relative lights
+      data_[iLight] =
+          getLightPositionRelativeToCamera(light, Mn::Matrix4{}, cameraMatrix);
+      // range is not a part of LightInfo yet, lights reach infinitely
+      data_[lightCount + iLight] = {light.color, Mn::Constants::inf()};
+    }
+    // replace the whole data store instead of updating it, to not stall on
+    // draws of the previous camera still using it
+    buffer_.setData(data_, Mn::GL::BufferUsage::DynamicDraw);
+
+    lightSetup_ = &lightSetup;
+    cameraMatrix_ = cameraMatrix;
+    valid_ = true;
+    ++numUploads_;
+  }
+
+  buffer_.bind(Mn::GL::Buffer::Target::Uniform, Binding);
+}
+
+}  // namespace gfx
+}  // namespace esp
@@ -0,0 +1,73 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_GFX_LIGHTBUFFER_H_
+#define ESP_GFX_LIGHTBUFFER_H_
+
+#include <Magnum/GL/Buffer.h>
+#include <Magnum/Math/Matrix4.h>
+#include <vector>
+
+#include "esp/core/esp.h"
+#include "esp/gfx/LightSetup.h"
+
+namespace esp {
+namespace gfx {
+
+/**
+ * @brief Uniform buffer holding the lights of a @ref LightSetup in camera
+ * space, shared by all the drawables lit by that setup.
+ *
+ * It is stored in the @ref ShaderManager under the same key as its
+ * @ref LightSetup. The camera-space light vectors are computed and uploaded
+ * only when the camera (or the light setup) changes, so once per camera and
+ * frame; drawables then merely bind the buffer.
+ *
+ * Lights positioned relative to the object they light differ for every
+ * drawable and cannot be shared, see @ref hasObjectRelativeLights().
+ */
+class LightBuffer {
+ public:
+  enum : Magnum::UnsignedInt {
+    /** @brief Uniform buffer binding point of the light block in shaders */
+    Binding = 0
+  };
+
+  /**
+   * @brief Update the buffer with the lights of @p lightSetup seen from a
+   * camera, unless it holds them already, and bind it to @ref Binding
+   * @param lightSetup, the light setup, must not have object-relative lights
+   * @param cameraMatrix, the camera matrix of the camera rendering the frame
+   */
+  void bind(const LightSetup& lightSetup, const Magnum::Matrix4& cameraMatrix);
+
+  /**
+   * @brief Force the next @ref bind() to upload the lights, to be called when
+   * the light setup stored under the same key is replaced
+   */
+  void invalidate() { valid_ = false; }
+
+  /**
+   * @brief Number of times the lights were uploaded
+   */
+  size_t numUploads() const { return numUploads_; }
+
+ protected:
+  Magnum::GL::Buffer buffer_{Magnum::GL::Buffer::TargetHint::Uniform};
+  // std140 layout of the light block: the camera-space vectors of all
+  // lights, followed by their colors (with intensity) and ranges in .w
+  std::vector<Magnum::Vector4> data_;
+  // what the buffer was last uploaded for
+  const LightSetup* lightSetup_ = nullptr;
+  Magnum::Matrix4 cameraMatrix_;
+  bool valid_ = false;
+  size_t numUploads_ = 0;
+
+  ESP_SMART_POINTERS(LightBuffer)
+};
+
+}  // namespace gfx
+}  // namespace esp
+
+#endif  // ESP_GFX_LIGHTBUFFER_H_
@@ -38,6 +38,15 @@ Magnum::Vector4 getLightPositionRelativeToCamera(
   CORRADE_INTERNAL_ASSERT_UNREACHABLE();
 }
 
+bool hasObjectRelativeLights(const LightSetup& lightSetup) {
+  for (const LightInfo& light : lightSetup) {
+    if (light.model == LightPositionModel::OBJECT) {
+      return true;
+    }
+  }
+  return false;
+}
+
 LightSetup getLightsAtBoxCorners(const Magnum::Range3D& box,
                                  const Magnum::Color3& lightColor) {
   // NOLINTNEXTLINE(google-build-using-namespace)
@@ -63,6 +63,13 @@ Magnum::Vector4 getLightPositionRelativeToCamera(
     const Magnum::Matrix4& transformationMatrix,
     const Magnum::Matrix4& cameraMatrix);
 
+/**
+ * @brief Whether any light of @p lightSetup is positioned relative to the
+ * object it lights, in which case its camera-space position has to be
+ * updated for every drawable
+ */
+bool hasObjectRelativeLights(const LightSetup& lightSetup);
+
 /**
  * @brief Get a @ref LightSetup with lights at the corners of a box
  */
@@ -0,0 +1,268 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "MeshLOD.h"
+
+#include <Corrade/Containers/ArrayViewStl.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/MeshTools/Duplicate.h>
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+
+namespace Cr = Corrade;
+namespace Mn = Magnum;
+
+namespace esp {
+namespace gfx {
+
+namespace {
+
+// number of levels generated at most
+constexpr std::size_t MaxLevels = 4;
+// meshes with fewer triangles are not worth simplifying
+constexpr Mn::UnsignedInt MinTriangles = 256;
+// number of cells of the finest grid along the diagonal of the bounding box
+constexpr float FinestGridResolution = 256.0f;
+// grid coordinates are packed into 21 bits each
+constexpr Mn::Int MaxCellCoordinate = (1 << 21) - 1;
+
+Mn::Range3D computeBounds(
+    Cr::Containers::ArrayView<const Mn::Vector3> positions) {
+  if (positions.empty())
+    return {};
+  Mn::Range3D bounds{positions[0], positions[0]};
+  for (const Mn::Vector3& position : positions) {
+    bounds.min() = Mn::Math::min(bounds.min(), position);
+    bounds.max() = Mn::Math::max(bounds.max(), position);
+  }
+  return bounds;
+}
+
+/**
+ * @brief Copy the vertices referenced by @p indices, with all their
+ * attributes, into a mesh of their own indexed by @p indices renumbered
+ */
+Mn::Trade::MeshData compactMesh(
+    const Mn::Trade::MeshData& meshData,
+    Cr::Containers::ArrayView<const Mn::UnsignedInt> indices) {
+  // number the used vertices in the order they are first referenced
+  std::vector<Mn::UnsignedInt> remap(meshData.vertexCount(),
+                                     ~Mn::UnsignedInt{});
+  std::vector<Mn::UnsignedInt> usedVertices;
+  Cr::Containers::Array<char> indexData{
+      Cr::Containers::NoInit, indices.size() * sizeof(Mn::UnsignedInt)};
+  Cr::Containers::ArrayView<Mn::UnsignedInt> compactIndices =
+      Cr::Containers::arrayCast<Mn::UnsignedInt>(indexData);
+  for (std::size_t i = 0; i < indices.size(); ++i) {
+    Mn::UnsignedInt& id = remap[indices[i]];
+    if (id == ~Mn::UnsignedInt{}) {
+      id = usedVertices.size();
+      usedVertices.push_back(indices[i]);
+    }
+    compactIndices[i] = id;
+  }
+
+  // gather the used vertices through a view indexing the original vertex
+  // data with them
+  const Mn::Trade::MeshData gatherView{
+      Mn::MeshPrimitive::Triangles,
+      {},
+      Cr::Containers::arrayView(usedVertices),
+      Mn::Trade::MeshIndexData{Cr::Containers::arrayView(usedVertices)},
+      {},
+      meshData.vertexData(),
+      Mn::Trade::meshAttributeDataNonOwningArray(meshData.attributeData()),
+      meshData.vertexCount()};
+  Mn::Trade::MeshData gathered = Mn::MeshTools::duplicate(gatherView);
+
+  // the index view has to be constructed before the index data is moved
+  const Mn::Trade::MeshIndexData indexView{compactIndices};
+  const Mn::UnsignedInt vertexCount = usedVertices.size();
+  Cr::Containers::Array<char> vertexData = gathered.releaseVertexData();
+  Cr::Containers::Array<Mn::Trade::MeshAttributeData> gatheredAttributes =
+      gathered.releaseAttributeData();
+  return Mn::Trade::MeshData{Mn::MeshPrimitive::Triangles,
+                             std::move(indexData),
+                             indexView,
+                             std::move(vertexData),
+                             std::move(gatheredAttributes),
+                             vertexCount};
+}
+
+}  // namespace
+
+Cr::Containers::Array<Mn::UnsignedInt> simplifyMesh(
+    Cr::Containers::ArrayView<const Mn::Vector3> positions,
+    Cr::Containers::ArrayView<const Mn::UnsignedInt> indices,
+    float cellSize,
+    float& error) {
+  error = 0.0f;
+  if (positions.empty() || cellSize <= 0.0f) {
+    Cr::Containers::Array<Mn::UnsignedInt> copy{Cr::Containers::NoInit,
+                                                indices.size()};
+    std::copy(indices.begin(), indices.end(), copy.begin());
+    return copy;
+  }
+
+  // assign every vertex to its grid cell and accumulate the cell means
+  const Mn::Vector3 origin = computeBounds(positions).min();
+  std::unordered_map<std::uint64_t, Mn::UnsignedInt> cellIds;
+  std::vector<Mn::UnsignedInt> vertexCells(positions.size());
+  std::vector<Mn::Vector3> cellSums;
+  std::vector<Mn::UnsignedInt> cellCounts;
+  for (std::size_t i = 0; i < positions.size(); ++i) {
+    const Mn::Vector3i cell = Mn::Math::min(
+        Mn::Vector3i{(positions[i] - origin) / cellSize},
+        Mn::Vector3i{MaxCellCoordinate});
+    const std::uint64_t key = (std::uint64_t(cell.x()) << 42) |
+                              (std::uint64_t(cell.y()) << 21) |
+                              std::uint64_t(cell.z());
+    auto inserted = cellIds.emplace(key, cellSums.size());
+    if (inserted.second) {
+      cellSums.emplace_back(0.0f);
+      cellCounts.emplace_back(0);
+    }
+    const Mn::UnsignedInt cellId = inserted.first->second;
+    vertexCells[i] = cellId;
+    cellSums[cellId] += positions[i];
+    ++cellCounts[cellId];
+  }
+
+  // the representative of a cell is its vertex closest to the cell mean
+  std::vector<Mn::UnsignedInt> representatives(cellSums.size());
+  std::vector<float> representativeDistances(cellSums.size(),
+                                             Mn::Constants::inf());
+  for (std::size_t i = 0; i < positions.size(); ++i) {
+    const Mn::UnsignedInt cellId = vertexCells[i];
+    const float distance =
+        (positions[i] - cellSums[cellId] / cellCounts[cellId]).dot();
+    if (distance < representativeDistances[cellId]) {
+      representativeDistances[cellId] = distance;
+      representatives[cellId] = i;
+    }
+  }
+  for (std::size_t i = 0; i < positions.size(); ++i) {
+    error = Mn::Math::max(
+        error,
+        (positions[i] - positions[representatives[vertexCells[i]]]).length());
+  }
+
+  // collapse the triangles, rotated so that the smallest index comes first
+  // (which keeps the winding) to find duplicates by sorting
+  std::vector<std::array<Mn::UnsignedInt, 3>> triangles;
+  triangles.reserve(indices.size() / 3);
+  for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+    const Mn::UnsignedInt a = representatives[vertexCells[indices[i]]];
+    const Mn::UnsignedInt b = representatives[vertexCells[indices[i + 1]]];
+    const Mn::UnsignedInt c = representatives[vertexCells[indices[i + 2]]];
+    if (a == b || b == c || a == c)
+      continue;
+    if (b < a && b < c) {
+      triangles.push_back({{b, c, a}});
+    } else if (c < a && c < b) {
+      triangles.push_back({{c, a, b}});
+    } else {
+      triangles.push_back({{a, b, c}});
+    }
+  }
+  std::sort(triangles.begin(), triangles.end());
+  triangles.erase(std::unique(triangles.begin(), triangles.end()),
+                  triangles.end());
+
+  Cr::Containers::Array<Mn::UnsignedInt> simplified{Cr::Containers::NoInit,
+                                                    triangles.size() * 3};
+  for (std::size_t i = 0; i < triangles.size(); ++i) {
+    std::copy(triangles[i].begin(), triangles[i].end(),
+              simplified.begin() + 3 * i);
+  }
+  return simplified;
+}
+
+std::vector<MeshLODData> simplifyMeshLODs(
+    const Mn::Trade::MeshData& meshData) {
+  std::vector<MeshLODData> levels;
+  if (meshData.primitive() != Mn::MeshPrimitive::Triangles ||
+      !meshData.isIndexed() ||
+      !meshData.hasAttribute(Mn::Trade::MeshAttribute::Position)) {
+    return levels;
+  }
+
+  const Cr::Containers::Array<Mn::Vector3> positions =
+      meshData.positions3DAsArray();
+  const Cr::Containers::Array<Mn::UnsignedInt> indices =
+      meshData.indicesAsArray();
+  const float diagonal = computeBounds(positions).size().length();
+
+  // double the cell size until a level has at most half the triangles of
+  // the previous one, which is about a quarter for a surface
+  Mn::UnsignedInt previousTriangles = indices.size() / 3;
+  for (float cellSize = diagonal / FinestGridResolution;
+       levels.size() < MaxLevels && previousTriangles >= MinTriangles &&
+       cellSize < diagonal;
+       cellSize *= 2.0f) {
+    float error;
+    const Cr::Containers::Array<Mn::UnsignedInt> lodIndices =
+        simplifyMesh(positions, indices, cellSize, error);
+    const Mn::UnsignedInt numTriangles = lodIndices.size() / 3;
+    if (numTriangles == 0)
+      break;
+    if (2 * numTriangles > previousTriangles)
+      continue;
+
+    levels.push_back(MeshLODData{compactMesh(meshData, lodIndices), error});
+    previousTriangles = numTriangles;
+  }
+  return levels;
+}
+
+MeshLODs generateMeshLODs(const Mn::Trade::MeshData& meshData,
+                          Mn::MeshTools::CompileFlags compileFlags) {
+  MeshLODs lods;
+  if (meshData.hasAttribute(Mn::Trade::MeshAttribute::Position)) {
+    lods.bounds = computeBounds(meshData.positions3DAsArray());
+  }
+  lods.numTriangles =
+      (meshData.isIndexed() ? meshData.indexCount() : meshData.vertexCount()) /
+      3;
+
+  for (const MeshLODData& level : simplifyMeshLODs(meshData)) {
+    lods.levels.push_back(
+        MeshLOD{Mn::MeshTools::compile(level.meshData, compileFlags),
+                level.error, level.meshData.indexCount() / 3});
+  }
+  return lods;
+}
+
+int selectMeshLOD(const MeshLODs& lods,
+                  const Mn::Matrix4& transformationMatrix,
+                  const Mn::Matrix4& projectionMatrix,
+                  const Mn::Vector2i& viewport,
+                  float maxPixelError) {
+  if (lods.levels.empty())
+    return -1;
+
+  const float scale = transformationMatrix.scaling().max();
+  const Mn::Vector3 center =
+      transformationMatrix.transformPoint(lods.bounds.center());
+  const float radius = 0.5f * lods.bounds.size().length() * scale;
+
+  // clip-space w of the point of the bounding sphere closest to the camera:
+  // its distance for a perspective projection, 1 for an orthographic one
+  const float w = projectionMatrix[2][3] * (center.z() + radius) +
+                  projectionMatrix[3][3];
+  // the camera is inside the bounding sphere
+  if (w <= 0.0f)
+    return -1;
+
+  const float pixelsPerUnit = 0.5f * projectionMatrix[1][1] * viewport.y() / w;
+  for (int i = lods.levels.size() - 1; i >= 0; --i) {
+    if (lods.levels[i].error * scale * pixelsPerUnit <= maxPixelError)
+      return i;
+  }
+  return -1;
+}
+
+}  // namespace gfx
+}  // namespace esp
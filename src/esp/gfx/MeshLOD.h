@@ -0,0 +1,130 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_GFX_MESHLOD_H_
+#define ESP_GFX_MESHLOD_H_
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/Containers/ArrayView.h>
+#include <Magnum/GL/Mesh.h>
+#include <Magnum/Math/Matrix4.h>
+#include <Magnum/Math/Range.h>
+#include <Magnum/MeshTools/Compile.h>
+#include <Magnum/Trade/MeshData.h>
+#include <vector>
+
+#include "esp/core/esp.h"
+
+namespace esp {
+namespace gfx {
+
+/**
+ * @brief A mesh simplified to a coarser level of detail
+ */
+struct MeshLOD {
+  /** @brief The compiled mesh */
+  Magnum::GL::Mesh mesh;
+  /**
+   * @brief Largest distance a vertex was moved by the simplification, in
+   * mesh units
+   */
+  float error = 0.0f;
+  /** @brief Number of triangles of the mesh */
+  Magnum::UnsignedInt numTriangles = 0;
+};
+
+/**
+ * @brief The coarser levels of detail of a mesh, see @ref generateMeshLODs()
+ * and @ref selectMeshLOD()
+ */
+struct MeshLODs {
+  /** @brief Levels of detail, from the finest to the coarsest */
+  std::vector<MeshLOD> levels;
+  /** @brief Bounding box of the full-detail mesh, in mesh units */
+  Magnum::Range3D bounds;
+  /** @brief Number of triangles of the full-detail mesh */
+  Magnum::UnsignedInt numTriangles = 0;
+};
+
+/**
+ * @brief Simplify a triangle mesh by clustering its vertices on a regular
+ * grid
+ *
+ * All vertices falling into the same grid cell are collapsed onto the one
+ * closest to their mean, triangles that degenerate are dropped and so are
+ * duplicates of a triangle. The simplified triangles index the original
+ * vertices, so all of their attributes are kept.
+ *
+ * @param positions, the vertex positions
+ * @param indices, the triangle indices
+ * @param cellSize, the size of a grid cell, in mesh units
+ * @param[out] error, the largest distance a vertex was moved by
+ * @return the indices of the simplified triangles
+ */
+Corrade::Containers::Array<Magnum::UnsignedInt> simplifyMesh(
+    Corrade::Containers::ArrayView<const Magnum::Vector3> positions,
+    Corrade::Containers::ArrayView<const Magnum::UnsignedInt> indices,
+    float cellSize,
+    float& error);
+
+/**
+ * @brief A level of detail of a mesh before it is compiled, see
+ * @ref simplifyMeshLODs()
+ */
+struct MeshLODData {
+  /** @brief Indexed triangles referencing only the vertices they use */
+  Magnum::Trade::MeshData meshData;
+  /** @brief See @ref MeshLOD::error */
+  float error;
+};
+
+/**
+ * @brief Simplify an indexed triangle mesh into levels of detail with about
+ * a quarter of the triangles of the previous one each
+ *
+ * Meshes too small to benefit from simplification get no levels.
+ *
+ * @param meshData, the indexed triangle mesh
+ * @return the levels of detail, from the finest to the coarsest
+ */
+std::vector<MeshLODData> simplifyMeshLODs(
+    const Magnum::Trade::MeshData& meshData);
+
+/**
+ * @brief Simplify a mesh and compile its levels of detail, see
+ * @ref simplifyMeshLODs()
+ * @param meshData, the indexed triangle mesh
+ * @param compileFlags, the flags the full-detail mesh is compiled with
+ * @return the compiled levels of detail, with no level if the mesh is too
+ * small to be simplified
+ */
+MeshLODs generateMeshLODs(const Magnum::Trade::MeshData& meshData,
+                          Magnum::MeshTools::CompileFlags compileFlags = {});
+
+/**
+ * @brief Select the coarsest level of detail whose simplification error
+ * projects to at most @p maxPixelError pixels on the viewport
+ *
+ * The error is projected at the point of the bounding sphere of the mesh
+ * closest to the camera.
+ *
+ * @param lods, the levels of detail of the mesh
+ * @param transformationMatrix, the transformation of the mesh relative to the
+ * camera
+ * @param projectionMatrix, the projection matrix of the camera
+ * @param viewport, the viewport size, in pixels
+ * @param maxPixelError, the largest error to tolerate, in pixels
+ * @return the index of the selected level in @ref MeshLODs::levels, or -1
+ * to draw the full-detail mesh
+ */
+int selectMeshLOD(const MeshLODs& lods,
+                  const Magnum::Matrix4& transformationMatrix,
+                  const Magnum::Matrix4& projectionMatrix,
+                  const Magnum::Vector2i& viewport,
+                  float maxPixelError = 1.0f);
+
+}  // namespace gfx
+}  // namespace esp
+
+#endif  // ESP_GFX_MESHLOD_H_
@@ -4,6 +4,7 @@
 
 #include "MeshVisualizerDrawable.h"
 #include "Magnum/GL/Renderer.h"
+#include "esp/gfx/RenderCamera.h"
 #include "esp/scene/SceneNode.h"
 
 namespace Mn = Magnum;
@@ -20,6 +21,8 @@ MeshVisualizerDrawable::MeshVisualizerDrawable(
 
 void MeshVisualizerDrawable::draw(const Magnum::Matrix4& transformationMatrix,
                                   Magnum::SceneGraph::Camera3D& camera) {
+  static_cast<RenderCamera&>(camera).bindDrawState(&shader_, nullptr, nullptr);
+
   Mn::GL::Renderer::enable(Mn::GL::Renderer::Feature::PolygonOffsetFill);
   Mn::GL::Renderer::setPolygonOffset(-5.0f, -5.0f);
 
@@ -28,6 +28,8 @@ class MeshVisualizerDrawable : public Drawable {
                                   Magnum::GL::Mesh& mesh,
                                   gfx::DrawableGroup* group);
 
+  StateKey getStateKey() override { return {&shader_, nullptr, &mesh_}; }
+
  protected:
   /**
    * @brief Draw the object using given camera
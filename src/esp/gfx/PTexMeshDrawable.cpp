@@ -43,6 +43,8 @@ PTexMeshDrawable::PTexMeshDrawable(scene::SceneNode& node,
 
 void PTexMeshDrawable::draw(const Magnum::Matrix4& transformationMatrix,
                             Magnum::SceneGraph::Camera3D& camera) {
+  // binds its atlas unconditionally, without a material to share
+  static_cast<RenderCamera&>(camera).bindDrawState(shader_, nullptr, nullptr);
   (*shader_)
       .setExposure(exposure_)
       .setGamma(gamma_)
@@ -28,6 +28,7 @@ class PTexMeshDrawable : public Drawable {
   virtual Magnum::GL::Mesh& getVisualizerMesh() override {
     return visualizerTriangleMesh_;
   }
+  StateKey getStateKey() override { return {shader_, nullptr, &mesh_}; }
 
  protected:
   virtual void draw(const Magnum::Matrix4& transformationMatrix,
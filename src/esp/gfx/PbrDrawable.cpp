@@ -23,6 +23,7 @@ PbrDrawable::PbrDrawable(scene::SceneNode& node,
     : Drawable{node, mesh, group},
       shaderManager_{shaderManager},
       lightSetup_{shaderManager.get<LightSetup>(lightSetupKey)},
+      lightBuffer_{shaderManager.get<LightBuffer>(lightSetupKey)},
       materialData_{
           shaderManager.get<MaterialData, PbrMaterialData>(materialDataKey)} {
   if (materialData_->metallicTexture && materialData_->roughnessTexture) {
@@ -76,13 +77,47 @@ PbrDrawable::PbrDrawable(scene::SceneNode& node,
 
 void PbrDrawable::setLightSetup(const Mn::ResourceKey& lightSetupKey) {
   lightSetup_ = shaderManager_.get<LightSetup>(lightSetupKey);
+  lightBuffer_ = shaderManager_.get<LightBuffer>(lightSetupKey);
+}
+
+Drawable::StateKey PbrDrawable::getStateKey() {
+  updateShader();
+  return {&*shader_, &*materialData_, &mesh_};
 }
 
 void PbrDrawable::draw(const Mn::Matrix4& transformationMatrix,
                        Mn::SceneGraph::Camera3D& camera) {
-  updateShader()
-      .updateShaderLightParameters()
-      .updateShaderLightDirectionParameters(transformationMatrix, camera);
+  updateShader();
+
+  // only bind what the previous drawable of the render pass did not leave
+  // bound already
+  const RenderCamera::StateChanges changes =
+      static_cast<RenderCamera&>(camera).bindDrawState(
+          &*shader_, &*materialData_, &*lightSetup_);
+
+  if (changes & RenderCamera::StateChange::Shader) {
+    shader_->setProjectionMatrix(camera.projectionMatrix());
+  }
+  if (shader_->flags() & PbrShader::Flag::LightBuffer) {
+    // the camera-space lights are shared with all drawables of the setup and
+    // uploaded at most once per camera
+    if (changes & RenderCamera::StateChange::Lights) {
+      if (!lightBuffer_) {
+        shaderManager_.set(lightBuffer_.key(), new LightBuffer{},
+                           Mn::ResourceDataState::Mutable,
+                           Mn::ResourcePolicy::ReferenceCounted);
+      }
+      lightBuffer_->bind(*lightSetup_, camera.cameraMatrix());
+    }
+  } else {
+    if (changes & RenderCamera::StateChange::Lights) {
+      updateShaderLightParameters();
+    }
+    if ((changes & RenderCamera::StateChange::Lights) ||
+        hasObjectRelativeLights(*lightSetup_)) {
+      updateShaderLightDirectionParameters(transformationMatrix, camera);
+    }
+  }
 
   // Assume that in a model, double-sided meshes are significantly less than
   // single-sided meshes.
@@ -105,8 +140,17 @@ void PbrDrawable::draw(const Mn::Matrix4& transformationMatrix,
               ? drawableId_
               : (materialData_->perVertexObjectId ? 0 : node_.getSemanticId()))
       .setTransformationMatrix(transformationMatrix)  // modelview matrix
-      .setProjectionMatrix(camera.projectionMatrix())
-      .setNormalMatrix(transformationMatrix.normalMatrix())
+      .setNormalMatrix(transformationMatrix.normalMatrix());
+
+  if (changes & RenderCamera::StateChange::Material) {
+    updateShaderMaterialParameters();
+  }
+
+  shader_->draw(selectMesh(transformationMatrix, camera));
+}
+
+PbrDrawable& PbrDrawable::updateShaderMaterialParameters() {
+  (*shader_)
       .setBaseColor(materialData_->baseColor)
       .setRoughness(materialData_->roughness)
       .setMetallic(materialData_->metallic)
@@ -125,8 +169,10 @@ void PbrDrawable::draw(const Mn::Matrix4& transformationMatrix,
       metallicRoughnessTexture = materialData_->metallicTexture;
     }
     CORRADE_ASSERT(metallicRoughnessTexture,
-                   "PbrDrawable::draw(): texture pointer cannot be nullptr if "
-                   "RoughnessTexture or MetallicTexture is enabled.", );
+                   "PbrDrawable::updateShaderMaterialParameters(): texture "
+                   "pointer cannot be nullptr if RoughnessTexture or "
+                   "MetallicTexture is enabled.",
+                   *this);
     shader_->bindMetallicRoughnessTexture(*metallicRoughnessTexture);
   }
 
@@ -145,7 +191,7 @@ void PbrDrawable::draw(const Mn::Matrix4& transformationMatrix,
     shader_->setTextureMatrix(materialData_->textureMatrix);
   }
 
-  shader_->draw(mesh_);
+  return *this;
 }
 
 Mn::ResourceKey PbrDrawable::getShaderKey(Mn::UnsignedInt lightCount,
@@ -157,22 +203,28 @@ Mn::ResourceKey PbrDrawable::getShaderKey(Mn::UnsignedInt lightCount,
 
 PbrDrawable& PbrDrawable::updateShader() {
   unsigned int lightCount = lightSetup_->size();
+  PbrShader::Flags flags = flags_;
+  // object-relative lights are different for each drawable and cannot be
+  // shared in a buffer
+  if (lightCount && !hasObjectRelativeLights(*lightSetup_)) {
+    flags |= PbrShader::Flag::LightBuffer;
+  }
   if (!shader_ || shader_->lightCount() != lightCount ||
-      shader_->flags() != flags_) {
+      shader_->flags() != flags) {
     // if the number of lights or flags have changed, we need to fetch a
     // compatible shader
     shader_ = shaderManager_.get<Mn::GL::AbstractShaderProgram, PbrShader>(
-        getShaderKey(lightCount, flags_));
+        getShaderKey(lightCount, flags));
 
     // if no shader with desired number of lights and flags exists, create one
     if (!shader_) {
       shaderManager_.set<Mn::GL::AbstractShaderProgram>(
-          shader_.key(), new PbrShader{flags_, lightCount},
+          shader_.key(), new PbrShader{flags, lightCount},
           Mn::ResourceDataState::Final, Mn::ResourcePolicy::ReferenceCounted);
     }
 
     CORRADE_INTERNAL_ASSERT(shader_ && shader_->lightCount() == lightCount &&
-                            shader_->flags() == flags_);
+                            shader_->flags() == flags);
   }
 
   return *this;
@@ -34,6 +34,11 @@ class PbrDrawable : public Drawable {
    */
   void setLightSetup(const Magnum::ResourceKey& lightSetupkey) override;
 
+  /**
+   * @brief Get the state key, the shader and the material of this drawable
+   */
+  StateKey getStateKey() override;
+
   static constexpr const char* SHADER_KEY_TEMPLATE = "PBR-lights={}-flags={}";
 
  protected:
@@ -55,7 +60,8 @@ class PbrDrawable : public Drawable {
   PbrDrawable& updateShader();
 
   /**
-   *  @brief Update every light's color, intensity, range etc.
+   *  @brief Update every light's color, intensity, range etc. Only used when
+   *  the lights cannot be read from the shared @ref LightBuffer.
    *  @return Reference to self (for method chaining)
    */
   PbrDrawable& updateShaderLightParameters();
@@ -72,6 +78,12 @@ class PbrDrawable : public Drawable {
       const Magnum::Matrix4& transformationMatrix,
       Magnum::SceneGraph::Camera3D& camera);
 
+  /**
+   *  @brief Update the material uniforms and bind the material textures
+   *  @return Reference to self (for method chaining)
+   */
+  PbrDrawable& updateShaderMaterialParameters();
+
   /**
    * @brief get the key for the shader
    * @param lightCount, the number of the lights;
@@ -86,6 +98,8 @@ class PbrDrawable : public Drawable {
   Magnum::Resource<Magnum::GL::AbstractShaderProgram, PbrShader> shader_;
   Magnum::Resource<MaterialData, PbrMaterialData> materialData_;
   Magnum::Resource<LightSetup> lightSetup_;
+  // shared by the drawables lit by the same light setup, created on first use
+  Magnum::Resource<LightBuffer> lightBuffer_;
 };
 
 }  // namespace gfx
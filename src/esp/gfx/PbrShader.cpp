@@ -23,6 +23,7 @@
 #include <Magnum/PixelFormat.h>
 
 #include "esp/core/esp.h"
+#include "esp/gfx/LightBuffer.h"
 #include "esp/io/io.h"
 
 #include <sstream>
@@ -125,6 +126,7 @@ PbrShader::PbrShader(Flags originalFlags, unsigned int lightCount)
                      : "")
       .addSource(flags_ & Flag::ObjectId ? "#define OBJECT_ID\n" : "")
       .addSource(flags_ & Flag::DoubleSided ? "#define DOUBLE_SIDED\n" : "")
+      .addSource(flags_ & Flag::LightBuffer ? "#define LIGHT_BUFFER\n" : "")
       .addSource(flags_ & Flag::PrecomputedTangent
                      ? "#define PRECOMPUTED_TANGENT\n"
                      : "")
@@ -199,7 +201,10 @@ PbrShader::PbrShader(Flags originalFlags, unsigned int lightCount)
   emissiveColorUniform_ = uniformLocation("Material.emissiveColor");
 
   // lights
-  if (lightCount_) {
+  if (lightCount_ && (flags_ & Flag::LightBuffer)) {
+    setUniformBlockBinding(uniformBlockIndex("LightBuffer"),
+                           LightBuffer::Binding);
+  } else if (lightCount_) {
     lightRangesUniform_ = uniformLocation("LightRanges");
     lightColorsUniform_ = uniformLocation("LightColors");
     lightDirectionsUniform_ = uniformLocation("LightDirections");
@@ -221,7 +226,8 @@ PbrShader::PbrShader(Flags originalFlags, unsigned int lightCount)
       setNormalTextureScale(1.0f);
     }
     setNormalMatrix(Mn::Matrix3x3{Mn::Math::IdentityInit});
-
+  }
+  if (lightCount_ && !(flags_ & Flag::LightBuffer)) {
     setLightVectors(Cr::Containers::Array<Mn::Vector4>{
         Cr::Containers::DirectInit, lightCount_,
         // a single directional "fill" light, coming from the center of the
@@ -344,6 +350,10 @@ PbrShader& PbrShader::setTextureMatrix(const Mn::Matrix3& matrix) {
 
 PbrShader& PbrShader::setLightVectors(
     Cr::Containers::ArrayView<const Mn::Vector4> vectors) {
+  // the lights are read from the uniform buffer instead
+  if (flags_ & Flag::LightBuffer) {
+    return *this;
+  }
   CORRADE_ASSERT(lightCount_ == vectors.size(),
                  "PbrShader::setLightVectors(): expected"
                      << lightCount_ << "items but got" << vectors.size(),
@@ -359,6 +369,9 @@ PbrShader& PbrShader::setLightVectors(
 
 PbrShader& PbrShader::setLightPosition(unsigned int lightIndex,
                                        const Mn::Vector3& pos) {
+  if (flags_ & Flag::LightBuffer) {
+    return *this;
+  }
   CORRADE_ASSERT(
       lightIndex < lightCount_,
       "PbrShader::setLightPosition: lightIndex" << lightIndex << "is illegal.",
@@ -370,6 +383,9 @@ PbrShader& PbrShader::setLightPosition(unsigned int lightIndex,
 
 PbrShader& PbrShader::setLightDirection(unsigned int lightIndex,
                                         const Mn::Vector3& dir) {
+  if (flags_ & Flag::LightBuffer) {
+    return *this;
+  }
   CORRADE_ASSERT(
       lightIndex < lightCount_,
       "PbrShader::setLightDirection: lightIndex" << lightIndex << "is illegal.",
@@ -380,6 +396,9 @@ PbrShader& PbrShader::setLightDirection(unsigned int lightIndex,
 
 PbrShader& PbrShader::setLightVector(unsigned int lightIndex,
                                      const Mn::Vector4& vec) {
+  if (flags_ & Flag::LightBuffer) {
+    return *this;
+  }
   CORRADE_ASSERT(
       lightIndex < lightCount_,
       "PbrShader::setLightVector: lightIndex" << lightIndex << "is illegal.",
@@ -398,6 +417,9 @@ PbrShader& PbrShader::setLightVector(unsigned int lightIndex,
 }
 
 PbrShader& PbrShader::setLightRange(unsigned int lightIndex, float range) {
+  if (flags_ & Flag::LightBuffer) {
+    return *this;
+  }
   CORRADE_ASSERT(
       lightIndex < lightCount_,
       "PbrShader::setLightRange: lightIndex" << lightIndex << "is illegal.",
@@ -408,6 +430,9 @@ PbrShader& PbrShader::setLightRange(unsigned int lightIndex, float range) {
 PbrShader& PbrShader::setLightColor(unsigned int lightIndex,
                                     const Mn::Vector3& color,
                                     float intensity) {
+  if (flags_ & Flag::LightBuffer) {
+    return *this;
+  }
   CORRADE_ASSERT(
       lightIndex < lightCount_,
       "PbrShader::setLightColor: lightIndex" << lightIndex << "is illegal.",
@@ -419,6 +444,9 @@ PbrShader& PbrShader::setLightColor(unsigned int lightIndex,
 
 PbrShader& PbrShader::setLightColors(
     Cr::Containers::ArrayView<const Mn::Color3> colors) {
+  if (flags_ & Flag::LightBuffer) {
+    return *this;
+  }
   CORRADE_ASSERT(lightCount_ == colors.size(),
                  "PbrShader::setLightColors(): expected"
                      << lightCount_ << "items but got" << colors.size(),
@@ -445,6 +473,9 @@ PbrShader& PbrShader::setNormalTextureScale(float scale) {
 
 PbrShader& PbrShader::setLightRanges(
     Corrade::Containers::ArrayView<const float> ranges) {
+  if (flags_ & Flag::LightBuffer) {
+    return *this;
+  }
   CORRADE_ASSERT(lightCount_ == ranges.size(),
                  "PbrShader::setLightRanges(): expected"
                      << lightCount_ << "items but got" << ranges.size(),
@@ -175,6 +175,14 @@ class PbrShader : public Magnum::GL::AbstractShaderProgram {
      */
     DoubleSided = 1 << 12,
 
+    /**
+     * Read the lights from a uniform buffer bound to
+     * @ref LightBuffer::Binding instead of from uniforms; the light setters
+     * such as @ref setLightVectors() are then ignored.
+     * @see @ref LightBuffer
+     */
+    LightBuffer = 1 << 13,
+
     /*
      * TODO: alphaMask
      */
@@ -4,7 +4,10 @@
 
 #include "RenderCamera.h"
 
+#include <algorithm>
+
 #include <Magnum/EigenIntegration/Integration.h>
+#include <Magnum/GL/Mesh.h>
 #include <Magnum/Math/Frustum.h>
 #include <Magnum/Math/Intersection.h>
 #include <Magnum/Math/Range.h>
@@ -107,6 +110,33 @@ RenderCamera& RenderCamera::setOrthoProjectionMatrix(int width,
   return setProjectionMatrix(width, height, orthoMat);
 }
 
+namespace {
+
+/**
+ * @brief frustum cull the world AABB of a node with temporal coherence
+ * @param node, the scene node holding the mesh
+ * @param frustum, the frustum
+ * @return true if the node has a world AABB outside of the frustum
+ */
+bool cullNode(scene::SceneNode& node, const Mn::Frustum& frustum) {
+  // obtain the world aabb, precomputed for static meshes and lazily updated
+  // for dynamic ones
+  Corrade::Containers::Optional<Mn::Range3D> aabb = node.getWorldAABB();
+  if (aabb) {
+    Cr::Containers::Optional<int> culledPlane =
+        rangeFrustum(*aabb, frustum, node.getFrustumPlaneIndex());
+    if (culledPlane) {
+      node.setFrustumPlaneIndex(*culledPlane);
+    }
+    // if it has value, it means the aabb is culled
+    return (culledPlane != Cr::Containers::NullOpt);
+  }
+  // keep the drawable if its node does not have a mesh bounding box
+  return false;
+}
+
+}  // namespace
+
 size_t RenderCamera::cull(
     std::vector<std::pair<std::reference_wrapper<Mn::SceneGraph::Drawable3D>,
                           Mn::Matrix4>>& drawableTransforms) {
@@ -118,23 +148,8 @@ size_t RenderCamera::cull(
       drawableTransforms.begin(), drawableTransforms.end(),
       [&](const std::pair<std::reference_wrapper<Mn::SceneGraph::Drawable3D>,
                           Mn::Matrix4>& a) {
-        // obtain the absolute aabb
-        auto& node = static_cast<scene::SceneNode&>(a.first.get().object());
-        Corrade::Containers::Optional<Mn::Range3D> aabb =
-            node.getAbsoluteAABB();
-        if (aabb) {
-          // if it has an absolute aabb, it is a static mesh
-          Cr::Containers::Optional<int> culledPlane =
-              rangeFrustum(*aabb, frustum, node.getFrustumPlaneIndex());
-          if (culledPlane) {
-            node.setFrustumPlaneIndex(*culledPlane);
-          }
-          // if it has value, it means the aabb is culled
-          return (culledPlane != Cr::Containers::NullOpt);
-        } else {
-          // keep the drawable if its node does not have an absolute AABB
-          return false;
-        }
+        return cullNode(
+            static_cast<scene::SceneNode&>(a.first.get().object()), frustum);
       });
 
   return (newEndIter - drawableTransforms.begin());
@@ -159,18 +174,77 @@ size_t RenderCamera::removeNonObjects(
 
 uint32_t RenderCamera::draw(MagnumDrawableGroup& drawables, Flags flags) {
   previousNumVisibleDrawables_ = drawables.size();
-  if (flags == Flags()) {  // empty set
-    MagnumCamera::draw(drawables);
-    return drawables.size();
+
+  if (flags & Flag::FrustumCulling) {
+    auto* group = dynamic_cast<DrawableGroup*>(&drawables);
+    if (group) {
+      return drawCulled(*group, flags);
+    }
+  }
+
+  DrawableTransforms drawableTransforms = drawableTransformations(drawables);
+  return drawFiltered(drawableTransforms, flags);
+}
+
+uint32_t RenderCamera::drawCulled(DrawableGroup& drawables, Flags flags) {
+  // camera frustum relative to world origin
+  const Mn::Frustum frustum =
+      Mn::Frustum::fromMatrix(projectionMatrix() * cameraMatrix());
+
+  // static drawables are culled hierarchically, dynamic ones one by one
+  std::vector<std::reference_wrapper<MagnumDrawable>> visible;
+  drawables.getStaticBVH().cull(frustum, visible);
+  for (MagnumDrawable& drawable : drawables.getDynamicDrawables()) {
+    if (!cullNode(static_cast<scene::SceneNode&>(drawable.object()),
+                  frustum)) {
+      visible.emplace_back(drawable);
+    }
+  }
+
+  // compute the transformations of the survivors only, in a single traversal
+  DrawableTransforms drawableTransforms;
+  if (!visible.empty()) {
+    std::vector<std::reference_wrapper<Mn::SceneGraph::AbstractObject3D>>
+        objects;
+    objects.reserve(visible.size());
+    for (MagnumDrawable& drawable : visible) {
+      objects.emplace_back(drawable.object());
+    }
+    std::vector<Mn::Matrix4> transformations =
+        object().scene()->transformationMatrices(objects, cameraMatrix());
+
+    drawableTransforms.reserve(visible.size());
+    for (size_t i = 0; i < visible.size(); ++i) {
+      drawableTransforms.emplace_back(visible[i], transformations[i]);
+    }
+  }
+
+  const uint32_t numDrawn =
+      drawFiltered(drawableTransforms, flags & ~Flags{Flag::FrustumCulling});
+  previousNumVisibleDrawables_ = numDrawn;
+  return numDrawn;
+}
+
+uint32_t RenderCamera::draw(const DrawableTransforms& absoluteTransforms,
+                            Flags flags) {
+  previousNumVisibleDrawables_ = absoluteTransforms.size();
+
+  const Mn::Matrix4 camMatrix = cameraMatrix();
+  DrawableTransforms drawableTransforms;
+  drawableTransforms.reserve(absoluteTransforms.size());
+  for (const auto& a : absoluteTransforms) {
+    drawableTransforms.emplace_back(a.first, camMatrix * a.second);
   }
 
+  return drawFiltered(drawableTransforms, flags);
+}
+
+uint32_t RenderCamera::drawFiltered(DrawableTransforms& drawableTransforms,
+                                    Flags flags) {
   if (flags & Flag::UseDrawableIdAsObjectId) {
     useDrawableIds_ = true;
   }
-
-  std::vector<std::pair<std::reference_wrapper<Mn::SceneGraph::Drawable3D>,
-                        Mn::Matrix4>>
-      drawableTransforms = drawableTransformations(drawables);
+  useMeshLODs_ = bool(flags & Flag::MeshLOD);
 
   if (flags & Flag::ObjectsOnly) {
     // draw just the OBJECTS
@@ -188,7 +262,19 @@ uint32_t RenderCamera::draw(MagnumDrawableGroup& drawables, Flags flags) {
         drawableTransforms.end());
   }
 
-  MagnumCamera::draw(drawableTransforms);
+  // draw the drawables sharing GL state one after another, the first one of
+  // each run binds it for the rest
+  const std::vector<Drawable::StateKey> keys = sortByState(drawableTransforms);
+  boundShader_ = nullptr;
+  boundMaterial_ = nullptr;
+  boundLightSetup_ = nullptr;
+  drawStatistics_ = DrawStatistics{};
+
+  if (flags & Flag::Instancing) {
+    drawInstanced(drawableTransforms, keys);
+  } else {
+    MagnumCamera::draw(drawableTransforms);
+  }
 
   // reset
   if (useDrawableIds_) {
@@ -197,6 +283,114 @@ uint32_t RenderCamera::draw(MagnumDrawableGroup& drawables, Flags flags) {
   return drawableTransforms.size();
 }
 
+std::vector<Drawable::StateKey> RenderCamera::sortByState(
+    DrawableTransforms& drawableTransforms) {
+  // compute the keys once, the drawables of a DrawableGroup are all
+  // gfx::Drawable
+  std::vector<std::pair<Drawable::StateKey, size_t>> keys;
+  keys.reserve(drawableTransforms.size());
+  for (size_t i = 0; i < drawableTransforms.size(); ++i) {
+    keys.emplace_back(
+        static_cast<Drawable&>(drawableTransforms[i].first.get())
+            .getStateKey(),
+        i);
+  }
+  // keep the scene graph order within a run of equal keys
+  std::stable_sort(keys.begin(), keys.end(),
+                   [](const std::pair<Drawable::StateKey, size_t>& a,
+                      const std::pair<Drawable::StateKey, size_t>& b) {
+                     return a.first < b.first;
+                   });
+
+  DrawableTransforms sorted;
+  sorted.reserve(drawableTransforms.size());
+  std::vector<Drawable::StateKey> sortedKeys;
+  sortedKeys.reserve(drawableTransforms.size());
+  for (const auto& key : keys) {
+    sorted.emplace_back(drawableTransforms[key.second]);
+    sortedKeys.emplace_back(key.first);
+  }
+  drawableTransforms = std::move(sorted);
+  return sortedKeys;
+}
+
+void RenderCamera::drawInstanced(const DrawableTransforms& drawableTransforms,
+                                 const std::vector<Drawable::StateKey>& keys) {
+  for (size_t begin = 0; begin < drawableTransforms.size();) {
+    auto& drawable =
+        static_cast<Drawable&>(drawableTransforms[begin].first.get());
+    // drawables switching between levels of detail draw different meshes
+    auto instanceable = [this](Drawable& drawable) {
+      return drawable.isInstanceable() &&
+             !(useMeshLODs_ && drawable.getMeshLODs());
+    };
+    size_t end = begin + 1;
+    if (instanceable(drawable)) {
+      while (end < drawableTransforms.size() && keys[end] == keys[begin] &&
+             instanceable(static_cast<Drawable&>(
+                 drawableTransforms[end].first.get()))) {
+        ++end;
+      }
+    }
+
+    if (end - begin > 1) {
+      drawStatistics_.instancedDrawables += end - begin;
+      drawable.drawInstances({drawableTransforms.data() + begin, end - begin},
+                             *this);
+    } else {
+      drawable.draw(drawableTransforms[begin].second, *this);
+    }
+    begin = end;
+  }
+}
+
+RenderCamera::StateChanges RenderCamera::bindDrawState(
+    const void* shader,
+    const void* material,
+    const void* lightSetup) {
+  StateChanges changes;
+  // uniforms are per shader, so switching the shader invalidates them all
+  if (shader != boundShader_) {
+    changes |= StateChange::Shader | StateChange::Material;
+    if (lightSetup) {
+      changes |= StateChange::Lights;
+    }
+  }
+  if (!material || material != boundMaterial_) {
+    changes |= StateChange::Material;
+  }
+  if (lightSetup && lightSetup != boundLightSetup_) {
+    changes |= StateChange::Lights;
+  }
+
+  boundShader_ = shader;
+  boundMaterial_ = material;
+  boundLightSetup_ = lightSetup;
+
+  ++drawStatistics_.drawCalls;
+  if (changes & StateChange::Shader) {
+    ++drawStatistics_.shaderBinds;
+  }
+  if (changes & StateChange::Material) {
+    ++drawStatistics_.materialBinds;
+  }
+  if (changes & StateChange::Lights) {
+    ++drawStatistics_.lightUploads;
+  }
+  return changes;
+}
+
+void RenderCamera::countDraw(const Mn::GL::Mesh& mesh,
+                             uint32_t instanceCount,
+                             bool reducedDetail) {
+  if (mesh.primitive() == Mn::GL::MeshPrimitive::Triangles) {
+    drawStatistics_.triangles += uint64_t(mesh.count()) / 3 * instanceCount;
+  }
+  if (reducedDetail) {
+    drawStatistics_.reducedDrawables += instanceCount;
+  }
+}
+
 esp::geo::Ray RenderCamera::unproject(const Mn::Vector2i& viewportPosition) {
   esp::geo::Ray ray;
   ray.origin = object().absoluteTranslation();
@@ -9,11 +9,14 @@
 
 #include "esp/core/esp.h"
 #include "esp/geo/geo.h"
+#include "esp/gfx/Drawable.h"
 #include "esp/scene/SceneNode.h"
 
 namespace esp {
 namespace gfx {
 
+class DrawableGroup;
+
 class RenderCamera : public MagnumCamera {
  public:
   /**
@@ -38,11 +41,73 @@ class RenderCamera : public MagnumCamera {
      * object id" is not set)
      */
     UseDrawableIdAsObjectId = 1 << 2,
+    /**
+     * Draw runs of Drawables sharing shader, material and mesh with a single
+     * instanced draw call where the Drawables support it.
+     */
+    Instancing = 1 << 3,
+    /**
+     * Draw Drawables that have levels of detail at the coarsest level whose
+     * simplification error projects to at most a pixel, see
+     * @ref Drawable::setMeshLODs().
+     */
+    MeshLOD = 1 << 4,
   };
 
   typedef Corrade::Containers::EnumSet<Flag> Flags;
   CORRADE_ENUMSET_FRIEND_OPERATORS(Flags)
 
+  /**
+   * @brief GL state a drawable has to (re)bind before drawing, see
+   * @ref bindDrawState()
+   */
+  enum class StateChange : Magnum::UnsignedByte {
+    /**
+     * The shader differs from the one of the previous drawable, uniforms
+     * shared by all drawables of the pass (e.g. the projection) are needed.
+     */
+    Shader = 1 << 0,
+    /**
+     * The material uniforms and textures need to be bound.
+     */
+    Material = 1 << 1,
+    /**
+     * The per-light uniforms need to be uploaded.
+     */
+    Lights = 1 << 2,
+  };
+
+  typedef Corrade::Containers::EnumSet<StateChange> StateChanges;
+  CORRADE_ENUMSET_FRIEND_OPERATORS(StateChanges)
+
+  /**
+   * @brief Counters of the GL state bound during a draw pass
+   */
+  struct DrawStatistics {
+    /** Number of draw calls */
+    uint32_t drawCalls = 0;
+    /** Number of drawables drawn by instanced draw calls */
+    uint32_t instancedDrawables = 0;
+    /** Number of shader switches */
+    uint32_t shaderBinds = 0;
+    /** Number of times material uniforms and textures were bound */
+    uint32_t materialBinds = 0;
+    /** Number of uploads of the per-light uniforms */
+    uint32_t lightUploads = 0;
+    /** Number of drawables drawn at a reduced level of detail */
+    uint32_t reducedDrawables = 0;
+    /** Number of triangles drawn, see @ref countDraw() */
+    uint64_t triangles = 0;
+  };
+
+  /**
+   * @brief Drawables paired with their transformations
+   */
+  typedef std::vector<
+      std::pair<std::reference_wrapper<Magnum::SceneGraph::Drawable3D>,
+                Magnum::Matrix4>>
+      DrawableTransforms;
+
   /**
    * @brief Constructor
    * @param node, the scene node to which the camera is attached
@@ -151,6 +216,17 @@ class RenderCamera : public MagnumCamera {
    */
   uint32_t draw(MagnumDrawableGroup& drawables, Flags flags = {});
 
+  /**
+   * @brief Overload function to render drawables whose absolute
+   * transformations were computed in advance, so that several cameras
+   * viewing the same scene traverse it only once
+   * @param absoluteTransforms, a vector of pairs of Drawable3D object and its
+   * absolute transformation
+   * @param flags, the rendering flags
+   * @return the number of drawables that are drawn
+   */
+  uint32_t draw(const DrawableTransforms& absoluteTransforms, Flags flags = {});
+
   /**
    * @brief performs the frustum culling
    * @param drawableTransforms, a vector of pairs of Drawable3D object and its
@@ -186,6 +262,12 @@ class RenderCamera : public MagnumCamera {
    * following rendering pass, otherwise false
    */
   bool useDrawableIds() { return useDrawableIds_; }
+
+  /**
+   * @brief if the current rendering pass draws drawables at their levels of
+   * detail, see @ref Flag::MeshLOD
+   */
+  bool useMeshLODs() const { return useMeshLODs_; }
   /**
    * @brief Unproject a 2D viewport point to a 3D ray with origin at camera
    * position.
@@ -205,9 +287,79 @@ class RenderCamera : public MagnumCamera {
     return previousNumVisibleDrawables_;
   }
 
+  /**
+   * @brief Called by a drawable right before it draws, to track the GL state
+   * bound during the current render pass
+   * @param shader, the shader the drawable draws with
+   * @param material, the material the drawable binds, nullptr if it binds
+   * its own state unconditionally
+   * @param lightSetup, the light setup the shader is lit by, or nullptr
+   * @return the state the drawable needs to bind, i.e. whatever differs from
+   * the state left by the previous drawable of the pass
+   */
+  StateChanges bindDrawState(const void* shader,
+                             const void* material,
+                             const void* lightSetup);
+
+  /**
+   * @brief Called by a drawable when it draws, to count the triangles drawn
+   * during the current render pass
+   * @param mesh, the mesh drawn
+   * @param instanceCount, the number of instances of the mesh drawn
+   * @param reducedDetail, whether the mesh is a reduced level of detail
+   */
+  void countDraw(const Magnum::GL::Mesh& mesh,
+                 uint32_t instanceCount = 1,
+                 bool reducedDetail = false);
+
+  /**
+   * @brief Query the counters of the GL state bound during the most recent
+   * render pass
+   */
+  const DrawStatistics& getPreviousDrawStatistics() const {
+    return drawStatistics_;
+  }
+
  protected:
+  /**
+   * @brief Filters the drawables according to @p flags and draws the rest
+   * @param drawableTransforms, a vector of pairs of Drawable3D object and its
+   * transformation relative to the camera
+   * @return the number of drawables that are drawn
+   */
+  uint32_t drawFiltered(DrawableTransforms& drawableTransforms, Flags flags);
+
+  /**
+   * @brief Frustum culls the drawables of @p drawables through its static BVH
+   * and draws the rest, computing the transformations of visible drawables
+   * only
+   * @return the number of drawables that are drawn
+   */
+  uint32_t drawCulled(DrawableGroup& drawables, Flags flags);
+
+  /**
+   * @brief Sorts the drawables by their @ref Drawable::StateKey
+   * @return the sorted keys
+   */
+  std::vector<Drawable::StateKey> sortByState(
+      DrawableTransforms& drawableTransforms);
+
+  /**
+   * @brief Draws the sorted drawables, every run of instanceable drawables
+   * sharing a key with one instanced draw call
+   */
+  void drawInstanced(const DrawableTransforms& drawableTransforms,
+                     const std::vector<Drawable::StateKey>& keys);
+
   size_t previousNumVisibleDrawables_ = 0;
   bool useDrawableIds_ = false;
+  bool useMeshLODs_ = false;
+
+  // state left by the last drawable of the current pass
+  const void* boundShader_ = nullptr;
+  const void* boundMaterial_ = nullptr;
+  const void* boundLightSetup_ = nullptr;
+  DrawStatistics drawStatistics_;
   ESP_SMART_POINTERS(RenderCamera)
 };
 
@@ -2,10 +2,15 @@
 // This source code is licensed under the MIT license found in the
 // LICENSE file in the root directory of this source tree.
 
+#include <algorithm>
+#include <vector>
+
+#include <Corrade/Containers/Optional.h>
 #include <Magnum/GL/Buffer.h>
 #include <Magnum/GL/BufferImage.h>
 #include <Magnum/GL/DefaultFramebuffer.h>
 #include <Magnum/GL/Framebuffer.h>
+#include <Magnum/GL/OpenGL.h>
 #include <Magnum/GL/PixelFormat.h>
 #include <Magnum/GL/Renderbuffer.h>
 #include <Magnum/GL/RenderbufferFormat.h>
@@ -15,6 +20,8 @@
 #include <Magnum/Image.h>
 #include <Magnum/ImageView.h>
 #include <Magnum/Math/Color.h>
+#include <Magnum/Math/Functions.h>
+#include <Magnum/Math/Range.h>
 #include <Magnum/PixelFormat.h>
 
 #include "RenderTarget.h"
@@ -41,12 +48,124 @@ const Mn::GL::Framebuffer::ColorAttachment ObjectIdBuffer =
 const Mn::GL::Framebuffer::ColorAttachment UnprojectedDepthBuffer =
     Mn::GL::Framebuffer::ColorAttachment{0};
 
+constexpr int RenderTarget::NumReadbackBuffers;
+
+#ifndef MAGNUM_TARGET_WEBGL
+namespace {
+// How long a single wait for a fence blocks, in nanoseconds
+constexpr GLuint64 FenceWaitTimeout = 1000000000ull;
+}  // namespace
+#endif
+
+struct PendingReadback::State {
+  ~State() {
+#ifndef MAGNUM_TARGET_WEBGL
+    if (fence)
+      glDeleteSync(fence);
+#endif
+  }
+
+  bool isReady() const {
+#ifndef MAGNUM_TARGET_WEBGL
+    if (!pending)
+      return true;
+    const GLenum result = glClientWaitSync(fence, 0, 0);
+    return result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED;
+#else
+    return true;
+#endif
+  }
+
+  void finish() {
+#ifndef MAGNUM_TARGET_WEBGL
+    if (!pending)
+      return;
+    pending = false;
+
+    GLenum result = GL_TIMEOUT_EXPIRED;
+    while (result == GL_TIMEOUT_EXPIRED) {
+      result =
+          glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, FenceWaitTimeout);
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+    if (result == GL_WAIT_FAILED) {
+      LOG(ERROR) << "PendingReadback::wait(): waiting for the GPU failed";
+      return;
+    }
+
+    // the columns of the framebuffer are consecutive in the destination
+    std::size_t offset = 0;
+    for (Mn::GL::BufferImage2D& image : images) {
+      const std::size_t size = image.dataSize();
+      Cr::Containers::ArrayView<const char> data = image.buffer().map(
+          0, size, Mn::GL::Buffer::MapFlag::Read);
+      CORRADE_INTERNAL_ASSERT(data.data() &&
+                              offset + size <= destination.size());
+      std::copy(data.begin(), data.end(), destination.begin() + offset);
+      image.buffer().unmap();
+      offset += size;
+    }
+
+    if (depthUnprojection) {
+      unprojectDepth(*depthUnprojection,
+                     Cr::Containers::arrayCast<Mn::Float>(destination));
+    }
+#endif
+  }
+
+  // one per framebuffer column
+  std::vector<Mn::GL::BufferImage2D> images;
+#ifndef MAGNUM_TARGET_WEBGL
+  GLsync fence = nullptr;
+#endif
+  Cr::Containers::ArrayView<char> destination;
+  // set if the depth still needs to be unprojected on the CPU
+  Cr::Containers::Optional<Mn::Vector2> depthUnprojection;
+  std::uint64_t generation = 0;
+  bool pending = false;
+};
+
+PendingReadback::PendingReadback(std::shared_ptr<State> state,
+                                 std::uint64_t generation)
+    : state_{std::move(state)}, generation_{generation} {}
+
+bool PendingReadback::isReady() const {
+  return isDone() || state_->isReady();
+}
+
+bool PendingReadback::isDone() const {
+  // a newer read of the same pixel buffer finished this one first
+  return !state_ || state_->generation != generation_ || !state_->pending;
+}
+
+void PendingReadback::wait() {
+  if (!isDone())
+    state_->finish();
+}
+
+namespace {
+// Number of tiles that fit on top of each other in one framebuffer column
+int tilesPerColumn(const Mn::Vector2i& tileSize, int numTiles) {
+  if (numTiles == 1)
+    return 1;
+  const int maxHeight = Mn::Math::min(Mn::GL::Renderbuffer::maxSize(),
+                                      Mn::GL::Texture2D::maxSize().y());
+  const int maxTiles = maxHeight / Mn::Math::max(tileSize.y(), 1);
+  return Mn::Math::max(1, Mn::Math::min(numTiles, maxTiles));
+}
+}  // namespace
+
 struct RenderTarget::Impl {
-  Impl(const Mn::Vector2i& size,
+  Impl(const Mn::Vector2i& tileSize,
+       int numTiles,
        const Mn::Vector2& depthUnprojection,
        DepthShader* depthShader,
        Renderer::Flags flags)
-      : colorBuffer_{},
+      : tileSize_{tileSize},
+        numTiles_{numTiles},
+        tilesPerColumn_{tilesPerColumn(tileSize, numTiles)},
+        colorBuffer_{},
         objectIdBuffer_{},
         depthRenderTexture_{},
         framebuffer_{Mn::NoCreate},
@@ -61,14 +180,21 @@ struct RenderTarget::Impl {
                               DepthShader::Flag::UnprojectExistingDepth);
     }
 
-    colorBuffer_.setStorage(Mn::GL::RenderbufferFormat::SRGB8Alpha8, size);
-    objectIdBuffer_.setStorage(Mn::GL::RenderbufferFormat::R32UI, size);
+    if (numTiles_ < 1)
+      throw std::runtime_error("A render target needs at least one tile");
+    const int numColumns = (numTiles_ + tilesPerColumn_ - 1) / tilesPerColumn_;
+    size_ = tileSize_ * Mn::Vector2i{numColumns, tilesPerColumn_};
+    if (numColumns > 1 && size_.x() > Mn::GL::Renderbuffer::maxSize())
+      throw std::runtime_error("Too many tiles to fit in one framebuffer");
+
+    colorBuffer_.setStorage(Mn::GL::RenderbufferFormat::SRGB8Alpha8, size_);
+    objectIdBuffer_.setStorage(Mn::GL::RenderbufferFormat::R32UI, size_);
     depthRenderTexture_.setMinificationFilter(Mn::GL::SamplerFilter::Nearest)
         .setMagnificationFilter(Mn::GL::SamplerFilter::Nearest)
         .setWrapping(Mn::GL::SamplerWrapping::ClampToEdge)
-        .setStorage(1, Mn::GL::TextureFormat::DepthComponent32F, size);
+        .setStorage(1, Mn::GL::TextureFormat::DepthComponent32F, size_);
 
-    framebuffer_ = Mn::GL::Framebuffer{{{}, size}};
+    framebuffer_ = Mn::GL::Framebuffer{{{}, size_}};
     framebuffer_.attachRenderbuffer(RgbaBuffer, colorBuffer_)
         .attachRenderbuffer(ObjectIdBuffer, objectIdBuffer_)
         .attachTexture(Mn::GL::Framebuffer::BufferAttachment::Depth,
@@ -119,7 +245,44 @@ struct RenderTarget::Impl {
 
   void renderReEnter() { framebuffer_.bind(); }
 
-  void renderExit() {}
+  void renderEnterTile(int tile) {
+    CORRADE_INTERNAL_ASSERT(tile >= 0 && tile < numTiles_);
+    const Mn::Vector2i offset{(tile / tilesPerColumn_) * tileSize_.x(),
+                              (tile % tilesPerColumn_) * tileSize_.y()};
+    framebuffer_.setViewport(Mn::Range2Di::fromSize(offset, tileSize_)).bind();
+  }
+
+  void renderExit() {
+    if (numTiles_ > 1)
+      framebuffer_.setViewport({{}, size_});
+  }
+
+  // Reads the tiles of the framebuffer currently mapped for reading, stacked
+  // on top of each other, into view
+  void readTiles(Mn::GL::AbstractFramebuffer& framebuffer,
+                 const Mn::MutableImageView2D& view) {
+    CORRADE_INTERNAL_ASSERT(view.size() == readFrameSize());
+    if (tilesPerColumn_ == numTiles_) {
+      framebuffer.read(Mn::Range2Di{{}, view.size()}, view);
+      return;
+    }
+
+    // Each column of the framebuffer is a contiguous run of tiles in view
+    const std::size_t tileBytes = view.pixelSize() * tileSize_.product();
+    for (int first = 0; first < numTiles_; first += tilesPerColumn_) {
+      const int count = Mn::Math::min(tilesPerColumn_, numTiles_ - first);
+      const Mn::Vector2i offset{(first / tilesPerColumn_) * tileSize_.x(), 0};
+      Mn::MutableImageView2D columnView{
+          view.storage(),
+          view.format(),
+          view.formatExtra(),
+          view.pixelSize(),
+          {tileSize_.x(), tileSize_.y() * count},
+          view.data().suffix(first * tileBytes)};
+      framebuffer.read(Mn::Range2Di::fromSize(offset, columnView.size()),
+                       columnView);
+    }
+  }
 
   void blitRgbaToDefault() {
     if (rendererFlags_ & Renderer::Flag::NoTextures)
@@ -135,38 +298,145 @@ struct RenderTarget::Impl {
         Mn::GL::FramebufferBlitFilter::Nearest);
   }
 
+  // Starts reading the tiles of the framebuffer currently mapped for reading
+  // into the next pixel buffer, to be copied into view once done. The depth is
+  // unprojected on the CPU at that point if depthUnprojection is set
+  PendingReadback::ptr readTilesAsync(
+      Mn::GL::Framebuffer& framebuffer,
+      const Mn::MutableImageView2D& view,
+      const Cr::Containers::Optional<Mn::Vector2>& depthUnprojection = {}) {
+#ifdef MAGNUM_TARGET_WEBGL
+    // no fences or buffer mapping, read synchronously
+    readTiles(framebuffer, view);
+    if (depthUnprojection) {
+      unprojectDepth(*depthUnprojection,
+                     Cr::Containers::arrayCast<Mn::Float>(view.data()));
+    }
+    return PendingReadback::create(nullptr, 0);
+#else
+    CORRADE_INTERNAL_ASSERT(view.size() == readFrameSize());
+    std::shared_ptr<PendingReadback::State>& state =
+        readbackStates_[nextReadbackState_];
+    nextReadbackState_ = (nextReadbackState_ + 1) % NumReadbackBuffers;
+    if (!state) {
+      state = std::make_shared<PendingReadback::State>();
+    }
+    // the previous read into this pixel buffer has to land first
+    state->finish();
+
+    const Mn::GL::PixelFormat format = Mn::GL::pixelFormat(view.format());
+    const Mn::GL::PixelType type =
+        Mn::GL::pixelType(view.format(), view.formatExtra());
+    const int numColumns = (numTiles_ + tilesPerColumn_ - 1) / tilesPerColumn_;
+    if (state->images.size() != std::size_t(numColumns) ||
+        state->images.front().format() != format ||
+        state->images.front().type() != type) {
+      state->images.clear();
+      for (int i = 0; i < numColumns; ++i) {
+        state->images.emplace_back(format, type);
+      }
+    }
+
+    for (int first = 0; first < numTiles_; first += tilesPerColumn_) {
+      const int count = Mn::Math::min(tilesPerColumn_, numTiles_ - first);
+      const Mn::Vector2i offset{(first / tilesPerColumn_) * tileSize_.x(), 0};
+      const Mn::Vector2i size{tileSize_.x(), tileSize_.y() * count};
+      framebuffer.read(Mn::Range2Di::fromSize(offset, size),
+                       state->images[first / tilesPerColumn_],
+                       Mn::GL::BufferUsage::StreamRead);
+    }
+
+    state->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    state->destination = view.data();
+    state->depthUnprojection = depthUnprojection;
+    state->pending = true;
+    ++state->generation;
+    return PendingReadback::create(state, state->generation);
+#endif
+  }
+
   void readFrameRgba(const Mn::MutableImageView2D& view) {
     if (rendererFlags_ & Renderer::Flag::NoTextures)
       throw std::runtime_error(
           "Simulator was initialized with requiresTextures = false");
 
-    framebuffer_.mapForRead(RgbaBuffer).read(framebuffer_.viewport(), view);
+    readTiles(framebuffer_.mapForRead(RgbaBuffer), view);
   }
 
   void readFrameDepth(const Mn::MutableImageView2D& view) {
     if (depthShader_) {
       unprojectDepthGPU();
-      depthUnprojectionFrameBuffer_.mapForRead(UnprojectedDepthBuffer)
-          .read(framebuffer_.viewport(), view);
+      readTiles(
+          depthUnprojectionFrameBuffer_.mapForRead(UnprojectedDepthBuffer),
+          view);
     } else {
       Mn::MutableImageView2D depthBufferView{
           Mn::GL::PixelFormat::DepthComponent, Mn::GL::PixelType::Float,
           view.size(), view.data()};
-      framebuffer_.read(framebuffer_.viewport(), depthBufferView);
+      readTiles(framebuffer_, depthBufferView);
       unprojectDepth(depthUnprojection_,
                      Cr::Containers::arrayCast<Mn::Float>(view.data()));
     }
   }
 
   void readFrameObjectId(const Mn::MutableImageView2D& view) {
-    framebuffer_.mapForRead(ObjectIdBuffer).read(framebuffer_.viewport(), view);
+    readTiles(framebuffer_.mapForRead(ObjectIdBuffer), view);
+  }
+
+  PendingReadback::ptr readFrameRgbaAsync(const Mn::MutableImageView2D& view) {
+    if (rendererFlags_ & Renderer::Flag::NoTextures)
+      throw std::runtime_error(
+          "Simulator was initialized with requiresTextures = false");
+
+    return readTilesAsync(framebuffer_.mapForRead(RgbaBuffer), view);
   }
 
-  Mn::Vector2i framebufferSize() const {
-    return framebuffer_.viewport().size();
+  PendingReadback::ptr readFrameDepthAsync(const Mn::MutableImageView2D& view) {
+    if (depthShader_) {
+      unprojectDepthGPU();
+      return readTilesAsync(
+          depthUnprojectionFrameBuffer_.mapForRead(UnprojectedDepthBuffer),
+          view);
+    } else {
+      Mn::MutableImageView2D depthBufferView{
+          Mn::GL::PixelFormat::DepthComponent, Mn::GL::PixelType::Float,
+          view.size(), view.data()};
+      return readTilesAsync(framebuffer_, depthBufferView, depthUnprojection_);
+    }
+  }
+
+  PendingReadback::ptr readFrameObjectIdAsync(
+      const Mn::MutableImageView2D& view) {
+    return readTilesAsync(framebuffer_.mapForRead(ObjectIdBuffer), view);
+  }
+
+  Mn::Vector2i framebufferSize() const { return size_; }
+
+  Mn::Vector2i tileSize() const { return tileSize_; }
+
+  int numTiles() const { return numTiles_; }
+
+  Mn::Vector2i readFrameSize() const {
+    return {tileSize_.x(), tileSize_.y() * numTiles_};
   }
 
 #ifdef ESP_BUILD_WITH_CUDA
+  // Copies the tiles of a mapped CUDA array, stacked on top of each other,
+  // into devPtr
+  void copyTilesFromArray(void* devPtr,
+                          cudaArray* array,
+                          std::size_t pixelSize) {
+    const std::size_t widthInBytes = tileSize_.x() * pixelSize;
+    const std::size_t tileBytes = widthInBytes * tileSize_.y();
+    for (int first = 0; first < numTiles_; first += tilesPerColumn_) {
+      const int count = Mn::Math::min(tilesPerColumn_, numTiles_ - first);
+      checkCudaErrors(cudaMemcpy2DFromArray(
+          static_cast<char*>(devPtr) + first * tileBytes, widthInBytes, array,
+          (first / tilesPerColumn_) * widthInBytes, 0, widthInBytes,
+          tileSize_.y() * count, cudaMemcpyDeviceToDevice));
+    }
+  }
+
   void readFrameRgbaGPU(uint8_t* devPtr) {
     // TODO: Consider implementing the GPU read functions with EGLImage
     // See discussion here:
@@ -186,10 +456,7 @@ struct RenderTarget::Impl {
     cudaArray* array = nullptr;
     checkCudaErrors(
         cudaGraphicsSubResourceGetMappedArray(&array, colorBufferCugl_, 0, 0));
-    const int widthInBytes = framebufferSize().x() * 4 * sizeof(uint8_t);
-    checkCudaErrors(cudaMemcpy2DFromArray(devPtr, widthInBytes, array, 0, 0,
-                                          widthInBytes, framebufferSize().y(),
-                                          cudaMemcpyDeviceToDevice));
+    copyTilesFromArray(devPtr, array, 4 * sizeof(uint8_t));
 
     checkCudaErrors(cudaGraphicsUnmapResources(1, &colorBufferCugl_, 0));
   }
@@ -207,10 +474,7 @@ struct RenderTarget::Impl {
     cudaArray* array = nullptr;
     checkCudaErrors(
         cudaGraphicsSubResourceGetMappedArray(&array, depthBufferCugl_, 0, 0));
-    const int widthInBytes = framebufferSize().x() * 1 * sizeof(float);
-    checkCudaErrors(cudaMemcpy2DFromArray(devPtr, widthInBytes, array, 0, 0,
-                                          widthInBytes, framebufferSize().y(),
-                                          cudaMemcpyDeviceToDevice));
+    copyTilesFromArray(devPtr, array, 1 * sizeof(float));
 
     checkCudaErrors(cudaGraphicsUnmapResources(1, &depthBufferCugl_, 0));
   }
@@ -226,10 +490,7 @@ struct RenderTarget::Impl {
     cudaArray* array = nullptr;
     checkCudaErrors(cudaGraphicsSubResourceGetMappedArray(
         &array, objecIdBufferCugl_, 0, 0));
-    const int widthInBytes = framebufferSize().x() * 1 * sizeof(int32_t);
-    checkCudaErrors(cudaMemcpy2DFromArray(devPtr, widthInBytes, array, 0, 0,
-                                          widthInBytes, framebufferSize().y(),
-                                          cudaMemcpyDeviceToDevice));
+    copyTilesFromArray(devPtr, array, 1 * sizeof(int32_t));
 
     checkCudaErrors(cudaGraphicsUnmapResources(1, &objecIdBufferCugl_, 0));
   }
@@ -249,6 +510,11 @@ struct RenderTarget::Impl {
 #endif
 
  private:
+  const Mn::Vector2i tileSize_;
+  const int numTiles_;
+  const int tilesPerColumn_;
+  Mn::Vector2i size_;
+
   Mn::GL::Renderbuffer colorBuffer_;
   Mn::GL::Renderbuffer objectIdBuffer_;
   Mn::GL::Texture2D depthRenderTexture_;
@@ -262,6 +528,9 @@ struct RenderTarget::Impl {
 
   const Renderer::Flags rendererFlags_;
 
+  std::shared_ptr<PendingReadback::State> readbackStates_[NumReadbackBuffers];
+  int nextReadbackState_ = 0;
+
 #ifdef ESP_BUILD_WITH_CUDA
   cudaGraphicsResource_t colorBufferCugl_ = nullptr;
   cudaGraphicsResource_t objecIdBufferCugl_ = nullptr;
@@ -273,7 +542,15 @@ RenderTarget::RenderTarget(const Mn::Vector2i& size,
                            const Mn::Vector2& depthUnprojection,
                            DepthShader* depthShader,
                            Renderer::Flags flags)
-    : pimpl_(spimpl::make_unique_impl<Impl>(size,
+    : RenderTarget{size, 1, depthUnprojection, depthShader, flags} {}
+
+RenderTarget::RenderTarget(const Mn::Vector2i& tileSize,
+                           int numTiles,
+                           const Mn::Vector2& depthUnprojection,
+                           DepthShader* depthShader,
+                           Renderer::Flags flags)
+    : pimpl_(spimpl::make_unique_impl<Impl>(tileSize,
+                                            numTiles,
                                             depthUnprojection,
                                             depthShader,
                                             flags)) {}
@@ -286,6 +563,10 @@ void RenderTarget::renderReEnter() {
   pimpl_->renderReEnter();
 }
 
+void RenderTarget::renderEnterTile(int tile) {
+  pimpl_->renderEnterTile(tile);
+}
+
 void RenderTarget::renderExit() {
   pimpl_->renderExit();
 }
@@ -302,6 +583,21 @@ void RenderTarget::readFrameObjectId(const Mn::MutableImageView2D& view) {
   pimpl_->readFrameObjectId(view);
 }
 
+PendingReadback::ptr RenderTarget::readFrameRgbaAsync(
+    const Mn::MutableImageView2D& view) {
+  return pimpl_->readFrameRgbaAsync(view);
+}
+
+PendingReadback::ptr RenderTarget::readFrameDepthAsync(
+    const Mn::MutableImageView2D& view) {
+  return pimpl_->readFrameDepthAsync(view);
+}
+
+PendingReadback::ptr RenderTarget::readFrameObjectIdAsync(
+    const Mn::MutableImageView2D& view) {
+  return pimpl_->readFrameObjectIdAsync(view);
+}
+
 void RenderTarget::blitRgbaToDefault() {
   pimpl_->blitRgbaToDefault();
 }
@@ -310,6 +606,18 @@ Mn::Vector2i RenderTarget::framebufferSize() const {
   return pimpl_->framebufferSize();
 }
 
+Mn::Vector2i RenderTarget::tileSize() const {
+  return pimpl_->tileSize();
+}
+
+int RenderTarget::numTiles() const {
+  return pimpl_->numTiles();
+}
+
+Mn::Vector2i RenderTarget::readFrameSize() const {
+  return pimpl_->readFrameSize();
+}
+
 #ifdef ESP_BUILD_WITH_CUDA
 void RenderTarget::readFrameRgbaGPU(uint8_t* devPtr) {
   pimpl_->readFrameRgbaGPU(devPtr);
@@ -15,15 +15,73 @@
 namespace esp {
 namespace gfx {
 
+/**
+ * @brief Rendering results being read into memory asynchronously, by one of
+ * the readFrame*Async functions of @ref RenderTarget
+ *
+ * The results are in the memory passed to the read only once @ref wait has
+ * returned.  All functions have to be called from the thread owning the GL
+ * context.
+ */
+class PendingReadback {
+ public:
+  /**
+   * @brief Pixel buffer the results are read into, defined by @ref
+   * RenderTarget
+   */
+  struct State;
+
+  /**
+   * @brief Constructor
+   * @param state      The pixel buffer the results are read into
+   * @param generation The read of @p state this handle refers to
+   */
+  PendingReadback(std::shared_ptr<State> state, std::uint64_t generation);
+
+  /**
+   * @brief Whether or not the GPU has finished writing the results, in which
+   * case @ref wait does not block.  Does not block itself
+   */
+  bool isReady() const;
+
+  /**
+   * @brief Whether or not the results are in memory
+   */
+  bool isDone() const;
+
+  /**
+   * @brief Waits for the GPU to finish writing the results and copies them
+   * into the memory passed to the read.  Does nothing if they already are
+   */
+  void wait();
+
+ private:
+  std::shared_ptr<State> state_;
+  std::uint64_t generation_;
+
+  ESP_SMART_POINTERS(PendingReadback)
+};
+
 /**
  * Holds a framebuffer and encapsulates the logic of retrieving rendering
  * results of various types (RGB, Depth, ObjectID) from the framebuffer.
  *
  * Reads the rendering results into either CPU or GPU, if compiled with CUDA,
  * memory
+ *
+ * A batch render target lays out several tiles of the same size in one
+ * framebuffer, one per view drawn by @ref Renderer::drawBatch(). Its results
+ * are read for all tiles at once, stacked on top of each other, i.e. as one
+ * contiguous [N, H, W, C] array.
  */
 class RenderTarget {
  public:
+  /**
+   * @brief The number of pixel buffers the asynchronous reads rotate through.
+   * A read finishes the one that used the same pixel buffer before it
+   */
+  static constexpr int NumReadbackBuffers = 2;
+
   /**
    * @brief Constructor
    * @param size               The size of the underlying framebuffers in WxH
@@ -44,6 +102,26 @@ class RenderTarget {
                DepthShader* depthShader,
                Renderer::Flags flags);
 
+  /**
+   * @brief Construct a batch render target
+   * @param tileSize           The size of every tile in WxH
+   * @param numTiles           The number of tiles
+   * @param depthUnprojection  Depth unprojection parameters shared by all
+   *                           tiles.  See @ref calculateDepthUnprojection()
+   * @param depthShader        A DepthShader used to unproject depth on the GPU.
+   *                           Unprojects the depth on the CPU if nullptr.
+   * @param flags              The flags of the renderer that constructed this
+   *                           render target.
+   *
+   * The tiles are stacked in columns as tall as the framebuffer size limits
+   * allow, which is usually a single column.
+   */
+  RenderTarget(const Magnum::Vector2i& tileSize,
+               int numTiles,
+               const Magnum::Vector2& depthUnprojection,
+               DepthShader* depthShader,
+               Renderer::Flags flags);
+
   /**
    * @brief Constructor
    * @param size               The size of the underlying framebuffers in WxH
@@ -71,6 +149,13 @@ class RenderTarget {
    */
   void renderReEnter();
 
+  /**
+   * @brief Binds the framebuffer and restricts drawing to one tile.  Call
+   * after @ref renderEnter, which clears all the tiles.
+   * @param tile The index of the tile
+   */
+  void renderEnterTile(int tile);
+
   /**
    * @brief Called after any draw calls that target this RenderTarget
    */
@@ -81,9 +166,29 @@ class RenderTarget {
    */
   Magnum::Vector2i framebufferSize() const;
 
+  /**
+   * @brief The size of a tile in WxH. Same as @ref framebufferSize for a
+   * render target that is not a batch
+   */
+  Magnum::Vector2i tileSize() const;
+
+  /**
+   * @brief The number of tiles, 1 for a render target that is not a batch
+   */
+  int numTiles() const;
+
+  /**
+   * @brief The size of the images read by the readFrame* functions in WxH,
+   * @ref tileSize with its height multiplied by @ref numTiles
+   */
+  Magnum::Vector2i readFrameSize() const;
+
   /**
    * @brief Retrieve the RGBA rendering results.
    *
+   * The size of @p view must be @ref readFrameSize for this and the other
+   * readFrame* functions.
+   *
    * @param[in, out] view Preallocated memory that will be populated with the
    * result.  The result will be read as the pixel format of this view.
    */
@@ -110,6 +215,31 @@ class RenderTarget {
    */
   void readFrameObjectId(const Magnum::MutableImageView2D& view);
 
+  /**
+   * @brief Asynchronous version of @ref readFrameRgba
+   *
+   * Starts reading the results into a pixel buffer and returns without
+   * waiting for the GPU.  @p view has to stay valid until the returned
+   * handle was waited on, or until @ref NumReadbackBuffers more reads
+   * were started on this render target.
+   */
+  PendingReadback::ptr readFrameRgbaAsync(
+      const Magnum::MutableImageView2D& view);
+
+  /**
+   * @brief Asynchronous version of @ref readFrameDepth.  See @ref
+   * readFrameRgbaAsync
+   */
+  PendingReadback::ptr readFrameDepthAsync(
+      const Magnum::MutableImageView2D& view);
+
+  /**
+   * @brief Asynchronous version of @ref readFrameObjectId.  See @ref
+   * readFrameRgbaAsync
+   */
+  PendingReadback::ptr readFrameObjectIdAsync(
+      const Magnum::MutableImageView2D& view);
+
   /**
    * @brief Blits the rgba buffer from internal FBO to default frame buffer
    * which in case of EmscriptenApplication will be a canvas element.
@@ -4,6 +4,8 @@
 
 #include "Renderer.h"
 
+#include <algorithm>
+
 #include <Corrade/Containers/StridedArrayView.h>
 #include <Magnum/GL/Buffer.h>
 #include <Magnum/GL/DefaultFramebuffer.h>
@@ -27,6 +29,32 @@ namespace Mn = Magnum;
 namespace esp {
 namespace gfx {
 
+namespace {
+// Collects the drawables of a group with their absolute transformations in a
+// single traversal of the scene graph
+RenderCamera::DrawableTransforms absoluteTransformations(
+    MagnumDrawableGroup& drawables) {
+  RenderCamera::DrawableTransforms drawableTransforms;
+  if (drawables.isEmpty())
+    return drawableTransforms;
+
+  std::vector<std::reference_wrapper<Mn::SceneGraph::AbstractObject3D>>
+      objects;
+  objects.reserve(drawables.size());
+  for (std::size_t i = 0; i != drawables.size(); ++i) {
+    objects.emplace_back(drawables[i].object());
+  }
+  std::vector<Mn::Matrix4> transformations =
+      drawables[0].object().scene()->transformationMatrices(objects);
+
+  drawableTransforms.reserve(drawables.size());
+  for (std::size_t i = 0; i != drawables.size(); ++i) {
+    drawableTransforms.emplace_back(drawables[i], transformations[i]);
+  }
+  return drawableTransforms;
+}
+}  // namespace
+
 struct Renderer::Impl {
   explicit Impl(Flags flags) : depthShader_{nullptr}, flags_{flags} {
     Mn::GL::Renderer::enable(Mn::GL::Renderer::Feature::DepthTest);
@@ -68,6 +96,60 @@ struct Renderer::Impl {
         flags_));
   }
 
+  std::unique_ptr<RenderTarget> createBatchRenderTarget(
+      const Mn::Vector2i& tileSize,
+      int numTiles,
+      const Mn::Vector2& depthUnprojection) {
+    if (!depthShader_) {
+      depthShader_ = std::make_unique<DepthShader>(
+          DepthShader::Flag::UnprojectExistingDepth);
+    }
+
+    return RenderTarget::create_unique(tileSize, numTiles, depthUnprojection,
+                                       depthShader_.get(), flags_);
+  }
+
+  uint32_t drawBatch(RenderTarget& target,
+                     const std::vector<BatchView>& views,
+                     RenderCamera::Flags flags) {
+    if (views.size() > static_cast<std::size_t>(target.numTiles())) {
+      throw std::runtime_error("More views than tiles in the render target");
+    }
+
+    // the tiles of the views of every scene graph, in order of appearance
+    std::vector<std::pair<scene::SceneGraph*, std::vector<int>>> sceneGraphs;
+    for (std::size_t i = 0; i < views.size(); ++i) {
+      auto it = std::find_if(
+          sceneGraphs.begin(), sceneGraphs.end(),
+          [&](const std::pair<scene::SceneGraph*, std::vector<int>>& entry) {
+            return entry.first == views[i].sceneGraph;
+          });
+      if (it == sceneGraphs.end()) {
+        sceneGraphs.emplace_back(views[i].sceneGraph, std::vector<int>{});
+        it = sceneGraphs.end() - 1;
+      }
+      it->second.push_back(i);
+    }
+
+    uint32_t numDrawn = 0;
+    target.renderEnter();
+    for (auto& sceneGraph : sceneGraphs) {
+      for (auto& it : sceneGraph.first->getDrawableGroups()) {
+        const RenderCamera::DrawableTransforms drawableTransforms =
+            absoluteTransformations(it.second);
+        for (int tile : sceneGraph.second) {
+          RenderCamera& camera = *views[tile].camera;
+          it.second.prepareForDraw(camera);
+          target.renderEnterTile(tile);
+          numDrawn += camera.draw(drawableTransforms, flags);
+        }
+      }
+    }
+    target.renderExit();
+
+    return numDrawn;
+  }
+
  private:
   std::unique_ptr<DepthShader> depthShader_;
   const Flags flags_;
@@ -92,5 +174,18 @@ void Renderer::bindRenderTarget(sensor::VisualSensor& sensor) {
   pimpl_->bindRenderTarget(sensor);
 }
 
+std::unique_ptr<RenderTarget> Renderer::createBatchRenderTarget(
+    const Mn::Vector2i& tileSize,
+    int numTiles,
+    const Mn::Vector2& depthUnprojection) {
+  return pimpl_->createBatchRenderTarget(tileSize, numTiles, depthUnprojection);
+}
+
+uint32_t Renderer::drawBatch(RenderTarget& target,
+                             const std::vector<BatchView>& views,
+                             RenderCamera::Flags flags) {
+  return pimpl_->drawBatch(target, views, flags);
+}
+
 }  // namespace gfx
 }  // namespace esp
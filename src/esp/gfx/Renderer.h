@@ -13,6 +13,8 @@
 namespace esp {
 namespace gfx {
 
+class RenderTarget;
+
 class Renderer {
  public:
   enum class Flag {
@@ -22,6 +24,14 @@ class Renderer {
   typedef Corrade::Containers::EnumSet<Flag> Flags;
   CORRADE_ENUMSET_FRIEND_OPERATORS(Flags)
 
+  /**
+   * @brief A camera and the scene graph it views.  See @ref drawBatch
+   */
+  struct BatchView {
+    RenderCamera* camera;
+    scene::SceneGraph* sceneGraph;
+  };
+
   /**
    * @brief Constructor
    */
@@ -42,6 +52,33 @@ class Renderer {
    */
   void bindRenderTarget(sensor::VisualSensor& sensor);
 
+  /**
+   * @brief Creates a batch render target for @ref drawBatch
+   * @param tileSize           The size of the observation of every view in WxH
+   * @param numTiles           The maximum number of views drawn at once
+   * @param depthUnprojection  Depth unprojection parameters shared by all
+   *                           views.  See @ref calculateDepthUnprojection()
+   */
+  std::unique_ptr<RenderTarget> createBatchRenderTarget(
+      const Magnum::Vector2i& tileSize,
+      int numTiles,
+      const Magnum::Vector2& depthUnprojection);
+
+  /**
+   * @brief Draws each view into the tile of the same index of a batch render
+   * target, replacing the previous contents of all tiles
+   *
+   * Views of the same scene graph share a single traversal of it.  The
+   * results of all views are then read at once with the readFrame*
+   * functions of @p target.
+   *
+   * @return The number of drawables drawn over all views
+   */
+  uint32_t drawBatch(
+      RenderTarget& target,
+      const std::vector<BatchView>& views,
+      RenderCamera::Flags flags = {RenderCamera::Flag::FrustumCulling});
+
   ESP_SMART_POINTERS_WITH_UNIQUE_PIMPL(Renderer)
 };
 
@@ -6,17 +6,23 @@
 #define ESP_GFX_SHADERMANAGER_H_
 
 #include <Magnum/GL/AbstractShaderProgram.h>
+#include <Magnum/GL/Buffer.h>
 #include <Magnum/ResourceManager.h>
 
+#include "esp/gfx/LightBuffer.h"
 #include "esp/gfx/LightSetup.h"
 #include "esp/gfx/MaterialData.h"
 
 namespace esp {
 namespace gfx {
 
+// GL buffers hold per-instance data of meshes drawn instanced, light buffers
+// are stored under the key of the light setup they hold
 using ShaderManager = Magnum::ResourceManager<Magnum::GL::AbstractShaderProgram,
                                               gfx::LightSetup,
-                                              gfx::MaterialData>;
+                                              gfx::LightBuffer,
+                                              gfx::MaterialData,
+                                              Magnum::GL::Buffer>;
 
 /**
  * @brief Set the light setup for a subtree
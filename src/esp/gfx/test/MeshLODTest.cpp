@@ -0,0 +1,243 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Magnum/Primitives/Cube.h>
+#include <Magnum/Primitives/Grid.h>
+#include <Magnum/Trade/MeshData.h>
+#include <algorithm>
+
+#include "esp/gfx/MeshLOD.h"
+
+namespace Cr = Corrade;
+namespace Mn = Magnum;
+
+using Mn::Math::Literals::operator""_degf;
+
+namespace esp {
+namespace gfx {
+namespace test {
+namespace {
+
+struct MeshLODTest : Cr::TestSuite::Tester {
+  explicit MeshLODTest();
+
+  void simplifyZeroCellSize();
+  void simplifyGrid();
+  void levels();
+  void levelsTooSmall();
+  void selectPerspective();
+  void selectScaled();
+  void selectOrthographic();
+  void selectNoLevels();
+};
+
+MeshLODTest::MeshLODTest() {
+  addTests({&MeshLODTest::simplifyZeroCellSize, &MeshLODTest::simplifyGrid,
+            &MeshLODTest::levels, &MeshLODTest::levelsTooSmall,
+            &MeshLODTest::selectPerspective, &MeshLODTest::selectScaled,
+            &MeshLODTest::selectOrthographic, &MeshLODTest::selectNoLevels});
+}
+
+// levels of detail of a mesh spanning [-1, 1]^3, no GL mesh needed to select
+MeshLODs cubeLODs() {
+  MeshLODs lods;
+  lods.bounds = {Mn::Vector3{-1.0f}, Mn::Vector3{1.0f}};
+  for (float error : {0.01f, 0.04f, 0.16f}) {
+    lods.levels.push_back(MeshLOD{Mn::GL::Mesh{Mn::NoCreate}, error, 0});
+  }
+  return lods;
+}
+
+void MeshLODTest::simplifyZeroCellSize() {
+  Mn::Trade::MeshData grid = Mn::Primitives::grid3DSolid({3, 3});
+  const Cr::Containers::Array<Mn::Vector3> positions =
+      grid.positions3DAsArray();
+  const Cr::Containers::Array<Mn::UnsignedInt> indices =
+      grid.indicesAsArray();
+
+  float error = -1.0f;
+  const Cr::Containers::Array<Mn::UnsignedInt> simplified =
+      simplifyMesh(positions, indices, 0.0f, error);
+  CORRADE_COMPARE(error, 0.0f);
+  CORRADE_COMPARE_AS(simplified, indices, Cr::TestSuite::Compare::Container);
+}
+
+void MeshLODTest::simplifyGrid() {
+  // 32x32 quads over [-1, 1]^2
+  Mn::Trade::MeshData grid = Mn::Primitives::grid3DSolid({31, 31});
+  const Cr::Containers::Array<Mn::Vector3> positions =
+      grid.positions3DAsArray();
+  const Cr::Containers::Array<Mn::UnsignedInt> indices =
+      grid.indicesAsArray();
+
+  const float cellSize = 0.25f;
+  float error;
+  const Cr::Containers::Array<Mn::UnsignedInt> simplified =
+      simplifyMesh(positions, indices, cellSize, error);
+  CORRADE_COMPARE(simplified.size() % 3, 0);
+  CORRADE_VERIFY(!simplified.empty());
+  // 8x8 cells, so about 8x8 quads are left
+  CORRADE_VERIFY(simplified.size() * 8 < indices.size());
+
+  // vertices move to another vertex of their cell at most
+  CORRADE_VERIFY(error > 0.0f);
+  CORRADE_VERIFY(error <= cellSize * Mn::Constants::sqrt2());
+
+  for (std::size_t i = 0; i < simplified.size(); i += 3) {
+    CORRADE_ITERATION(i / 3);
+    CORRADE_VERIFY(simplified[i] < positions.size());
+    CORRADE_VERIFY(simplified[i + 1] < positions.size());
+    CORRADE_VERIFY(simplified[i + 2] < positions.size());
+    // no degenerate triangles
+    CORRADE_VERIFY(simplified[i] != simplified[i + 1]);
+    CORRADE_VERIFY(simplified[i + 1] != simplified[i + 2]);
+    CORRADE_VERIFY(simplified[i] != simplified[i + 2]);
+  }
+}
+
+void MeshLODTest::levels() {
+  // 64x64 quads, 8192 triangles
+  Mn::Trade::MeshData grid = Mn::Primitives::grid3DSolid(
+      {63, 63},
+      Mn::Primitives::GridFlag::Normals |
+          Mn::Primitives::GridFlag::TextureCoordinates);
+  const std::vector<MeshLODData> levels = simplifyMeshLODs(grid);
+  CORRADE_VERIFY(!levels.empty());
+  CORRADE_VERIFY(levels.size() <= 4);
+
+  Mn::UnsignedInt previousTriangles = grid.indexCount() / 3;
+  float previousError = 0.0f;
+  for (std::size_t i = 0; i < levels.size(); ++i) {
+    CORRADE_ITERATION(i);
+    const Mn::Trade::MeshData& meshData = levels[i].meshData;
+    CORRADE_COMPARE(meshData.primitive(), Mn::MeshPrimitive::Triangles);
+    CORRADE_VERIFY(meshData.isIndexed());
+    const Mn::UnsignedInt numTriangles = meshData.indexCount() / 3;
+    CORRADE_VERIFY(numTriangles > 0);
+    CORRADE_VERIFY(2 * numTriangles <= previousTriangles);
+    CORRADE_VERIFY(levels[i].error >= previousError);
+
+    // only the used vertices are kept, with all their attributes
+    CORRADE_VERIFY(meshData.vertexCount() < grid.vertexCount());
+    CORRADE_COMPARE(meshData.attributeCount(), grid.attributeCount());
+    CORRADE_VERIFY(meshData.hasAttribute(Mn::Trade::MeshAttribute::Normal));
+    CORRADE_VERIFY(
+        meshData.hasAttribute(Mn::Trade::MeshAttribute::TextureCoordinates));
+    const Cr::Containers::Array<Mn::UnsignedInt> indices =
+        meshData.indicesAsArray();
+    CORRADE_COMPARE(*std::max_element(indices.begin(), indices.end()) + 1,
+                    meshData.vertexCount());
+
+    previousTriangles = numTriangles;
+    previousError = levels[i].error;
+  }
+}
+
+void MeshLODTest::levelsTooSmall() {
+  CORRADE_VERIFY(simplifyMeshLODs(Mn::Primitives::cubeSolid()).empty());
+  // not indexed
+  CORRADE_VERIFY(simplifyMeshLODs(Mn::Primitives::cubeSolidStrip()).empty());
+}
+
+void MeshLODTest::selectPerspective() {
+  const MeshLODs lods = cubeLODs();
+  const Mn::Matrix4 projection =
+      Mn::Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.01f, 100.0f);
+  const Mn::Vector2i viewport{100, 100};
+
+  // the camera is inside the bounding sphere
+  CORRADE_COMPARE(
+      selectMeshLOD(lods, Mn::Matrix4::translation(Mn::Vector3::zAxis(-1.0f)),
+                    projection, viewport),
+      -1);
+  // close enough for no level to be precise enough
+  CORRADE_COMPARE(
+      selectMeshLOD(lods, Mn::Matrix4::translation(Mn::Vector3::zAxis(-2.5f)),
+                    projection, viewport),
+      -1);
+  // about 68 pixels per unit, so 0.68 pixels for the finest level
+  CORRADE_COMPARE(
+      selectMeshLOD(lods, Mn::Matrix4::translation(Mn::Vector3::zAxis(-3.0f)),
+                    projection, viewport),
+      0);
+  // about 10 pixels per unit
+  CORRADE_COMPARE(
+      selectMeshLOD(lods, Mn::Matrix4::translation(Mn::Vector3::zAxis(-10.0f)),
+                    projection, viewport),
+      1);
+  CORRADE_COMPARE(
+      selectMeshLOD(lods,
+                    Mn::Matrix4::translation(Mn::Vector3::zAxis(-100.0f)),
+                    projection, viewport),
+      2);
+
+  // a larger viewport or tolerance changes the selection
+  CORRADE_COMPARE(
+      selectMeshLOD(lods, Mn::Matrix4::translation(Mn::Vector3::zAxis(-10.0f)),
+                    projection, {400, 400}),
+      0);
+  CORRADE_COMPARE(
+      selectMeshLOD(lods, Mn::Matrix4::translation(Mn::Vector3::zAxis(-10.0f)),
+                    projection, viewport, 2.0f),
+      2);
+}
+
+void MeshLODTest::selectScaled() {
+  const MeshLODs lods = cubeLODs();
+  const Mn::Matrix4 projection =
+      Mn::Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.01f, 100.0f);
+
+  // the errors scale with the mesh, 0.36 pixels for the coarsest level
+  CORRADE_COMPARE(
+      selectMeshLOD(lods,
+                    Mn::Matrix4::translation(Mn::Vector3::zAxis(-10.0f)) *
+                        Mn::Matrix4::scaling(Mn::Vector3{0.25f}),
+                    projection, {100, 100}),
+      2);
+  // and so does the bounding sphere, the camera is not inside anymore
+  CORRADE_COMPARE(
+      selectMeshLOD(lods,
+                    Mn::Matrix4::translation(Mn::Vector3::zAxis(-1.0f)) *
+                        Mn::Matrix4::scaling(Mn::Vector3{0.25f}),
+                    projection, {100, 100}),
+      0);
+}
+
+void MeshLODTest::selectOrthographic() {
+  const MeshLODs lods = cubeLODs();
+  // 10 pixels per unit at any distance
+  const Mn::Matrix4 projection =
+      Mn::Matrix4::orthographicProjection({10.0f, 10.0f}, 0.01f, 100.0f);
+
+  CORRADE_COMPARE(
+      selectMeshLOD(lods, Mn::Matrix4::translation(Mn::Vector3::zAxis(-1.0f)),
+                    projection, {100, 100}),
+      1);
+  CORRADE_COMPARE(
+      selectMeshLOD(lods, Mn::Matrix4::translation(Mn::Vector3::zAxis(-50.0f)),
+                    projection, {100, 100}),
+      1);
+}
+
+void MeshLODTest::selectNoLevels() {
+  MeshLODs lods;
+  lods.bounds = {Mn::Vector3{-1.0f}, Mn::Vector3{1.0f}};
+  CORRADE_COMPARE(
+      selectMeshLOD(lods,
+                    Mn::Matrix4::translation(Mn::Vector3::zAxis(-100.0f)),
+                    Mn::Matrix4::perspectiveProjection(60.0_degf, 1.0f, 0.01f,
+                                                       100.0f),
+                    {100, 100}),
+      -1);
+}
+
+}  // namespace
+}  // namespace test
+}  // namespace gfx
+}  // namespace esp
+
+CORRADE_TEST_MAIN(esp::gfx::test::MeshLODTest)
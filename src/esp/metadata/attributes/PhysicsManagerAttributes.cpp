@@ -13,6 +13,9 @@ PhysicsManagerAttributes::PhysicsManagerAttributes(const std::string& handle)
   setSimulator("none");
   setTimestep(0.01);
   setMaxSubsteps(10);
+  setStageBvhCacheDirectory("");
+  setMultithreaded(false);
+  setNumThreads(0);
 }  // PhysicsManagerAttributes ctor
 
 }  // namespace attributes
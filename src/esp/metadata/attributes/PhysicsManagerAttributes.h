@@ -46,6 +46,34 @@ class PhysicsManagerAttributes : public AbstractAttributes {
     return getDouble("restitution_coefficient");
   }
 
+  /**
+   * @brief Directory where the bounding volume hierarchies of the stage
+   * collision meshes are cached between loads. Empty to always build them.
+   */
+  void setStageBvhCacheDirectory(const std::string& stageBvhCacheDirectory) {
+    setString("stage_bvh_cache_directory", stageBvhCacheDirectory);
+  }
+  std::string getStageBvhCacheDirectory() const {
+    return getString("stage_bvh_cache_directory");
+  }
+
+  /**
+   * @brief Whether to step the simulation with Bullet's multithreaded dynamics
+   * world. Requires Bullet built with BULLET2_MULTITHREADING, the world is
+   * single-threaded otherwise.
+   */
+  void setMultithreaded(bool multithreaded) {
+    setBool("multithreaded", multithreaded);
+  }
+  bool getMultithreaded() const { return getBool("multithreaded"); }
+
+  /**
+   * @brief The number of threads of the multithreaded dynamics world. 0 to
+   * use one per hardware thread.
+   */
+  void setNumThreads(int numThreads) { setInt("num_threads", numThreads); }
+  int getNumThreads() const { return getInt("num_threads"); }
+
  public:
   ESP_SMART_POINTERS(PhysicsManagerAttributes)
 };  // class PhysicsManagerAttributes
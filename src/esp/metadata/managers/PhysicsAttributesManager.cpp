@@ -75,6 +75,25 @@ void PhysicsAttributesManager::setValsFromJSONDoc(
         physicsManagerAttributes->setGravity(gravity);
       });
 
+  // load the directory of the cached stage bounding volume hierarchies
+  io::jsonIntoConstSetter<std::string>(
+      jsonConfig, "stage_bvh_cache_directory",
+      [physicsManagerAttributes](const std::string& stageBvhCacheDirectory) {
+        physicsManagerAttributes->setStageBvhCacheDirectory(
+            stageBvhCacheDirectory);
+      });
+
+  // load whether to use the multithreaded world, and its number of threads
+  io::jsonIntoSetter<bool>(jsonConfig, "multithreaded",
+                           [physicsManagerAttributes](bool multithreaded) {
+                             physicsManagerAttributes->setMultithreaded(
+                                 multithreaded);
+                           });
+  io::jsonIntoSetter<int>(
+      jsonConfig, "num_threads", [physicsManagerAttributes](int numThreads) {
+        physicsManagerAttributes->setNumThreads(numThreads);
+      });
+
 }  // PhysicsAttributesManager::createFileBasedAttributesTemplate
 
 }  // namespace managers
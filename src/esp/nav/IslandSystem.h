@@ -0,0 +1,419 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_NAV_ISLANDSYSTEM_H_
+#define ESP_NAV_ISLANDSYSTEM_H_
+
+// Internal to the nav library and its tests, needs the Detour headers
+
+#include <algorithm>
+#include <numeric>
+#include <stack>
+#include <vector>
+
+#include "esp/core/esp.h"
+
+#include "DetourNavMesh.h"
+#include "DetourNavMeshQuery.h"
+
+namespace esp {
+namespace nav {
+namespace impl {
+
+// Runs connected component analysis on the navmesh to figure out which polygons
+// are connected This gives O(1) lookup for if a path between two polygons
+// exists or not
+// Takes O(npolys) to construct
+//
+// Islands are stored in flat per-tile arrays indexed by the tile and polygon
+// indices encoded in a dtPolyRef, so a lookup is a decode and two loads.
+// Polygons that do not pass the filter are never connected to anything and
+// each form an island of their own.
+class IslandSystem {
+ public:
+  //! Island of a polygon that is not part of any
+  static constexpr uint32_t NO_ISLAND = ~0u;
+
+  IslandSystem(const dtNavMesh* navMesh, const dtQueryFilter* filter)
+      : navMesh_{navMesh} {
+    const int maxTiles = navMesh->getMaxTiles();
+    tiles_.resize(maxTiles);
+
+    // Label the components within each tile in parallel, links to other
+    // tiles are joined below
+    std::vector<uint32_t> numTileComponents(maxTiles, 0);
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int iTile = 0; iTile < maxTiles; ++iTile) {
+      const dtMeshTile* tile = navMesh->getTile(iTile);
+      if (!tile || !tile->header)
+        continue;
+
+      TileIslands& tileIslands = tiles_[iTile];
+      tileIslands.salt = tile->salt;
+      tileIslands.islands.assign(tile->header->polyCount, NO_ISLAND);
+
+      const dtPolyRef base = navMesh->getPolyRefBase(tile);
+      std::vector<int> stack;
+      uint32_t numComponents = 0;
+      for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
+        if (tileIslands.islands[jPoly] != NO_ISLAND)
+          continue;
+
+        const uint32_t component = numComponents++;
+        tileIslands.islands[jPoly] = component;
+        if (!passFilter(filter, base | static_cast<dtPolyRef>(jPoly)))
+          continue;
+
+        stack.push_back(jPoly);
+        while (!stack.empty()) {
+          const dtPoly& poly = tile->polys[stack.back()];
+          stack.pop_back();
+
+          for (unsigned int iLink = poly.firstLink; iLink != DT_NULL_LINK;
+               iLink = tile->links[iLink].next) {
+            const dtPolyRef neighbourRef = tile->links[iLink].ref;
+            if (navMesh->decodePolyIdTile(neighbourRef) !=
+                static_cast<unsigned int>(iTile))
+              continue;
+
+            const unsigned int neighbour =
+                navMesh->decodePolyIdPoly(neighbourRef);
+            if (tileIslands.islands[neighbour] != NO_ISLAND ||
+                !passFilter(filter, neighbourRef))
+              continue;
+
+            tileIslands.islands[neighbour] = component;
+            stack.push_back(neighbour);
+          }
+        }
+      }
+      numTileComponents[iTile] = numComponents;
+    }
+
+    // Join the components of neighbouring tiles with a union-find over all
+    // of them
+    std::vector<uint32_t> componentBase(maxTiles + 1, 0);
+    std::partial_sum(numTileComponents.begin(), numTileComponents.end(),
+                     componentBase.begin() + 1);
+    std::vector<uint32_t> parent(componentBase.back());
+    std::iota(parent.begin(), parent.end(), 0);
+    const auto find = [&parent](uint32_t c) {
+      while (parent[c] != c) {
+        parent[c] = parent[parent[c]];
+        c = parent[c];
+      }
+      return c;
+    };
+
+    for (int iTile = 0; iTile < maxTiles; ++iTile) {
+      const dtMeshTile* tile = navMesh->getTile(iTile);
+      if (!tile || !tile->header)
+        continue;
+
+      const dtPolyRef base = navMesh->getPolyRefBase(tile);
+      for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
+        if (!passFilter(filter, base | static_cast<dtPolyRef>(jPoly)))
+          continue;
+
+        const dtPoly& poly = tile->polys[jPoly];
+        for (unsigned int iLink = poly.firstLink; iLink != DT_NULL_LINK;
+             iLink = tile->links[iLink].next) {
+          const dtPolyRef neighbourRef = tile->links[iLink].ref;
+          const unsigned int neighbourTile =
+              navMesh->decodePolyIdTile(neighbourRef);
+          if (neighbourTile == static_cast<unsigned int>(iTile) ||
+              !passFilter(filter, neighbourRef))
+            continue;
+
+          const uint32_t a =
+              find(componentBase[iTile] + tiles_[iTile].islands[jPoly]);
+          const uint32_t b = find(
+              componentBase[neighbourTile] +
+              tiles_[neighbourTile]
+                  .islands[navMesh->decodePolyIdPoly(neighbourRef)]);
+          parent[std::max(a, b)] = std::min(a, b);
+        }
+      }
+    }
+
+    // Number the joined components consecutively
+    std::vector<uint32_t> componentIsland(parent.size());
+    uint32_t numIslands = 0;
+    for (uint32_t c = 0; c < parent.size(); ++c) {
+      const uint32_t root = find(c);
+      componentIsland[c] = root == c ? numIslands++ : componentIsland[root];
+    }
+
+#pragma omp parallel for schedule(dynamic, 1)
+    for (int iTile = 0; iTile < maxTiles; ++iTile) {
+      for (uint32_t& island : tiles_[iTile].islands) {
+        island = componentIsland[componentBase[iTile] + island];
+      }
+    }
+
+    // The radius is calculated as the max deviation from the mean of the
+    // vertices of all polygons of the island
+    std::vector<Eigen::Vector3d> vertSums(numIslands, Eigen::Vector3d::Zero());
+    std::vector<uint32_t> vertCounts(numIslands, 0);
+    forEachPolyVert([&](uint32_t island, const vec3f& v) {
+      vertSums[island] += v.cast<double>();
+      ++vertCounts[island];
+    });
+
+    std::vector<vec3f> centroids(numIslands);
+    for (uint32_t iIsland = 0; iIsland < numIslands; ++iIsland) {
+      centroids[iIsland] =
+          (vertSums[iIsland] / vertCounts[iIsland]).cast<float>();
+    }
+
+    islandRadius_.assign(numIslands, 0.0f);
+    forEachPolyVert([&](uint32_t island, const vec3f& v) {
+      islandRadius_[island] =
+          std::max(islandRadius_[island], (v - centroids[island]).norm());
+    });
+  }
+
+  // Restores islands saved with islandOf and islandRadii
+  IslandSystem(const dtNavMesh* navMesh, std::vector<float> islandRadius)
+      : navMesh_{navMesh},
+        tiles_(navMesh->getMaxTiles()),
+        islandRadius_(std::move(islandRadius)) {}
+
+  inline uint32_t islandOf(dtPolyRef ref) const {
+    unsigned int salt = 0, iTile = 0, iPoly = 0;
+    navMesh_->decodePolyId(ref, salt, iTile, iPoly);
+    if (iTile >= tiles_.size())
+      return NO_ISLAND;
+
+    // A stale ref of a tile that was since replaced is not on any island
+    const TileIslands& tileIslands = tiles_[iTile];
+    if (tileIslands.salt != salt || iPoly >= tileIslands.islands.size())
+      return NO_ISLAND;
+
+    return tileIslands.islands[iPoly];
+  }
+
+  void setIsland(dtPolyRef ref, uint32_t island) {
+    unsigned int salt = 0, iTile = 0, iPoly = 0;
+    navMesh_->decodePolyId(ref, salt, iTile, iPoly);
+    TileIslands& tileIslands = tiles_[iTile];
+    if (tileIslands.salt != salt || tileIslands.islands.empty()) {
+      const dtMeshTile* tile = navMesh_->getTile(iTile);
+      tileIslands.salt = salt;
+      tileIslands.islands.assign(tile->header->polyCount, NO_ISLAND);
+    }
+    tileIslands.islands[iPoly] = island;
+  }
+
+  const std::vector<float>& islandRadii() const { return islandRadius_; }
+
+  inline bool hasConnection(dtPolyRef startRef, dtPolyRef endRef) const {
+    // If both polygons are on the same island, there must be a path between
+    // them
+    const uint32_t startIsland = islandOf(startRef);
+    if (startIsland == NO_ISLAND)
+      return false;
+
+    return startIsland == islandOf(endRef);
+  }
+
+  inline float islandRadius(dtPolyRef ref) const {
+    const uint32_t island = islandOf(ref);
+    if (island == NO_ISLAND)
+      return 0.0;
+
+    return islandRadius_[island];
+  }
+
+  // Updates the islands after some tiles of the navmesh were replaced.
+  // removedRefs are the polygons of the tiles before they were removed and
+  // addedTiles are the tiles that replaced them. Only the islands that touch
+  // either are recomputed, all others are left untouched.
+  void updateTiles(const dtQueryFilter* filter,
+                   const std::vector<dtPolyRef>& removedRefs,
+                   const std::vector<const dtMeshTile*>& addedTiles) {
+    std::vector<char> affected(islandRadius_.size(), false);
+    const auto markAffected = [&](dtPolyRef ref) {
+      const uint32_t island = islandOf(ref);
+      if (island != NO_ISLAND)
+        affected[island] = true;
+    };
+
+    // Islands that went through the removed tiles may have been split
+    for (dtPolyRef ref : removedRefs) {
+      markAffected(ref);
+    }
+
+    // Islands that now link into the added tiles may have been merged
+    std::vector<dtPolyRef> seeds;
+    for (const dtMeshTile* tile : addedTiles) {
+      const dtPolyRef base = navMesh_->getPolyRefBase(tile);
+      for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
+        seeds.emplace_back(base | static_cast<dtPolyRef>(jPoly));
+
+        const dtPoly& poly = tile->polys[jPoly];
+        for (unsigned int iLink = poly.firstLink; iLink != DT_NULL_LINK;
+             iLink = tile->links[iLink].next) {
+          markAffected(tile->links[iLink].ref);
+        }
+      }
+    }
+
+    // Drop the affected islands, remembering their polygons that still exist,
+    // and forget about tiles that are gone or were replaced
+    for (int iTile = 0; iTile < navMesh_->getMaxTiles(); ++iTile) {
+      TileIslands& tileIslands = tiles_[iTile];
+      const dtMeshTile* tile = navMesh_->getTile(iTile);
+      if (!tile || !tile->header || tile->salt != tileIslands.salt) {
+        tileIslands.islands.clear();
+        continue;
+      }
+
+      const dtPolyRef base = navMesh_->getPolyRefBase(tile);
+      for (size_t jPoly = 0; jPoly < tileIslands.islands.size(); ++jPoly) {
+        uint32_t& island = tileIslands.islands[jPoly];
+        if (island == NO_ISLAND || !affected[island])
+          continue;
+
+        seeds.emplace_back(base | static_cast<dtPolyRef>(jPoly));
+        island = NO_ISLAND;
+      }
+    }
+    for (uint32_t iIsland = 0; iIsland < affected.size(); ++iIsland) {
+      if (affected[iIsland])
+        freeIslandIds_.emplace_back(iIsland);
+    }
+
+    // And recompute the islands of everything that was dropped or added
+    std::vector<vec3f> islandVerts;
+    for (dtPolyRef ref : seeds) {
+      if (islandOf(ref) == NO_ISLAND)
+        addIsland(filter, ref, islandVerts);
+    }
+  }
+
+ private:
+  struct TileIslands {
+    //! Salt of the tile the islands were computed for
+    unsigned int salt = 0;
+    //! Island of each polygon of the tile
+    std::vector<uint32_t> islands;
+  };
+
+  const dtNavMesh* navMesh_;
+  //! Indexed by tile index
+  std::vector<TileIslands> tiles_;
+  std::vector<float> islandRadius_;
+  //! Ids of islands dropped by updateTiles, reused before adding new ones
+  std::vector<uint32_t> freeIslandIds_;
+
+  bool passFilter(const dtQueryFilter* filter, dtPolyRef ref) const {
+    const dtMeshTile* tile = nullptr;
+    const dtPoly* poly = nullptr;
+    navMesh_->getTileAndPolyByRefUnsafe(ref, &tile, &poly);
+    return filter->passFilter(ref, tile, poly);
+  }
+
+  // Calls f(island, vertex) for every vertex of every polygon
+  template <typename F>
+  void forEachPolyVert(F&& f) const {
+    for (int iTile = 0; iTile < navMesh_->getMaxTiles(); ++iTile) {
+      const dtMeshTile* tile = navMesh_->getTile(iTile);
+      if (!tile || !tile->header)
+        continue;
+
+      for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
+        const dtPoly& poly = tile->polys[jPoly];
+        for (int iVert = 0; iVert < poly.vertCount; ++iVert) {
+          f(tiles_[iTile].islands[jPoly],
+            Eigen::Map<const vec3f>(&tile->verts[poly.verts[iVert] * 3]));
+        }
+      }
+    }
+  }
+
+  void addIsland(const dtQueryFilter* filter,
+                 const dtPolyRef& startRef,
+                 std::vector<vec3f>& islandVerts) {
+    uint32_t newIslandId = islandRadius_.size();
+    if (!freeIslandIds_.empty()) {
+      newIslandId = freeIslandIds_.back();
+      freeIslandIds_.pop_back();
+    } else {
+      islandRadius_.emplace_back(0.0f);
+    }
+    expandFrom(filter, newIslandId, startRef, islandVerts);
+
+    // The radius is calculated as the max deviation from the mean for all
+    // points in the island
+    vec3f centroid = vec3f::Zero();
+    for (auto& v : islandVerts) {
+      centroid += v;
+    }
+    centroid /= islandVerts.size();
+
+    float maxRadius = 0.0;
+    for (auto& v : islandVerts) {
+      maxRadius = std::max(maxRadius, (v - centroid).norm());
+    }
+
+    islandRadius_[newIslandId] = maxRadius;
+  }
+
+  void expandFrom(const dtQueryFilter* filter,
+                  const uint32_t newIslandId,
+                  const dtPolyRef& startRef,
+                  std::vector<vec3f>& islandVerts) {
+    setIsland(startRef, newIslandId);
+    islandVerts.clear();
+
+    // Force std::stack to be implemented via an std::vector as linked
+    // lists are gross
+    std::stack<dtPolyRef, std::vector<dtPolyRef>> stack;
+
+    // Polygons that aren't walkable are islands of their own
+    const bool walkable = passFilter(filter, startRef);
+
+    // Add the start ref to the stack
+    stack.push(startRef);
+    while (!stack.empty()) {
+      dtPolyRef ref = stack.top();
+      stack.pop();
+
+      const dtMeshTile* tile = nullptr;
+      const dtPoly* poly = nullptr;
+      navMesh_->getTileAndPolyByRefUnsafe(ref, &tile, &poly);
+
+      for (int iVert = 0; iVert < poly->vertCount; ++iVert) {
+        islandVerts.emplace_back(
+            Eigen::Map<vec3f>(&tile->verts[poly->verts[iVert] * 3]));
+      }
+
+      if (!walkable)
+        continue;
+
+      // Iterate over all neighbours
+      for (unsigned int iLink = poly->firstLink; iLink != DT_NULL_LINK;
+           iLink = tile->links[iLink].next) {
+        dtPolyRef neighbourRef = tile->links[iLink].ref;
+        // If we've already visited this poly, skip it!
+        if (islandOf(neighbourRef) != NO_ISLAND)
+          continue;
+
+        // If a neighbour isn't walkable, don't add it
+        if (!passFilter(filter, neighbourRef))
+          continue;
+
+        setIsland(neighbourRef, newIslandId);
+        stack.push(neighbourRef);
+      }
+    }
+  }
+};
+
+}  // namespace impl
+}  // namespace nav
+}  // namespace esp
+
+#endif  // ESP_NAV_ISLANDSYSTEM_H_
@@ -3,8 +3,10 @@
 // LICENSE file in the root directory of this source tree.
 
 #include "PathFinder.h"
+#include "IslandSystem.h"
+#include <algorithm>
 #include <numeric>
-#include <stack>
+#include <queue>
 #include <unordered_map>
 
 #include <Magnum/Magnum.h>
@@ -15,6 +17,17 @@
 
 #include <Corrade/Containers/Optional.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include <cstdio>
 #define _USE_MATH_DEFINES
 #include <cmath>
@@ -22,11 +35,14 @@
 
 #include "esp/assets/MeshData.h"
 #include "esp/core/esp.h"
+#include "esp/core/random.h"
 
+#include "DetourCommon.h"
 #include "DetourNavMesh.h"
 #include "DetourNavMeshBuilder.h"
 #include "DetourNavMeshQuery.h"
 #include "DetourNode.h"
+#include "DetourPathCorridor.h"
 #include "Recast.h"
 
 namespace Mn = Magnum;
@@ -61,6 +77,26 @@ const std::vector<vec3f>& MultiGoalShortestPath::getRequestedEnds() const {
   return pimpl_->requestedEnds;
 }
 
+struct PathCorridor::Impl {
+  dtPathCorridor corridor;
+  //! Number of polygons the corridor was initialized to hold
+  int capacity = 0;
+  //! The corridor is only valid for the navmesh it was found on
+  const void* owner = nullptr;
+  uint64_t navMeshVersion = 0;
+  bool valid = false;
+
+  std::vector<vec3f> corners;
+  std::vector<unsigned char> cornerFlags;
+  std::vector<dtPolyRef> cornerPolys;
+};
+
+PathCorridor::PathCorridor() : pimpl_{spimpl::make_unique_impl<Impl>()} {};
+
+void PathCorridor::reset() {
+  pimpl_->valid = false;
+}
+
 namespace {
 template <typename T>
 std::tuple<dtStatus, dtPolyRef, vec3f> projectToPoly(
@@ -84,132 +120,545 @@ std::tuple<dtStatus, dtPolyRef, vec3f> projectToPoly(
 
   return std::make_tuple(status, polyRef, polyXYZ);
 }
+
+// Upper bound on the number of worker threads available for batched queries
+int maxWorkers() {
+#ifdef _OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+// Index of the calling worker thread inside a parallel region
+int workerIndex() {
+#ifdef _OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif
+}
 }  // namespace
 
 namespace impl {
 
-// Runs connected component analysis on the navmesh to figure out which polygons
-// are connected This gives O(1) lookup for if a path between two polygons
-// exists or not
-// Takes O(npolys) to construct
-class IslandSystem {
+constexpr uint32_t IslandSystem::NO_ISLAND;
+
+// Precomputed geodesic distance fields to a set of registered goals.
+// The fields are computed with Dijkstra over a graph of points on the navmesh
+// polygon boundaries: the polygon vertices and the end points of the portals
+// between polygons of neighbouring tiles, which do not share vertices. All
+// points on the boundary of a (convex) polygon are connected to each other by
+// straight lines within it. Querying a point then only needs the polygon the
+// point is on and a min over that polygon's graph points.
+//
+// A graph path zig-zags between polygon boundaries where the shortest path
+// crosses several polygons in a straight line, most visibly around the start
+// and the goal. Queries therefore follow the graph path recorded for the goal
+// and pull it taut: from each corner, they go straight to the farthest point
+// further down the path that a navmesh raycast reaches. Every segment is a
+// graph edge or a straight line on the navmesh, so the distances are upper
+// bounds of the true geodesic distance. PathFinderTest checks each of them
+// against the one found by findPath().
+class DistanceOracle {
  public:
-  IslandSystem(const dtNavMesh* navMesh, const dtQueryFilter* filter) {
-    std::vector<vec3f> islandVerts;
+  DistanceOracle(const dtNavMesh* navMesh, const dtQueryFilter* filter)
+      : navMeshHash_{computeNavMeshHash(navMesh)} {
+    // Number the vertices and the polygons of all tiles consecutively
+    tileVertBase_.assign(navMesh->getMaxTiles(), 0);
+    tilePolyBase_.assign(navMesh->getMaxTiles(), 0);
+    uint32_t numPolys = 0;
+    for (int iTile = 0; iTile < navMesh->getMaxTiles(); ++iTile) {
+      const dtMeshTile* tile = navMesh->getTile(iTile);
+      tileVertBase_[iTile] = nodePositions_.size();
+      tilePolyBase_[iTile] = numPolys;
+      if (!tile || !tile->header)
+        continue;
+      for (int jVert = 0; jVert < tile->header->vertCount; ++jVert) {
+        nodePositions_.emplace_back(vertPosition(tile, jVert));
+      }
+      numPolys += tile->header->polyCount;
+    }
 
-    // Iterate over all tiles
+    // The graph points on the boundary of each polygon
+    std::vector<std::vector<uint32_t>> polyNodes(numPolys);
+    std::vector<dtPolyRef> polyRefs(numPolys, 0);
     for (int iTile = 0; iTile < navMesh->getMaxTiles(); ++iTile) {
       const dtMeshTile* tile = navMesh->getTile(iTile);
-      if (!tile)
+      if (!tile || !tile->header)
         continue;
 
-      // Iterate over all polygons in a tile
+      const dtPolyRef base = navMesh->getPolyRefBase(tile);
       for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
-        // Get the polygon reference from the tile and polygon id
-        dtPolyRef startRef = navMesh->encodePolyId(tile->salt, iTile, jPoly);
-
-        // If the polygon ref is valid, and we haven't seen it yet,
-        // start connected component analysis from this polygon
-        if (navMesh->isValidPolyRef(startRef) &&
-            (polyToIsland_.find(startRef) == polyToIsland_.end())) {
-          uint32_t newIslandId = islandRadius_.size();
-          expandFrom(navMesh, filter, newIslandId, startRef, islandVerts);
-
-          // The radius is calculated as the max deviation from the mean for all
-          // points in the island
-          vec3f centroid = vec3f::Zero();
-          for (auto& v : islandVerts) {
-            centroid += v;
-          }
-          centroid /= islandVerts.size();
+        const dtPolyRef ref = base | static_cast<dtPolyRef>(jPoly);
+        const dtPoly* poly = &tile->polys[jPoly];
+        if (!filter->passFilter(ref, tile, poly))
+          continue;
+
+        polyRefs[polyIndex(navMesh, ref)] = ref;
+        std::vector<uint32_t>& nodes = polyNodes[polyIndex(navMesh, ref)];
+        for (int a = 0; a < poly->vertCount; ++a) {
+          nodes.emplace_back(nodeIndex(navMesh, tile, poly->verts[a]));
+        }
 
-          float maxRadius = 0.0;
-          for (auto& v : islandVerts) {
-            maxRadius = std::max(maxRadius, (v - centroid).norm());
+        // Polygons in neighbouring tiles do not share vertices, add the end
+        // points of the portal between them to both. Each portal is linked
+        // from both sides, only add it from the one with the smaller ref.
+        for (unsigned int iLink = poly->firstLink; iLink != DT_NULL_LINK;
+             iLink = tile->links[iLink].next) {
+          const dtLink& link = tile->links[iLink];
+          if (link.side == 0xff || link.ref < ref)
+            continue;
+
+          const dtMeshTile* neighbourTile = nullptr;
+          const dtPoly* neighbourPoly = nullptr;
+          navMesh->getTileAndPolyByRefUnsafe(link.ref, &neighbourTile,
+                                             &neighbourPoly);
+          if (!filter->passFilter(link.ref, neighbourTile, neighbourPoly))
+            continue;
+
+          // Same as dtNavMeshQuery::getPortalPoints()
+          const vec3f v0 = vertPosition(tile, poly->verts[link.edge]);
+          const vec3f v1 = vertPosition(
+              tile, poly->verts[(link.edge + 1) % poly->vertCount]);
+          const float s = 1.0f / 255.0f;
+          std::vector<uint32_t>& neighbourNodes =
+              polyNodes[polyIndex(navMesh, link.ref)];
+          for (const float t : {link.bmin * s, link.bmax * s}) {
+            const uint32_t node = nodePositions_.size();
+            nodePositions_.emplace_back(v0 + t * (v1 - v0));
+            nodes.emplace_back(node);
+            neighbourNodes.emplace_back(node);
           }
+        }
+      }
+    }
 
-          islandRadius_.emplace_back(maxRadius);
+    std::vector<std::vector<std::pair<uint32_t, float>>> adjacency(numNodes());
+    for (const std::vector<uint32_t>& nodes : polyNodes) {
+      for (std::size_t a = 0; a < nodes.size(); ++a) {
+        for (std::size_t b = a + 1; b < nodes.size(); ++b) {
+          const float d =
+              (nodePositions_[nodes[a]] - nodePositions_[nodes[b]]).norm();
+          adjacency[nodes[a]].emplace_back(nodes[b], d);
+          adjacency[nodes[b]].emplace_back(nodes[a], d);
         }
       }
     }
+
+    // Flatten into compressed sparse rows for cache friendly traversal
+    adjOffsets_.reserve(numNodes() + 1);
+    adjOffsets_.emplace_back(0);
+    for (const auto& neighbours : adjacency) {
+      for (const auto& neighbour : neighbours) {
+        adjNodes_.emplace_back(neighbour.first);
+        adjDists_.emplace_back(neighbour.second);
+      }
+      adjOffsets_.emplace_back(adjNodes_.size());
+    }
+    polyNodeOffsets_.reserve(numPolys + 1);
+    polyNodeOffsets_.emplace_back(0);
+    for (const std::vector<uint32_t>& nodes : polyNodes) {
+      polyNodes_.insert(polyNodes_.end(), nodes.begin(), nodes.end());
+      polyNodeOffsets_.emplace_back(polyNodes_.size());
+    }
+
+    // And the inverse, which polygons raycasts from each graph point start on
+    std::vector<std::vector<dtPolyRef>> nodePolys(numNodes());
+    for (std::size_t iPoly = 0; iPoly < polyNodes.size(); ++iPoly) {
+      for (const uint32_t node : polyNodes[iPoly]) {
+        nodePolys[node].emplace_back(polyRefs[iPoly]);
+      }
+    }
+    nodePolyOffsets_.reserve(numNodes() + 1);
+    nodePolyOffsets_.emplace_back(0);
+    for (const std::vector<dtPolyRef>& refs : nodePolys) {
+      nodePolys_.insert(nodePolys_.end(), refs.begin(), refs.end());
+      nodePolyOffsets_.emplace_back(nodePolys_.size());
+    }
   }
 
-  inline bool hasConnection(dtPolyRef startRef, dtPolyRef endRef) const {
-    // If both polygons are on the same island, there must be a path between
-    // them
-    auto itStart = polyToIsland_.find(startRef);
-    if (itStart == polyToIsland_.end())
-      return false;
+  int numGoals() const { return goals_.size(); }
+
+  uint32_t numNodes() const { return nodePositions_.size(); }
+
+  int addGoal(const dtNavMesh* navMesh, dtPolyRef goalRef, const vec3f& goal) {
+    Goal newGoal;
+    newGoal.point = goal;
+    newGoal.ref = goalRef;
+    newGoal.dist.assign(numNodes(), std::numeric_limits<float>::infinity());
+    newGoal.next.assign(numNodes(), NO_NODE);
+
+    using Entry = std::pair<float, uint32_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+
+    // The goal sees all graph points of its polygon
+    const uint32_t goalPoly = polyIndex(navMesh, goalRef);
+    for (uint32_t iNode = polyNodeOffsets_[goalPoly];
+         iNode < polyNodeOffsets_[goalPoly + 1]; ++iNode) {
+      const uint32_t node = polyNodes_[iNode];
+      const float d = (goal - nodePositions_[node]).norm();
+      if (d < newGoal.dist[node]) {
+        newGoal.dist[node] = d;
+        queue.emplace(d, node);
+      }
+    }
 
-    auto itEnd = polyToIsland_.find(endRef);
-    if (itEnd == polyToIsland_.end())
-      return false;
+    while (!queue.empty()) {
+      const Entry top = queue.top();
+      queue.pop();
+      if (top.first > newGoal.dist[top.second])
+        continue;
+
+      for (uint32_t iAdj = adjOffsets_[top.second];
+           iAdj < adjOffsets_[top.second + 1]; ++iAdj) {
+        const float d = top.first + adjDists_[iAdj];
+        if (d < newGoal.dist[adjNodes_[iAdj]]) {
+          newGoal.dist[adjNodes_[iAdj]] = d;
+          newGoal.next[adjNodes_[iAdj]] = top.second;
+          queue.emplace(d, adjNodes_[iAdj]);
+        }
+      }
+    }
 
-    return itStart->second == itEnd->second;
+    goals_.emplace_back(std::move(newGoal));
+    return goals_.size() - 1;
   }
 
-  inline float islandRadius(dtPolyRef ref) const {
-    auto itRef = polyToIsland_.find(ref);
-    if (itRef == polyToIsland_.end())
-      return 0.0;
+  // Distance to a goal from pt, which lies on the polygon ref
+  float distance(const dtNavMesh* navMesh,
+                 const dtNavMeshQuery* navQuery,
+                 const dtQueryFilter* filter,
+                 dtPolyRef ref,
+                 const vec3f& pt,
+                 int goalId) const {
+    const Goal& goal = goals_[goalId];
+    // Polygons are convex, so there is a straight line between the two
+    if (ref == goal.ref || isVisible(navQuery, filter, &ref, 1, pt, goal.point))
+      return (pt - goal.point).norm();
+
+    const uint32_t startPoly = polyIndex(navMesh, ref);
+    uint32_t startNode = NO_NODE;
+    float minDist = std::numeric_limits<float>::infinity();
+    for (uint32_t iNode = polyNodeOffsets_[startPoly];
+         iNode < polyNodeOffsets_[startPoly + 1]; ++iNode) {
+      const uint32_t node = polyNodes_[iNode];
+      const float d = (pt - nodePositions_[node]).norm() + goal.dist[node];
+      if (d < minDist) {
+        minDist = d;
+        startNode = node;
+      }
+    }
+    if (startNode == NO_NODE)
+      return minDist;
+
+    // The graph path from pt, the graph points it passes and then the goal
+    std::vector<vec3f> path{pt};
+    std::vector<uint32_t> pathNodes{NO_NODE};
+    for (uint32_t node = startNode; node != NO_NODE; node = goal.next[node]) {
+      path.emplace_back(nodePositions_[node]);
+      pathNodes.emplace_back(node);
+    }
+    path.emplace_back(goal.point);
+    pathNodes.emplace_back(NO_NODE);
+
+    // Pull it taut. Consecutive points are connected by a graph edge, so the
+    // next corner is at least the next point of the path.
+    float dist = 0.0f;
+    const dtPolyRef* anchorRefs = &ref;
+    uint32_t numAnchorRefs = 1;
+    std::size_t anchor = 0;
+    while (anchor + 1 < path.size()) {
+      std::size_t corner = anchor + 1;
+      while (corner + 1 < path.size() &&
+             isVisible(navQuery, filter, anchorRefs, numAnchorRefs,
+                       path[anchor], path[corner + 1])) {
+        ++corner;
+      }
+      dist += (path[corner] - path[anchor]).norm();
+
+      // Every corner but the goal is a graph point
+      if (corner + 1 < path.size()) {
+        const uint32_t node = pathNodes[corner];
+        anchorRefs = &nodePolys_[nodePolyOffsets_[node]];
+        numAnchorRefs = nodePolyOffsets_[node + 1] - nodePolyOffsets_[node];
+      }
+      anchor = corner;
+    }
 
-    return islandRadius_[itRef->second];
+    return dist;
   }
 
+  dtPolyRef goalRef(int goalId) const { return goals_[goalId].ref; }
+
+  void clear() { goals_.clear(); }
+
+  bool save(const std::string& path) const;
+  bool load(const std::string& path);
+
  private:
-  std::unordered_map<dtPolyRef, uint32_t> polyToIsland_;
-  std::vector<float> islandRadius_;
-
-  void expandFrom(const dtNavMesh* navMesh,
-                  const dtQueryFilter* filter,
-                  const uint32_t newIslandId,
-                  const dtPolyRef& startRef,
-                  std::vector<vec3f>& islandVerts) {
-    polyToIsland_.emplace(startRef, newIslandId);
-    islandVerts.clear();
-
-    // Force std::stack to be implemented via an std::vector as linked
-    // lists are gross
-    std::stack<dtPolyRef, std::vector<dtPolyRef>> stack;
-
-    // Add the start ref to the stack
-    stack.push(startRef);
-    while (!stack.empty()) {
-      dtPolyRef ref = stack.top();
-      stack.pop();
-
-      const dtMeshTile* tile = nullptr;
-      const dtPoly* poly = nullptr;
-      navMesh->getTileAndPolyByRefUnsafe(ref, &tile, &poly);
-
-      for (int iVert = 0; iVert < poly->vertCount; ++iVert) {
-        islandVerts.emplace_back(
-            Eigen::Map<vec3f>(&tile->verts[poly->verts[iVert] * 3]));
-      }
+  static constexpr uint32_t NO_NODE = ~0u;
+
+  struct Goal {
+    vec3f point;
+    dtPolyRef ref;
+    //! Distance from every graph node to the goal
+    std::vector<float> dist;
+    //! Next graph node on the shortest path to the goal, NO_NODE if the goal
+    //! itself is next or the goal is not reachable
+    std::vector<uint32_t> next;
+  };
 
-      // Iterate over all neighbours
-      for (unsigned int iLink = poly->firstLink; iLink != DT_NULL_LINK;
-           iLink = tile->links[iLink].next) {
-        dtPolyRef neighbourRef = tile->links[iLink].ref;
-        // If we've already visited this poly, skip it!
-        if (polyToIsland_.find(neighbourRef) != polyToIsland_.end())
-          continue;
+  //! Hash of the navmesh the fields were computed on
+  uint64_t navMeshHash_;
+  //! Index of the first vertex node of each tile
+  std::vector<uint32_t> tileVertBase_;
+  //! Index of the first polygon of each tile
+  std::vector<uint32_t> tilePolyBase_;
+  //! Vertex nodes, followed by portal end point nodes
+  std::vector<vec3f> nodePositions_;
+  //! Graph nodes on the boundary of each polygon
+  std::vector<uint32_t> polyNodeOffsets_;
+  std::vector<uint32_t> polyNodes_;
+  //! Polygons each graph node is on the boundary of
+  std::vector<uint32_t> nodePolyOffsets_;
+  std::vector<dtPolyRef> nodePolys_;
+  std::vector<uint32_t> adjOffsets_;
+  std::vector<uint32_t> adjNodes_;
+  std::vector<float> adjDists_;
+  std::vector<Goal> goals_;
+
+  uint32_t nodeIndex(const dtNavMesh* navMesh,
+                     const dtMeshTile* tile,
+                     uint32_t vert) const {
+    const unsigned int iTile =
+        navMesh->decodePolyIdTile(navMesh->getPolyRefBase(tile));
+    return tileVertBase_[iTile] + vert;
+  }
 
-        const dtMeshTile* neighbourTile = nullptr;
-        const dtPoly* neighbourPoly = nullptr;
-        navMesh->getTileAndPolyByRefUnsafe(neighbourRef, &neighbourTile,
-                                           &neighbourPoly);
+  uint32_t polyIndex(const dtNavMesh* navMesh, dtPolyRef ref) const {
+    return tilePolyBase_[navMesh->decodePolyIdTile(ref)] +
+           navMesh->decodePolyIdPoly(ref);
+  }
 
-        // If a neighbour isn't walkable, don't add it
-        if (!filter->passFilter(neighbourRef, neighbourTile, neighbourPoly))
-          continue;
+  static vec3f vertPosition(const dtMeshTile* tile, uint32_t vert) {
+    return Eigen::Map<const vec3f>(&tile->verts[vert * 3]);
+  }
 
-        polyToIsland_.emplace(neighbourRef, newIslandId);
-        stack.push(neighbourRef);
+  // Whether the straight line from a, which is on one of the polygons refs, to
+  // b is on the navmesh
+  static bool isVisible(const dtNavMeshQuery* navQuery,
+                        const dtQueryFilter* filter,
+                        const dtPolyRef* refs,
+                        uint32_t numRefs,
+                        const vec3f& a,
+                        const vec3f& b) {
+    for (uint32_t i = 0; i < numRefs; ++i) {
+      float t = 0.0f;
+      float hitNormal[3];
+      int pathCount = 0;
+      const dtStatus status =
+          navQuery->raycast(refs[i], a.data(), b.data(), filter, &t, hitNormal,
+                            nullptr, &pathCount, 0);
+      // t is FLT_MAX if b is reached. A b on the boundary of the navmesh can
+      // also be reported as a hit right at it.
+      if (dtStatusSucceed(status) && t > 0.999f)
+        return true;
+    }
+    return false;
+  }
+
+  // FNV-1a hash of the vertices and polygons of all tiles, so that saved
+  // fields are only loaded for the navmesh they were computed on
+  static uint64_t computeNavMeshHash(const dtNavMesh* navMesh) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    const auto hashBytes = [&hash](const void* data, std::size_t size) {
+      const unsigned char* bytes = static_cast<const unsigned char*>(data);
+      for (std::size_t i = 0; i < size; ++i) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+      }
+    };
+
+    for (int iTile = 0; iTile < navMesh->getMaxTiles(); ++iTile) {
+      const dtMeshTile* tile = navMesh->getTile(iTile);
+      if (!tile || !tile->header)
+        continue;
+      hashBytes(&iTile, sizeof(iTile));
+      hashBytes(tile->verts, sizeof(float) * 3 * tile->header->vertCount);
+      for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
+        const dtPoly& poly = tile->polys[jPoly];
+        hashBytes(poly.verts, sizeof(poly.verts));
+        hashBytes(poly.neis, sizeof(poly.neis));
+        hashBytes(&poly.flags, sizeof(poly.flags));
+        hashBytes(&poly.vertCount, sizeof(poly.vertCount));
+        hashBytes(&poly.areaAndtype, sizeof(poly.areaAndtype));
       }
     }
+    return hash;
   }
 };
+
+constexpr uint32_t DistanceOracle::NO_NODE;
+
+namespace {
+const int DISTANCEORACLE_MAGIC = 'G' << 24 | 'D' << 16 | 'O' << 8 | 'R';
+const int DISTANCEORACLE_VERSION = 3;
+
+struct DistanceOracleHeader {
+  int magic;
+  int version;
+  uint32_t numNodes;
+  int numGoals;
+  uint64_t navMeshHash;
+};
+
+struct DistanceOracleGoalHeader {
+  float point[3];
+  dtPolyRef ref;
+};
+}  // namespace
+
+bool DistanceOracle::save(const std::string& path) const {
+  FILE* fp = fopen(path.c_str(), "wb");
+  if (!fp)
+    return false;
+
+  DistanceOracleHeader header{};
+  header.magic = DISTANCEORACLE_MAGIC;
+  header.version = DISTANCEORACLE_VERSION;
+  header.numNodes = numNodes();
+  header.numGoals = goals_.size();
+  header.navMeshHash = navMeshHash_;
+  fwrite(&header, sizeof(header), 1, fp);
+
+  for (const Goal& goal : goals_) {
+    DistanceOracleGoalHeader goalHeader{};
+    Eigen::Map<vec3f>(goalHeader.point) = goal.point;
+    goalHeader.ref = goal.ref;
+    fwrite(&goalHeader, sizeof(goalHeader), 1, fp);
+    fwrite(goal.dist.data(), sizeof(float), goal.dist.size(), fp);
+    fwrite(goal.next.data(), sizeof(uint32_t), goal.next.size(), fp);
+  }
+
+  fclose(fp);
+
+  return true;
+}
+
+bool DistanceOracle::load(const std::string& path) {
+  FILE* fp = fopen(path.c_str(), "rb");
+  if (!fp)
+    return false;
+
+  DistanceOracleHeader header{};
+  size_t readLen = fread(&header, sizeof(header), 1, fp);
+  // The fields are only valid for the navmesh they were computed on
+  if (readLen != 1 || header.magic != DISTANCEORACLE_MAGIC ||
+      header.version != DISTANCEORACLE_VERSION ||
+      header.navMeshHash != navMeshHash_ || header.numNodes != numNodes() ||
+      header.numGoals < 0) {
+    fclose(fp);
+    return false;
+  }
+
+  std::vector<Goal> goals(header.numGoals);
+  for (Goal& goal : goals) {
+    DistanceOracleGoalHeader goalHeader{};
+    readLen = fread(&goalHeader, sizeof(goalHeader), 1, fp);
+    if (readLen != 1) {
+      fclose(fp);
+      return false;
+    }
+    goal.point = Eigen::Map<vec3f>(goalHeader.point);
+    goal.ref = goalHeader.ref;
+    goal.dist.resize(header.numNodes);
+    readLen = fread(goal.dist.data(), sizeof(float), header.numNodes, fp);
+    if (readLen != header.numNodes) {
+      fclose(fp);
+      return false;
+    }
+    goal.next.resize(header.numNodes);
+    readLen = fread(goal.next.data(), sizeof(uint32_t), header.numNodes, fp);
+    if (readLen != header.numNodes) {
+      fclose(fp);
+      return false;
+    }
+  }
+
+  fclose(fp);
+
+  goals_ = std::move(goals);
+  return true;
+}
+
+// A private, writable mapping of a whole file. Pages are shared with the page
+// cache, and so with every other process mapping the same file, until they
+// are written to. Only the written pages are then copied.
+class FileMapping {
+ public:
+  static std::unique_ptr<FileMapping> open(const std::string& path) {
+    std::unique_ptr<FileMapping> mapping{new FileMapping};
+#ifndef _WIN32
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+      return nullptr;
+
+    struct stat st {};
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+      close(fd);
+      return nullptr;
+    }
+
+    void* data = mmap(nullptr, st.st_size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+      return nullptr;
+
+    mapping->data_ = static_cast<unsigned char*>(data);
+    mapping->size_ = st.st_size;
+#else
+    // No copy-on-write mappings here, read the file instead
+    FILE* fp = fopen(path.c_str(), "rb");
+    if (!fp)
+      return nullptr;
+    fseek(fp, 0, SEEK_END);
+    const long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    if (size <= 0) {
+      fclose(fp);
+      return nullptr;
+    }
+    mapping->data_ = new unsigned char[size];
+    mapping->size_ = size;
+    const size_t readLen = fread(mapping->data_, size, 1, fp);
+    fclose(fp);
+    if (readLen != 1)
+      return nullptr;
+#endif
+
+    return mapping;
+  }
+
+  ~FileMapping() {
+    if (!data_)
+      return;
+#ifndef _WIN32
+    munmap(data_, size_);
+#else
+    delete[] data_;
+#endif
+  }
+
+  unsigned char* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  FileMapping() = default;
+
+  unsigned char* data_ = nullptr;
+  size_t size_ = 0;
+};
 }  // namespace impl
 
 struct PathFinder::Impl {
@@ -225,10 +674,17 @@ struct PathFinder::Impl {
              const float* bmax);
   bool build(const NavMeshSettings& bs, const esp::assets::MeshData& mesh);
 
+  bool rebuildTiles(const esp::assets::MeshData& mesh,
+                    const std::vector<std::pair<vec3f, vec3f>>& changedBounds);
+
   vec3f getRandomNavigablePoint(int maxTries);
+  std::vector<vec3f> getRandomNavigablePoints(int numPoints);
 
   bool findPath(ShortestPath& path);
   bool findPath(MultiGoalShortestPath& path);
+  bool findPath(PathCorridor& path);
+
+  std::vector<bool> findPaths(std::vector<ShortestPath>& paths);
 
   template <typename T>
   T tryStep(const T& start, const T& end, bool allowSliding);
@@ -240,6 +696,10 @@ struct PathFinder::Impl {
 
   bool saveNavMesh(const std::string& path);
 
+  bool loadNavMeshCache(const std::string& path);
+
+  bool saveNavMeshCache(const std::string& path);
+
   bool isLoaded() const { return navMesh_ != nullptr; };
 
   float getNavigableArea() const { return navMeshArea_; };
@@ -256,6 +716,12 @@ struct PathFinder::Impl {
 
   bool isNavigable(const vec3f& pt, const float maxYDelta = 0.5) const;
 
+  PointsQueryResult queryPoints(
+      const Eigen::Ref<const Eigen::RowMatrixXf>& points,
+      float maxYDelta,
+      float maxSearchRadius,
+      bool computeDistances);
+
   std::pair<vec3f, vec3f> bounds() const { return bounds_; };
 
   Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic> getTopDownView(
@@ -264,6 +730,15 @@ struct PathFinder::Impl {
 
   const assets::MeshData::ptr getNavMeshData();
 
+  int addDistanceOracleGoal(const vec3f& goal);
+  int getNumDistanceOracleGoals() const {
+    return distanceOracle_ ? distanceOracle_->numGoals() : 0;
+  }
+  void clearDistanceOracle() { distanceOracle_.reset(); }
+  float getOracleGeodesicDistance(const vec3f& start, int goalId) const;
+  bool saveDistanceOracle(const std::string& path) const;
+  bool loadDistanceOracle(const std::string& path);
+
  private:
   struct NavMeshDeleter {
     void operator()(dtNavMesh* mesh) { dtFreeNavMesh(mesh); }
@@ -272,10 +747,69 @@ struct PathFinder::Impl {
     void operator()(dtNavMeshQuery* query) { dtFreeNavMeshQuery(query); }
   };
 
+  //! Backs the tiles of a navmesh loaded with loadNavMeshCache. Declared
+  //! before navMesh_ so that it outlives it.
+  std::unique_ptr<impl::FileMapping> navMeshMapping_ = nullptr;
   std::unique_ptr<dtNavMesh, NavMeshDeleter> navMesh_ = nullptr;
   std::unique_ptr<dtNavMeshQuery, NavQueryDeleter> navQuery_ = nullptr;
   std::unique_ptr<dtQueryFilter> filter_ = nullptr;
   std::unique_ptr<impl::IslandSystem> islandSystem_ = nullptr;
+  //! Only created once goals are registered. Reset whenever the navmesh
+  //! changes.
+  std::unique_ptr<impl::DistanceOracle> distanceOracle_ = nullptr;
+
+  //! Layout of a tiled navmesh, kept so that single tiles can be rebuilt
+  struct TileLayout {
+    //! Recast config of a single tile, with the bounds of the whole navmesh
+    rcConfig cfg;
+    NavMeshSettings settings;
+    int tilesX;
+    int tilesZ;
+    float tileWorldSize;
+    float borderWorldSize;
+
+    //! Index along x (axis 0) or z (axis 2) of the tile containing coord
+    int tileCoord(float coord, int axis) const {
+      const int count = axis == 0 ? tilesX : tilesZ;
+      const int t = static_cast<int>(
+          floorf((coord - cfg.bmin[axis]) / tileWorldSize));
+      return std::min(std::max(t, 0), count - 1);
+    }
+  };
+
+  struct TileBuildResult {
+    bool success = true;
+    int tileX = 0;
+    int tileZ = 0;
+    unsigned char* navData = nullptr;
+    int navDataSize = 0;
+    int numPolyVerts = 0;
+    int numPolys = 0;
+  };
+
+  //! Set only if the navmesh was built with NavMeshSettings::tileSize > 0
+  Cr::Containers::Optional<TileLayout> tileLayout_;
+
+  //! One query per worker thread for batched queries. All of them share the
+  //! read-only navMesh_. Lazily grown, reset with navQuery_.
+  std::vector<std::unique_ptr<dtNavMeshQuery, NavQueryDeleter>> workerQueries_;
+
+  //! Scratch space for the polygon corridor and straight path of a search.
+  //! Reused across searches and grown whenever a path does not fit.
+  struct PathBuffers {
+    std::vector<dtPolyRef> polys = std::vector<dtPolyRef>(256);
+    std::vector<vec3f> points = std::vector<vec3f>(256);
+    int numPoints = 0;
+  };
+
+  //! Buffers of navQuery_
+  PathBuffers pathBuffers_;
+  //! Buffers of each of workerQueries_
+  std::vector<PathBuffers> workerPathBuffers_;
+
+  //! Incremented whenever polygon refs may have changed, so that path
+  //! corridors found on an older version of the navmesh are replanned
+  uint64_t navMeshVersion_ = 0;
 
   //! Holds triangulated geom/topo. Generated when queried. Reset with
   //! navQuery_.
@@ -285,21 +819,81 @@ struct PathFinder::Impl {
   //! removeZeroAreaPolys.
   float navMeshArea_ = 0;
 
-  std::pair<vec3f, vec3f> bounds_;
+  //! Random stream of this PathFinder, see seed()
+  core::Random random_;
 
-  void removeZeroAreaPolys();
+  //! Detail triangles of all walkable polygons, three vertices each, and the
+  //! running sum of their areas for area-weighted sampling. Rebuilt whenever
+  //! the navmesh changes. See buildSamplingTable.
+  std::vector<vec3f> samplingTriVerts_;
+  std::vector<double> samplingAreaSums_;
 
-  bool initNavQuery();
+  std::pair<vec3f, vec3f> bounds_;
 
-  Cr::Containers::Optional<std::tuple<float, std::vector<vec3f>>>
-  findPathInternal(const vec3f& start,
+  void removeZeroAreaPolys();
+  float removeZeroAreaPolys(const dtMeshTile* tile);
+
+  void buildSamplingTable();
+  vec3f sampleNavigablePoint();
+
+  bool initNavQuery(
+      std::unique_ptr<impl::IslandSystem> islandSystem = nullptr);
+
+  bool buildTiled(dtNavMesh* navMesh,
+                  const rcConfig& cfg,
+                  const NavMeshSettings& bs,
+                  const float* verts,
+                  const int nverts,
+                  const int* tris,
+                  const int ntris,
+                  TileLayout& layout,
+                  int& totalPolyVerts,
+                  int& totalPolys);
+
+  std::vector<TileBuildResult> buildTiles(const TileLayout& layout,
+                                          const std::vector<int>& tileIds,
+                                          const float* verts,
+                                          const int nverts,
+                                          const int* tris,
+                                          const int ntris);
+
+  // Whether all tiles were built and fit into navMesh, frees the data of
+  // all of them if not
+  bool checkTiles(const dtNavMesh* navMesh,
+                  std::vector<TileBuildResult>& results);
+
+  bool addTiles(dtNavMesh* navMesh,
+                std::vector<TileBuildResult>& results,
+                std::vector<const dtMeshTile*>& addedTiles);
+
+  bool initWorkerQueries(int numWorkers);
+
+  bool findPath(ShortestPath& path,
+                dtNavMeshQuery* navQuery,
+                PathBuffers& buffers);
+  bool findPath(MultiGoalShortestPath& path,
+                dtNavMeshQuery* navQuery,
+                PathBuffers& buffers);
+
+  int findPolyPath(dtNavMeshQuery* navQuery,
                    dtPolyRef startRef,
                    const vec3f& pathStart,
-                   const vec3f& end,
                    dtPolyRef endRef,
-                   const vec3f& pathEnd);
-
-  bool findPathSetup(MultiGoalShortestPath& path,
+                   const vec3f& pathEnd,
+                   std::vector<dtPolyRef>& polys);
+
+  //! On success, the path is in the first buffers.numPoints of buffers.points
+  Cr::Containers::Optional<float> findPathInternal(dtNavMeshQuery* navQuery,
+                                                   PathBuffers& buffers,
+                                                   const vec3f& start,
+                                                   dtPolyRef startRef,
+                                                   const vec3f& pathStart,
+                                                   const vec3f& end,
+                                                   dtPolyRef endRef,
+                                                   const vec3f& pathEnd);
+
+  bool findPathSetup(dtNavMeshQuery* navQuery,
+                     MultiGoalShortestPath& path,
                      dtPolyRef& startRef,
                      vec3f& pathStart);
 };
@@ -331,57 +925,25 @@ enum PolyFlags {
   POLYFLAGS_DISABLED = 0x04,  // disabled polygon
   POLYFLAGS_ALL = 0xffff      // all abilities
 };
-}  // namespace
-
-PathFinder::Impl::Impl() {
-  filter_ = std::make_unique<dtQueryFilter>();
-  filter_->setIncludeFlags(POLYFLAGS_WALK);
-  filter_->setExcludeFlags(0);
-}
 
-bool PathFinder::Impl::build(const NavMeshSettings& bs,
-                             const float* verts,
-                             const int nverts,
-                             const int* tris,
-                             const int ntris,
-                             const float* bmin,
-                             const float* bmax) {
+// Runs steps 2 to 8 of the Recast pipeline over the part of the input polygon
+// soup inside cfg.bmin/cfg.bmax and packs the result as the Detour tile at
+// (tileX, tileY). navData is left null if the area has no walkable polygons.
+bool buildTileData(const rcConfig& cfg,
+                   const NavMeshSettings& bs,
+                   const float* verts,
+                   const int nverts,
+                   const int* tris,
+                   const int ntris,
+                   const int tileX,
+                   const int tileY,
+                   unsigned char** navData,
+                   int* navDataSize,
+                   int* numPolyVerts,
+                   int* numPolys) {
   Workspace ws;
   rcContext ctx;
 
-  //
-  // Step 1. Initialize build config.
-  //
-
-  // Init build configuration from GUI
-  rcConfig cfg{};
-  memset(&cfg, 0, sizeof(cfg));
-  cfg.cs = bs.cellSize;
-  cfg.ch = bs.cellHeight;
-  cfg.walkableSlopeAngle = bs.agentMaxSlope;
-  cfg.walkableHeight = static_cast<int>(ceilf(bs.agentHeight / cfg.ch));
-  cfg.walkableClimb = static_cast<int>(floorf(bs.agentMaxClimb / cfg.ch));
-  cfg.walkableRadius = static_cast<int>(ceilf(bs.agentRadius / cfg.cs));
-  cfg.maxEdgeLen = static_cast<int>(bs.edgeMaxLen / bs.cellSize);
-  cfg.maxSimplificationError = bs.edgeMaxError;
-  cfg.minRegionArea =
-      static_cast<int>(rcSqr(bs.regionMinSize));  // Note: area = size*size
-  cfg.mergeRegionArea =
-      static_cast<int>(rcSqr(bs.regionMergeSize));  // Note: area = size*size
-  cfg.maxVertsPerPoly = static_cast<int>(bs.vertsPerPoly);
-  cfg.detailSampleDist =
-      bs.detailSampleDist < 0.9f ? 0 : bs.cellSize * bs.detailSampleDist;
-  cfg.detailSampleMaxError = bs.cellHeight * bs.detailSampleMaxError;
-
-  // Set the area where the navigation will be build.
-  // Here the bounds of the input mesh are used, but the
-  // area could be specified by an user defined box, etc.
-  rcVcopy(cfg.bmin, bmin);
-  rcVcopy(cfg.bmax, bmax);
-  rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
-  LOG(INFO) << "Building navmesh with " << cfg.width << "x" << cfg.height
-            << " cells";
-
   //
   // Step 2. Rasterize input polygon soup.
   //
@@ -504,7 +1066,7 @@ bool PathFinder::Impl::build(const NavMeshSettings& bs,
     return false;
   }
   // Partition the walkable surface into simple regions without holes.
-  if (!rcBuildRegions(&ctx, *ws.chf, 0, cfg.minRegionArea,
+  if (!rcBuildRegions(&ctx, *ws.chf, cfg.borderSize, cfg.minRegionArea,
                       cfg.mergeRegionArea)) {
     LOG(ERROR) << "Could not build watershed regions";
     return false;
@@ -569,93 +1131,480 @@ bool PathFinder::Impl::build(const NavMeshSettings& bs,
   // access the data.
 
   //
-  // (Optional) Step 8. Create Detour data from Recast poly mesh.
+  // Step 8. Create Detour data from Recast poly mesh.
   //
 
-  // The GUI may allow more max points per polygon than Detour can handle.
-  // Only build the detour navmesh if we do not exceed the limit.
-  if (cfg.maxVertsPerPoly <= DT_VERTS_PER_POLYGON) {
-    unsigned char* navData = nullptr;
-    int navDataSize = 0;
+  *navData = nullptr;
+  *navDataSize = 0;
+  *numPolyVerts = ws.pmesh->nverts;
+  *numPolys = ws.pmesh->npolys;
+  if (ws.pmesh->npolys == 0)
+    return true;
 
-    // Update poly flags from areas.
-    for (int i = 0; i < ws.pmesh->npolys; ++i) {
-      if (ws.pmesh->areas[i] == RC_WALKABLE_AREA) {
-        ws.pmesh->areas[i] = POLYAREA_GROUND;
-      }
-      if (ws.pmesh->areas[i] == POLYAREA_GROUND) {
-        ws.pmesh->flags[i] = POLYFLAGS_WALK;
-      } else if (ws.pmesh->areas[i] == POLYAREA_DOOR) {
-        ws.pmesh->flags[i] = POLYFLAGS_WALK | POLYFLAGS_DOOR;
-      }
+  // Update poly flags from areas.
+  for (int i = 0; i < ws.pmesh->npolys; ++i) {
+    if (ws.pmesh->areas[i] == RC_WALKABLE_AREA) {
+      ws.pmesh->areas[i] = POLYAREA_GROUND;
+    }
+    if (ws.pmesh->areas[i] == POLYAREA_GROUND) {
+      ws.pmesh->flags[i] = POLYFLAGS_WALK;
+    } else if (ws.pmesh->areas[i] == POLYAREA_DOOR) {
+      ws.pmesh->flags[i] = POLYFLAGS_WALK | POLYFLAGS_DOOR;
     }
+  }
 
-    dtNavMeshCreateParams params{};
-    memset(&params, 0, sizeof(params));
-    params.verts = ws.pmesh->verts;
-    params.vertCount = ws.pmesh->nverts;
-    params.polys = ws.pmesh->polys;
-    params.polyAreas = ws.pmesh->areas;
-    params.polyFlags = ws.pmesh->flags;
-    params.polyCount = ws.pmesh->npolys;
-    params.nvp = ws.pmesh->nvp;
-    params.detailMeshes = ws.dmesh->meshes;
-    params.detailVerts = ws.dmesh->verts;
-    params.detailVertsCount = ws.dmesh->nverts;
-    params.detailTris = ws.dmesh->tris;
-    params.detailTriCount = ws.dmesh->ntris;
-    // params.offMeshConVerts = geom->getOffMeshConnectionVerts();
-    // params.offMeshConRad = geom->getOffMeshConnectionRads();
-    // params.offMeshConDir = geom->getOffMeshConnectionDirs();
-    // params.offMeshConAreas = geom->getOffMeshConnectionAreas();
-    // params.offMeshConFlags = geom->getOffMeshConnectionFlags();
-    // params.offMeshConUserID = geom->getOffMeshConnectionId();
-    // params.offMeshConCount = geom->getOffMeshConnectionCount();
-    params.walkableHeight = bs.agentHeight;
-    params.walkableRadius = bs.agentRadius;
-    params.walkableClimb = bs.agentMaxClimb;
-    rcVcopy(params.bmin, ws.pmesh->bmin);
-    rcVcopy(params.bmax, ws.pmesh->bmax);
-    params.cs = cfg.cs;
-    params.ch = cfg.ch;
-    params.buildBvTree = true;
-
-    if (!dtCreateNavMeshData(&params, &navData, &navDataSize)) {
-      LOG(ERROR) << "Could not build Detour navmesh";
+  dtNavMeshCreateParams params{};
+  memset(&params, 0, sizeof(params));
+  params.verts = ws.pmesh->verts;
+  params.vertCount = ws.pmesh->nverts;
+  params.polys = ws.pmesh->polys;
+  params.polyAreas = ws.pmesh->areas;
+  params.polyFlags = ws.pmesh->flags;
+  params.polyCount = ws.pmesh->npolys;
+  params.nvp = ws.pmesh->nvp;
+  params.detailMeshes = ws.dmesh->meshes;
+  params.detailVerts = ws.dmesh->verts;
+  params.detailVertsCount = ws.dmesh->nverts;
+  params.detailTris = ws.dmesh->tris;
+  params.detailTriCount = ws.dmesh->ntris;
+  // params.offMeshConVerts = geom->getOffMeshConnectionVerts();
+  // params.offMeshConRad = geom->getOffMeshConnectionRads();
+  // params.offMeshConDir = geom->getOffMeshConnectionDirs();
+  // params.offMeshConAreas = geom->getOffMeshConnectionAreas();
+  // params.offMeshConFlags = geom->getOffMeshConnectionFlags();
+  // params.offMeshConUserID = geom->getOffMeshConnectionId();
+  // params.offMeshConCount = geom->getOffMeshConnectionCount();
+  params.walkableHeight = bs.agentHeight;
+  params.walkableRadius = bs.agentRadius;
+  params.walkableClimb = bs.agentMaxClimb;
+  params.tileX = tileX;
+  params.tileY = tileY;
+  rcVcopy(params.bmin, ws.pmesh->bmin);
+  rcVcopy(params.bmax, ws.pmesh->bmax);
+  params.cs = cfg.cs;
+  params.ch = cfg.ch;
+  params.buildBvTree = true;
+
+  if (!dtCreateNavMeshData(&params, navData, navDataSize)) {
+    LOG(ERROR) << "Could not build Detour navmesh";
+    return false;
+  }
+
+  return true;
+}
+}  // namespace
+
+PathFinder::Impl::Impl() {
+  filter_ = std::make_unique<dtQueryFilter>();
+  filter_->setIncludeFlags(POLYFLAGS_WALK);
+  filter_->setExcludeFlags(0);
+}
+
+bool PathFinder::Impl::build(const NavMeshSettings& bs,
+                             const float* verts,
+                             const int nverts,
+                             const int* tris,
+                             const int ntris,
+                             const float* bmin,
+                             const float* bmax) {
+  //
+  // Step 1. Initialize build config.
+  //
+
+  // Init build configuration from GUI
+  rcConfig cfg{};
+  memset(&cfg, 0, sizeof(cfg));
+  cfg.cs = bs.cellSize;
+  cfg.ch = bs.cellHeight;
+  cfg.walkableSlopeAngle = bs.agentMaxSlope;
+  cfg.walkableHeight = static_cast<int>(ceilf(bs.agentHeight / cfg.ch));
+  cfg.walkableClimb = static_cast<int>(floorf(bs.agentMaxClimb / cfg.ch));
+  cfg.walkableRadius = static_cast<int>(ceilf(bs.agentRadius / cfg.cs));
+  cfg.maxEdgeLen = static_cast<int>(bs.edgeMaxLen / bs.cellSize);
+  cfg.maxSimplificationError = bs.edgeMaxError;
+  cfg.minRegionArea =
+      static_cast<int>(rcSqr(bs.regionMinSize));  // Note: area = size*size
+  cfg.mergeRegionArea =
+      static_cast<int>(rcSqr(bs.regionMergeSize));  // Note: area = size*size
+  cfg.maxVertsPerPoly = static_cast<int>(bs.vertsPerPoly);
+  cfg.detailSampleDist =
+      bs.detailSampleDist < 0.9f ? 0 : bs.cellSize * bs.detailSampleDist;
+  cfg.detailSampleMaxError = bs.cellHeight * bs.detailSampleMaxError;
+
+  // Set the area where the navigation will be build.
+  // Here the bounds of the input mesh are used, but the
+  // area could be specified by an user defined box, etc.
+  rcVcopy(cfg.bmin, bmin);
+  rcVcopy(cfg.bmax, bmax);
+  rcCalcGridSize(cfg.bmin, cfg.bmax, cfg.cs, &cfg.width, &cfg.height);
+
+  // Detour cannot handle polygons with more vertices than this
+  if (cfg.maxVertsPerPoly > DT_VERTS_PER_POLYGON) {
+    LOG(ERROR) << "Navmesh polygons can have at most " << DT_VERTS_PER_POLYGON
+               << " vertices";
+    return false;
+  }
+
+  std::unique_ptr<dtNavMesh, NavMeshDeleter> navMesh(dtAllocNavMesh());
+  if (!navMesh) {
+    LOG(ERROR) << "Could not allocate Detour navmesh";
+    return false;
+  }
+
+  int totalPolyVerts = 0;
+  int totalPolys = 0;
+  Cr::Containers::Optional<TileLayout> tileLayout;
+  if (bs.tileSize > 0) {
+    tileLayout.emplace();
+    if (!buildTiled(navMesh.get(), cfg, bs, verts, nverts, tris, ntris,
+                    *tileLayout, totalPolyVerts, totalPolys)) {
       return false;
     }
+  } else {
+    LOG(INFO) << "Building navmesh with " << cfg.width << "x" << cfg.height
+              << " cells";
 
-    navMesh_.reset(dtAllocNavMesh());
-    if (!navMesh_) {
-      dtFree(navData);
-      LOG(ERROR) << "Could not allocate Detour navmesh";
+    unsigned char* navData = nullptr;
+    int navDataSize = 0;
+    if (!buildTileData(cfg, bs, verts, nverts, tris, ntris, 0, 0, &navData,
+                       &navDataSize, &totalPolyVerts, &totalPolys)) {
+      return false;
+    }
+    if (!navData) {
+      LOG(ERROR) << "Could not build Detour navmesh";
       return false;
     }
 
-    dtStatus status = 0;
-    status = navMesh_->init(navData, navDataSize, DT_TILE_FREE_DATA);
+    dtStatus status = navMesh->init(navData, navDataSize, DT_TILE_FREE_DATA);
     if (dtStatusFailed(status)) {
       dtFree(navData);
       LOG(ERROR) << "Could not init Detour navmesh";
       return false;
     }
-    if (!initNavQuery()) {
-      return false;
-    }
+  }
+
+  navMesh_ = std::move(navMesh);
+  navMeshMapping_ = nullptr;
+  tileLayout_ = std::move(tileLayout);
+  if (!initNavQuery()) {
+    return false;
   }
 
   // Added as we also need to remove these on navmesh recomputation
   removeZeroAreaPolys();
+  buildSamplingTable();
 
-  LOG(INFO) << "Created navmesh with " << ws.pmesh->nverts << " vertices "
-            << ws.pmesh->npolys << " polygons";
+  LOG(INFO) << "Created navmesh with " << totalPolyVerts << " vertices "
+            << totalPolys << " polygons";
 
   return true;
 }
 
-bool PathFinder::Impl::initNavQuery() {
+bool PathFinder::Impl::buildTiled(dtNavMesh* navMesh,
+                                  const rcConfig& cfg,
+                                  const NavMeshSettings& bs,
+                                  const float* verts,
+                                  const int nverts,
+                                  const int* tris,
+                                  const int ntris,
+                                  TileLayout& layout,
+                                  int& totalPolyVerts,
+                                  int& totalPolys) {
+  // Every tile is rasterized with a border of extra cells so that erosion and
+  // region building see the geometry just outside of it and the tiles line up.
+  // Most of a tile would be border if it wasn't larger than that.
+  const int borderSize = cfg.walkableRadius + 3;
+  if (bs.tileSize < 1.0f) {
+    LOG(ERROR) << "NavMeshSettings::tileSize is " << bs.tileSize
+               << ", a tile has to be at least one voxel";
+    return false;
+  }
+  const int tileSize = static_cast<int>(bs.tileSize);
+  if (tileSize < 2 * borderSize) {
+    LOG(ERROR) << "NavMeshSettings::tileSize is " << bs.tileSize
+               << ", has to be at least twice the " << borderSize
+               << " voxel border of the tiles";
+    return false;
+  }
+  layout.settings = bs;
+  layout.tilesX = (cfg.width + tileSize - 1) / tileSize;
+  layout.tilesZ = (cfg.height + tileSize - 1) / tileSize;
+  layout.tileWorldSize = tileSize * cfg.cs;
+  const int numTiles = layout.tilesX * layout.tilesZ;
+  LOG(INFO) << "Building navmesh with " << cfg.width << "x" << cfg.height
+            << " cells in " << layout.tilesX << "x" << layout.tilesZ
+            << " tiles";
+
+  // A dtPolyRef packs the salt, tile index and polygon index into 32 bits, so
+  // the bits given to the tile index are taken from the polygon index.
+  const int tileBits = static_cast<int>(dtIlog2(dtNextPow2(numTiles)));
+  if (tileBits > 14) {
+    LOG(ERROR) << "Too many navmesh tiles (" << numTiles
+               << "), increase NavMeshSettings::tileSize";
+    return false;
+  }
+  const int polyBits = 22 - tileBits;
+
+  dtNavMeshParams params{};
+  memset(&params, 0, sizeof(params));
+  rcVcopy(params.orig, cfg.bmin);
+  params.tileWidth = layout.tileWorldSize;
+  params.tileHeight = layout.tileWorldSize;
+  params.maxTiles = 1 << tileBits;
+  params.maxPolys = 1 << polyBits;
+  dtStatus status = navMesh->init(&params);
+  if (dtStatusFailed(status)) {
+    LOG(ERROR) << "Could not init Detour navmesh";
+    return false;
+  }
+
+  layout.cfg = cfg;
+  layout.cfg.tileSize = tileSize;
+  layout.cfg.borderSize = borderSize;
+  layout.cfg.width = tileSize + 2 * layout.cfg.borderSize;
+  layout.cfg.height = tileSize + 2 * layout.cfg.borderSize;
+  layout.borderWorldSize = layout.cfg.borderSize * cfg.cs;
+
+  std::vector<int> tileIds(numTiles);
+  std::iota(tileIds.begin(), tileIds.end(), 0);
+  std::vector<TileBuildResult> results =
+      buildTiles(layout, tileIds, verts, nverts, tris, ntris);
+  for (const TileBuildResult& result : results) {
+    totalPolyVerts += result.numPolyVerts;
+    totalPolys += result.numPolys;
+  }
+
+  std::vector<const dtMeshTile*> addedTiles;
+  return addTiles(navMesh, results, addedTiles);
+}
+
+std::vector<PathFinder::Impl::TileBuildResult> PathFinder::Impl::buildTiles(
+    const TileLayout& layout,
+    const std::vector<int>& tileIds,
+    const float* verts,
+    const int nverts,
+    const int* tris,
+    const int ntris) {
+  // Position of each requested tile in tileIds, -1 for all others
+  std::vector<int> tileSlot(layout.tilesX * layout.tilesZ, -1);
+  for (int i = 0; i < tileIds.size(); ++i) {
+    tileSlot[tileIds[i]] = i;
+  }
+
+  // Bin the triangles into every requested tile their (bordered) x-z bounds
+  // overlap
+  std::vector<std::vector<int>> tileTris(tileIds.size());
+  for (int iTri = 0; iTri < ntris; ++iTri) {
+    const int* tri = &tris[iTri * 3];
+    float triMin[2] = {verts[tri[0] * 3], verts[tri[0] * 3 + 2]};
+    float triMax[2] = {triMin[0], triMin[1]};
+    for (int k = 1; k < 3; ++k) {
+      triMin[0] = std::min(triMin[0], verts[tri[k] * 3]);
+      triMin[1] = std::min(triMin[1], verts[tri[k] * 3 + 2]);
+      triMax[0] = std::max(triMax[0], verts[tri[k] * 3]);
+      triMax[1] = std::max(triMax[1], verts[tri[k] * 3 + 2]);
+    }
+
+    const int x0 = layout.tileCoord(triMin[0] - layout.borderWorldSize, 0);
+    const int x1 = layout.tileCoord(triMax[0] + layout.borderWorldSize, 0);
+    const int z0 = layout.tileCoord(triMin[1] - layout.borderWorldSize, 2);
+    const int z1 = layout.tileCoord(triMax[1] + layout.borderWorldSize, 2);
+    for (int z = z0; z <= z1; ++z) {
+      for (int x = x0; x <= x1; ++x) {
+        const int slot = tileSlot[z * layout.tilesX + x];
+        if (slot >= 0)
+          tileTris[slot].insert(tileTris[slot].end(), tri, tri + 3);
+      }
+    }
+  }
+
+  std::vector<TileBuildResult> results(tileIds.size());
+
+  // Tiles are independent of each other until they are added to the navmesh
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < static_cast<int>(tileIds.size()); ++i) {
+    TileBuildResult& result = results[i];
+    result.tileX = tileIds[i] % layout.tilesX;
+    result.tileZ = tileIds[i] / layout.tilesX;
+
+    const std::vector<int>& tileIndices = tileTris[i];
+    if (tileIndices.empty())
+      continue;
+
+    rcConfig tileCfg = layout.cfg;
+    tileCfg.bmin[0] = layout.cfg.bmin[0] +
+                      result.tileX * layout.tileWorldSize -
+                      layout.borderWorldSize;
+    tileCfg.bmin[2] = layout.cfg.bmin[2] +
+                      result.tileZ * layout.tileWorldSize -
+                      layout.borderWorldSize;
+    tileCfg.bmax[0] = layout.cfg.bmin[0] +
+                      (result.tileX + 1) * layout.tileWorldSize +
+                      layout.borderWorldSize;
+    tileCfg.bmax[2] = layout.cfg.bmin[2] +
+                      (result.tileZ + 1) * layout.tileWorldSize +
+                      layout.borderWorldSize;
+
+    result.success = buildTileData(
+        tileCfg, layout.settings, verts, nverts, tileIndices.data(),
+        tileIndices.size() / 3, result.tileX, result.tileZ, &result.navData,
+        &result.navDataSize, &result.numPolyVerts, &result.numPolys);
+  }
+
+  return results;
+}
+
+bool PathFinder::Impl::checkTiles(const dtNavMesh* navMesh,
+                                  std::vector<TileBuildResult>& results) {
+  const int maxPolys = navMesh->getParams()->maxPolys;
+
+  bool success = true;
+  for (const TileBuildResult& result : results) {
+    if (!result.success) {
+      success = false;
+      break;
+    }
+    if (result.numPolys > maxPolys) {
+      LOG(ERROR) << "Navmesh tile has " << result.numPolys
+                 << " polygons, at most " << maxPolys
+                 << " are supported. Decrease NavMeshSettings::tileSize";
+      success = false;
+      break;
+    }
+  }
+
+  if (!success) {
+    for (TileBuildResult& result : results) {
+      dtFree(result.navData);
+      result.navData = nullptr;
+    }
+  }
+  return success;
+}
+
+bool PathFinder::Impl::addTiles(dtNavMesh* navMesh,
+                                std::vector<TileBuildResult>& results,
+                                std::vector<const dtMeshTile*>& addedTiles) {
+  if (!checkTiles(navMesh, results))
+    return false;
+
+  bool success = true;
+  for (TileBuildResult& result : results) {
+    if (!result.navData)
+      continue;
+
+    dtTileRef tileRef = 0;
+    if (success) {
+      dtStatus status = navMesh->addTile(result.navData, result.navDataSize,
+                                         DT_TILE_FREE_DATA, 0, &tileRef);
+      if (dtStatusFailed(status)) {
+        LOG(ERROR) << "Could not add tile to Detour navmesh";
+        success = false;
+      }
+    }
+
+    // The navmesh owns the data of tiles it accepted, free everything else
+    if (!success) {
+      dtFree(result.navData);
+      result.navData = nullptr;
+      continue;
+    }
+
+    addedTiles.emplace_back(navMesh->getTileByRef(tileRef));
+  }
+
+  return success;
+}
+
+bool PathFinder::Impl::rebuildTiles(
+    const esp::assets::MeshData& mesh,
+    const std::vector<std::pair<vec3f, vec3f>>& changedBounds) {
+  if (!tileLayout_) {
+    LOG(ERROR) << "PathFinder::rebuildTiles: the navmesh was not built with "
+                  "NavMeshSettings::tileSize > 0";
+    return false;
+  }
+  const TileLayout& layout = *tileLayout_;
+
+  // Geometry inside the border of a tile affects it, so pad the bounds by it
+  std::vector<char> isDirty(layout.tilesX * layout.tilesZ, false);
+  std::vector<int> dirtyTiles;
+  for (const auto& bounds : changedBounds) {
+    const int x0 =
+        layout.tileCoord(bounds.first[0] - layout.borderWorldSize, 0);
+    const int x1 =
+        layout.tileCoord(bounds.second[0] + layout.borderWorldSize, 0);
+    const int z0 =
+        layout.tileCoord(bounds.first[2] - layout.borderWorldSize, 2);
+    const int z1 =
+        layout.tileCoord(bounds.second[2] + layout.borderWorldSize, 2);
+    for (int z = z0; z <= z1; ++z) {
+      for (int x = x0; x <= x1; ++x) {
+        const int tileId = z * layout.tilesX + x;
+        if (!isDirty[tileId]) {
+          isDirty[tileId] = true;
+          dirtyTiles.emplace_back(tileId);
+        }
+      }
+    }
+  }
+
+  if (dirtyTiles.empty())
+    return true;
+
+  std::vector<int> indices(mesh.ibo.begin(), mesh.ibo.end());
+  std::vector<TileBuildResult> results =
+      buildTiles(layout, dirtyTiles, mesh.vbo[0].data(), mesh.vbo.size(),
+                 indices.data(), indices.size() / 3);
+
+  // Leave the live navmesh untouched if any of the tiles failed to build or
+  // doesn't fit into it
+  if (!checkTiles(navMesh_.get(), results))
+    return false;
+
+  LOG(INFO) << "Rebuilding " << dirtyTiles.size() << " of "
+            << layout.tilesX * layout.tilesZ << " navmesh tiles";
+
+  std::vector<dtPolyRef> removedRefs;
+  for (const TileBuildResult& result : results) {
+    const dtTileRef oldRef =
+        navMesh_->getTileRefAt(result.tileX, result.tileZ, 0);
+    if (!oldRef)
+      continue;
+
+    const dtMeshTile* oldTile = navMesh_->getTileByRef(oldRef);
+    const dtPolyRef base = navMesh_->getPolyRefBase(oldTile);
+    for (int jPoly = 0; jPoly < oldTile->header->polyCount; ++jPoly) {
+      removedRefs.emplace_back(base | static_cast<dtPolyRef>(jPoly));
+    }
+    navMeshArea_ -= navigableArea(oldTile);
+
+    navMesh_->removeTile(oldRef, nullptr, nullptr);
+  }
+
+  std::vector<const dtMeshTile*> addedTiles;
+  const bool success = addTiles(navMesh_.get(), results, addedTiles);
+  for (const dtMeshTile* tile : addedTiles) {
+    navMeshArea_ += removeZeroAreaPolys(tile);
+  }
+
+  islandSystem_->updateTiles(filter_.get(), removedRefs, addedTiles);
+  meshData_.reset();
+  distanceOracle_.reset();
+  ++navMeshVersion_;
+  buildSamplingTable();
+
+  return success;
+}
+
+bool PathFinder::Impl::initNavQuery(
+    std::unique_ptr<impl::IslandSystem> islandSystem /*= nullptr*/) {
   // if we are reinitializing the NavQuery, then also reset the MeshData
   meshData_.reset();
+  workerQueries_.clear();
+  workerPathBuffers_.clear();
+  distanceOracle_.reset();
+  ++navMeshVersion_;
 
   navQuery_.reset(dtAllocNavMeshQuery());
   dtStatus status = navQuery_->init(navMesh_.get(), 2048);
@@ -664,8 +1613,31 @@ bool PathFinder::Impl::initNavQuery() {
     return false;
   }
 
-  islandSystem_ =
-      std::make_unique<impl::IslandSystem>(navMesh_.get(), filter_.get());
+  if (islandSystem)
+    islandSystem_ = std::move(islandSystem);
+  else
+    islandSystem_ =
+        std::make_unique<impl::IslandSystem>(navMesh_.get(), filter_.get());
+
+  return true;
+}
+
+bool PathFinder::Impl::initWorkerQueries(const int numWorkers) {
+  while (workerQueries_.size() < static_cast<size_t>(numWorkers)) {
+    std::unique_ptr<dtNavMeshQuery, NavQueryDeleter> query(
+        dtAllocNavMeshQuery());
+    if (!query) {
+      LOG(ERROR) << "Could not allocate Detour navmesh query";
+      return false;
+    }
+    dtStatus status = query->init(navMesh_.get(), 2048);
+    if (dtStatusFailed(status)) {
+      LOG(ERROR) << "Could not init Detour navmesh query";
+      return false;
+    }
+    workerQueries_.emplace_back(std::move(query));
+  }
+  workerPathBuffers_.resize(workerQueries_.size());
 
   return true;
 }
@@ -711,6 +1683,39 @@ struct NavMeshTileHeader {
   int dataSize;
 };
 
+// The cache stores everything loadNavMesh computes after reading the tiles,
+// laid out so that the tiles can be used in place from a file mapping
+const int NAVMESHCACHE_MAGIC = 'M' << 24 | 'C' << 16 | 'H' << 8 | 'E';
+const int NAVMESHCACHE_VERSION = 1;
+
+struct NavMeshCacheHeader {
+  int magic;
+  int version;
+  int numTiles;
+  dtNavMeshParams params;
+  float bmin[3];
+  float bmax[3];
+  //! Navigable area, with zero area polygons already disabled in the tiles
+  float navMeshArea;
+  uint32_t numIslands;
+  //! Offset of the float[numIslands] island radii
+  uint64_t islandRadiiOffset;
+};
+
+// Follow the NavMeshCacheHeader, one per tile
+struct NavMeshCacheTileHeader {
+  dtTileRef tileRef;
+  int dataSize;
+  //! Offset of the tile data, aligned for Detour
+  uint64_t dataOffset;
+  //! Offset of the uint32_t[polyCount] island of each polygon of the tile
+  uint64_t islandsOffset;
+};
+
+uint64_t alignOffset(uint64_t offset, uint64_t alignment) {
+  return (offset + alignment - 1) / alignment * alignment;
+}
+
 struct Triangle {
   std::vector<vec3f> v;
   Triangle() { v.resize(3); }
@@ -746,10 +1751,22 @@ float polyArea(const dtPoly* poly, const dtMeshTile* tile) {
   std::vector<Triangle> triangles = getPolygonTriangles(poly, tile);
 
   float area = 0;
-  for (auto& tri : triangles) {
-    const vec3f w1 = tri.v[1] - tri.v[0];
-    const vec3f w2 = tri.v[2] - tri.v[1];
-    area += 0.5 * w1.cross(w2).norm();
+  for (auto& tri : triangles) {
+    const vec3f w1 = tri.v[1] - tri.v[0];
+    const vec3f w2 = tri.v[2] - tri.v[1];
+    area += 0.5 * w1.cross(w2).norm();
+  }
+
+  return area;
+}
+
+// Total area of the walkable polygons of a tile
+float navigableArea(const dtMeshTile* tile) {
+  float area = 0;
+  for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
+    const dtPoly* poly = &tile->polys[jPoly];
+    if (poly->flags & POLYFLAGS_WALK)
+      area += polyArea(poly, tile);
   }
 
   return area;
@@ -766,28 +1783,38 @@ void PathFinder::Impl::removeZeroAreaPolys() {
   for (int iTile = 0; iTile < navMesh_->getMaxTiles(); ++iTile) {
     const dtMeshTile* tile =
         const_cast<const dtNavMesh*>(navMesh_.get())->getTile(iTile);
-    if (!tile)
+    if (!tile || !tile->header)
       continue;
 
-    // Iterate over all polygons in a tile
-    for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
-      // Get the polygon reference from the tile and polygon id
-      dtPolyRef polyRef = navMesh_->encodePolyId(tile->salt, iTile, jPoly);
-      const dtPoly* poly = nullptr;
-      const dtMeshTile* tmp = nullptr;
-      navMesh_->getTileAndPolyByRefUnsafe(polyRef, &tmp, &poly);
-
-      CORRADE_INTERNAL_ASSERT(poly != nullptr);
-      CORRADE_INTERNAL_ASSERT(tmp != nullptr);
-
-      float polygonArea = polyArea(poly, tile);
-      if (polygonArea < 1e-5) {
-        navMesh_->setPolyFlags(polyRef, POLYFLAGS_DISABLED);
-      } else if (poly->flags & POLYFLAGS_WALK) {
-        navMeshArea_ += polygonArea;
-      }
+    navMeshArea_ += removeZeroAreaPolys(tile);
+  }
+}
+
+// Same as above for a single tile, returns the navigable area of the tile
+float PathFinder::Impl::removeZeroAreaPolys(const dtMeshTile* tile) {
+  float tileArea = 0;
+  const dtPolyRef base = navMesh_->getPolyRefBase(tile);
+
+  // Iterate over all polygons in a tile
+  for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
+    // Get the polygon reference from the tile and polygon id
+    dtPolyRef polyRef = base | static_cast<dtPolyRef>(jPoly);
+    const dtPoly* poly = nullptr;
+    const dtMeshTile* tmp = nullptr;
+    navMesh_->getTileAndPolyByRefUnsafe(polyRef, &tmp, &poly);
+
+    CORRADE_INTERNAL_ASSERT(poly != nullptr);
+    CORRADE_INTERNAL_ASSERT(tmp != nullptr);
+
+    float polygonArea = polyArea(poly, tile);
+    if (polygonArea < 1e-5) {
+      navMesh_->setPolyFlags(polyRef, POLYFLAGS_DISABLED);
+    } else if (poly->flags & POLYFLAGS_WALK) {
+      tileArea += polygonArea;
     }
   }
+
+  return tileArea;
 }
 
 bool PathFinder::Impl::loadNavMesh(const std::string& path) {
@@ -863,11 +1890,17 @@ bool PathFinder::Impl::loadNavMesh(const std::string& path) {
   fclose(fp);
 
   navMesh_.reset(mesh);
+  navMeshMapping_ = nullptr;
+  tileLayout_ = Cr::Containers::NullOpt;
   bounds_ = std::make_pair(bmin, bmax);
 
   removeZeroAreaPolys();
 
-  return initNavQuery();
+  if (!initNavQuery())
+    return false;
+
+  buildSamplingTable();
+  return true;
 }
 
 bool PathFinder::Impl::saveNavMesh(const std::string& path) {
@@ -912,41 +1945,237 @@ bool PathFinder::Impl::saveNavMesh(const std::string& path) {
   return true;
 }
 
+bool PathFinder::Impl::loadNavMeshCache(const std::string& path) {
+  std::unique_ptr<impl::FileMapping> mapping = impl::FileMapping::open(path);
+  if (!mapping)
+    return false;
+
+  unsigned char* const fileData = mapping->data();
+  const uint64_t fileSize = mapping->size();
+  const auto inFile = [fileSize](uint64_t offset, uint64_t size) {
+    return offset <= fileSize && size <= fileSize - offset;
+  };
+
+  if (!inFile(0, sizeof(NavMeshCacheHeader)))
+    return false;
+  const auto& header = *reinterpret_cast<NavMeshCacheHeader*>(fileData);
+  if (header.magic != NAVMESHCACHE_MAGIC ||
+      header.version != NAVMESHCACHE_VERSION || header.numTiles < 0 ||
+      !inFile(sizeof(NavMeshCacheHeader),
+              uint64_t(header.numTiles) * sizeof(NavMeshCacheTileHeader)) ||
+      !inFile(header.islandRadiiOffset,
+              uint64_t(header.numIslands) * sizeof(float)))
+    return false;
+  const auto* tileHeaders = reinterpret_cast<NavMeshCacheTileHeader*>(
+      fileData + sizeof(NavMeshCacheHeader));
+
+  std::unique_ptr<dtNavMesh, NavMeshDeleter> mesh{dtAllocNavMesh()};
+  if (!mesh)
+    return false;
+  dtStatus status = mesh->init(&header.params);
+  if (dtStatusFailed(status))
+    return false;
+
+  const float* islandRadii =
+      reinterpret_cast<const float*>(fileData + header.islandRadiiOffset);
+  auto islandSystem = std::make_unique<impl::IslandSystem>(
+      mesh.get(),
+      std::vector<float>(islandRadii, islandRadii + header.numIslands));
+
+  for (int i = 0; i < header.numTiles; ++i) {
+    const NavMeshCacheTileHeader& tileHeader = tileHeaders[i];
+    if (tileHeader.dataSize <= 0 ||
+        !inFile(tileHeader.dataOffset, tileHeader.dataSize))
+      return false;
+
+    // The tile is used in place. Detour only writes its links, so only those
+    // pages get copied.
+    dtTileRef tileRef = 0;
+    status = mesh->addTile(fileData + tileHeader.dataOffset,
+                           tileHeader.dataSize, 0, tileHeader.tileRef,
+                           &tileRef);
+    if (dtStatusFailed(status))
+      return false;
+
+    const dtMeshTile* tile = mesh->getTileByRef(tileRef);
+    const int polyCount = tile->header->polyCount;
+    if (!inFile(tileHeader.islandsOffset, polyCount * sizeof(uint32_t)))
+      return false;
+
+    const uint32_t* islands =
+        reinterpret_cast<const uint32_t*>(fileData + tileHeader.islandsOffset);
+    const dtPolyRef base = mesh->getPolyRefBase(tile);
+    for (int jPoly = 0; jPoly < polyCount; ++jPoly) {
+      if (islands[jPoly] != impl::IslandSystem::NO_ISLAND)
+        islandSystem->setIsland(base | static_cast<dtPolyRef>(jPoly),
+                                islands[jPoly]);
+    }
+  }
+
+  // Release the current navmesh before the mapping backing it, if any
+  navMesh_ = std::move(mesh);
+  navMeshMapping_ = std::move(mapping);
+  tileLayout_ = Cr::Containers::NullOpt;
+  bounds_ = std::make_pair(vec3f(header.bmin), vec3f(header.bmax));
+  navMeshArea_ = header.navMeshArea;
+
+  if (!initNavQuery(std::move(islandSystem)))
+    return false;
+
+  buildSamplingTable();
+  return true;
+}
+
+bool PathFinder::Impl::saveNavMeshCache(const std::string& path) {
+  const dtNavMesh* navMesh = navMesh_.get();
+  if (!navMesh)
+    return false;
+
+  std::vector<const dtMeshTile*> tiles;
+  for (int i = 0; i < navMesh->getMaxTiles(); ++i) {
+    const dtMeshTile* tile = navMesh->getTile(i);
+    if (!tile || !tile->header || !tile->dataSize)
+      continue;
+    tiles.emplace_back(tile);
+  }
+
+  // Lay out the tile data and islands after the headers
+  std::vector<NavMeshCacheTileHeader> tileHeaders(tiles.size());
+  uint64_t offset = sizeof(NavMeshCacheHeader) +
+                    tiles.size() * sizeof(NavMeshCacheTileHeader);
+  for (size_t i = 0; i < tiles.size(); ++i) {
+    tileHeaders[i].tileRef = navMesh->getTileRef(tiles[i]);
+    tileHeaders[i].dataSize = tiles[i]->dataSize;
+    tileHeaders[i].dataOffset = alignOffset(offset, 16);
+    offset = tileHeaders[i].dataOffset + tiles[i]->dataSize;
+    tileHeaders[i].islandsOffset = alignOffset(offset, 4);
+    offset = tileHeaders[i].islandsOffset +
+             tiles[i]->header->polyCount * sizeof(uint32_t);
+  }
+
+  const std::vector<float>& islandRadii = islandSystem_->islandRadii();
+
+  NavMeshCacheHeader header{};
+  header.magic = NAVMESHCACHE_MAGIC;
+  header.version = NAVMESHCACHE_VERSION;
+  header.numTiles = tiles.size();
+  memcpy(&header.params, navMesh->getParams(), sizeof(dtNavMeshParams));
+  Eigen::Map<vec3f>(header.bmin) = bounds_.first;
+  Eigen::Map<vec3f>(header.bmax) = bounds_.second;
+  header.navMeshArea = navMeshArea_;
+  header.numIslands = islandRadii.size();
+  header.islandRadiiOffset = alignOffset(offset, 4);
+
+  FILE* fp = fopen(path.c_str(), "wb");
+  if (!fp)
+    return false;
+
+  // Seeking past the end zero-fills the alignment padding
+  bool success = fwrite(&header, sizeof(header), 1, fp) == 1;
+  success &= fwrite(tileHeaders.data(), sizeof(NavMeshCacheTileHeader),
+                    tileHeaders.size(), fp) == tileHeaders.size();
+
+  std::vector<uint32_t> islands;
+  for (size_t i = 0; i < tiles.size() && success; ++i) {
+    const dtMeshTile* tile = tiles[i];
+    success &= fseek(fp, tileHeaders[i].dataOffset, SEEK_SET) == 0;
+    success &= fwrite(tile->data, tile->dataSize, 1, fp) == 1;
+
+    const dtPolyRef base = navMesh->getPolyRefBase(tile);
+    islands.resize(tile->header->polyCount);
+    for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
+      islands[jPoly] =
+          islandSystem_->islandOf(base | static_cast<dtPolyRef>(jPoly));
+    }
+    success &= fseek(fp, tileHeaders[i].islandsOffset, SEEK_SET) == 0;
+    success &= fwrite(islands.data(), sizeof(uint32_t), islands.size(), fp) ==
+               islands.size();
+  }
+
+  success &= fseek(fp, header.islandRadiiOffset, SEEK_SET) == 0;
+  success &= fwrite(islandRadii.data(), sizeof(float), islandRadii.size(),
+                    fp) == islandRadii.size();
+
+  fclose(fp);
+
+  return success;
+}
+
 void PathFinder::Impl::seed(uint32_t newSeed) {
-  // TODO: this should be using core::Random instead, but passing function
-  // to navQuery_->findRandomPoint needs to be figured out first
-  srand(newSeed);
+  random_.seed(newSeed);
+}
+
+void PathFinder::Impl::buildSamplingTable() {
+  samplingTriVerts_.clear();
+  samplingAreaSums_.clear();
+
+  double areaSum = 0;
+  for (int iTile = 0; iTile < navMesh_->getMaxTiles(); ++iTile) {
+    const dtMeshTile* tile =
+        const_cast<const dtNavMesh*>(navMesh_.get())->getTile(iTile);
+    if (!tile || !tile->header)
+      continue;
+
+    const dtPolyRef base = navMesh_->getPolyRefBase(tile);
+    for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
+      const dtPoly* poly = &tile->polys[jPoly];
+      if (!filter_->passFilter(base | static_cast<dtPolyRef>(jPoly), tile,
+                               poly))
+        continue;
+
+      for (const Triangle& tri : getPolygonTriangles(poly, tile)) {
+        const float area =
+            0.5 * (tri.v[1] - tri.v[0]).cross(tri.v[2] - tri.v[0]).norm();
+        if (area <= 0)
+          continue;
+
+        areaSum += area;
+        samplingTriVerts_.insert(samplingTriVerts_.end(), tri.v.begin(),
+                                 tri.v.end());
+        samplingAreaSums_.emplace_back(areaSum);
+      }
+    }
+  }
 }
 
-// Returns a random number [0..1]
-static float frand() {
-  return static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+vec3f PathFinder::Impl::sampleNavigablePoint() {
+  // Pick a triangle with probability proportional to its area
+  const double r = random_.uniform_float_01() * samplingAreaSums_.back();
+  const size_t iTri = std::min<size_t>(
+      std::upper_bound(samplingAreaSums_.begin(), samplingAreaSums_.end(), r) -
+          samplingAreaSums_.begin(),
+      samplingAreaSums_.size() - 1);
+
+  // and a uniformly distributed point on it
+  const vec3f* v = &samplingTriVerts_[3 * iTri];
+  const float a = std::sqrt(random_.uniform_float_01());
+  const float b = random_.uniform_float_01();
+  return (1 - a) * v[0] + a * (1 - b) * v[1] + a * b * v[2];
 }
 
-vec3f PathFinder::Impl::getRandomNavigablePoint(const int maxTries /*= 10*/) {
-  if (getNavigableArea() <= 0.0)
+vec3f PathFinder::Impl::getRandomNavigablePoint(const int /*maxTries*/) {
+  if (getNavigableArea() <= 0.0 || samplingAreaSums_.empty())
     throw std::runtime_error(
         "NavMesh has no navigable area, this indicates an issue with the "
         "NavMesh");
 
-  vec3f pt;
+  return sampleNavigablePoint();
+}
 
-  int i = 0;
-  for (i = 0; i < maxTries; ++i) {
-    dtPolyRef ref = 0;
-    dtStatus status =
-        navQuery_->findRandomPoint(filter_.get(), frand, &ref, pt.data());
-    if (dtStatusSucceed(status))
-      break;
-  }
+std::vector<vec3f> PathFinder::Impl::getRandomNavigablePoints(
+    const int numPoints) {
+  if (getNavigableArea() <= 0.0 || samplingAreaSums_.empty())
+    throw std::runtime_error(
+        "NavMesh has no navigable area, this indicates an issue with the "
+        "NavMesh");
 
-  if (i == maxTries) {
-    LOG(ERROR) << "Failed to getRandomNavigablePoint.  Try increasing max "
-                  "tries if the navmesh is fine but just hard to sample from";
-    return vec3f::Constant(Mn::Constants::nan());
-  } else {
-    return pt;
+  std::vector<vec3f> points;
+  points.reserve(numPoints);
+  for (int i = 0; i < numPoints; ++i) {
+    points.emplace_back(sampleNavigablePoint());
   }
+
+  return points;
 }
 
 namespace {
@@ -965,27 +2194,110 @@ float pathLength(const std::vector<vec3f>& points) {
 }  // namespace
 
 bool PathFinder::Impl::findPath(ShortestPath& path) {
+  return findPath(path, navQuery_.get(), pathBuffers_);
+}
+
+bool PathFinder::Impl::findPath(ShortestPath& path,
+                                dtNavMeshQuery* navQuery,
+                                PathBuffers& buffers) {
   MultiGoalShortestPath tmp;
   tmp.requestedStart = path.requestedStart;
   tmp.setRequestedEnds({path.requestedEnd});
+  // Reuse the storage of the previous result
+  tmp.points = std::move(path.points);
 
-  bool status = findPath(tmp);
+  bool status = findPath(tmp, navQuery, buffers);
 
   path.geodesicDistance = tmp.geodesicDistance;
   path.points = std::move(tmp.points);
   return status;
 }
 
-Cr::Containers::Optional<std::tuple<float, std::vector<vec3f>>>
-PathFinder::Impl::findPathInternal(const vec3f& start,
-                                   dtPolyRef startRef,
+std::vector<bool> PathFinder::Impl::findPaths(
+    std::vector<ShortestPath>& paths) {
+  const int numPaths = paths.size();
+  if (numPaths == 0)
+    return {};
+
+  const int numWorkers = std::min(maxWorkers(), numPaths);
+  if (!initWorkerQueries(numWorkers)) {
+    for (auto& path : paths) {
+      path.geodesicDistance = std::numeric_limits<float>::infinity();
+      path.points.clear();
+    }
+    return std::vector<bool>(numPaths, false);
+  }
+
+  // std::vector<bool> packs bits, so concurrent writes to different elements
+  // would race. Collect into bytes and convert afterwards.
+  std::vector<char> found(numPaths, false);
+
+#pragma omp parallel for schedule(dynamic, 16) num_threads(numWorkers)
+  for (int i = 0; i < numPaths; ++i) {
+    const int worker = workerIndex();
+    found[i] = findPath(paths[i], workerQueries_[worker].get(),
+                        workerPathBuffers_[worker]);
+  }
+
+  return std::vector<bool>(found.begin(), found.end());
+}
+
+int PathFinder::Impl::findPolyPath(dtNavMeshQuery* navQuery,
+                                   const dtPolyRef startRef,
                                    const vec3f& pathStart,
-                                   const vec3f& end,
-                                   dtPolyRef endRef,
-                                   const vec3f& pathEnd) {
+                                   const dtPolyRef endRef,
+                                   const vec3f& pathEnd,
+                                   std::vector<dtPolyRef>& polys) {
+  // Largest node pool a query can address
+  static const int MAX_NODES = DT_NULL_IDX;
+
+  while (true) {
+    int numPolys = 0;
+    const dtStatus status = navQuery->findPath(
+        startRef, endRef, pathStart.data(), pathEnd.data(), filter_.get(),
+        polys.data(), &numPolys, static_cast<int>(polys.size()));
+    if (dtStatusFailed(status) || numPolys == 0)
+      return 0;
+
+    // The corridor did not fit, search again with room for a longer one
+    if (dtStatusDetail(status, DT_BUFFER_TOO_SMALL)) {
+      polys.resize(2 * polys.size());
+      continue;
+    }
+
+    // The search gave up before reaching the end, retry with a larger pool
+    if (dtStatusDetail(status, DT_OUT_OF_NODES)) {
+      const int maxNodes = navQuery->getNodePool()->getMaxNodes();
+      if (maxNodes < MAX_NODES &&
+          dtStatusSucceed(navQuery->init(navMesh_.get(),
+                                         std::min(2 * maxNodes, MAX_NODES))))
+        continue;
+
+      return 0;
+    }
+
+    if (status != DT_SUCCESS)
+      return 0;
+
+    return numPolys;
+  }
+}
+
+Cr::Containers::Optional<float> PathFinder::Impl::findPathInternal(
+    dtNavMeshQuery* navQuery,
+    PathBuffers& buffers,
+    const vec3f& start,
+    dtPolyRef startRef,
+    const vec3f& pathStart,
+    const vec3f& end,
+    dtPolyRef endRef,
+    const vec3f& pathEnd) {
   // check if trivial path (start is same as end) and early return
   if (pathStart.isApprox(pathEnd)) {
-    return std::make_tuple(0.0f, std::vector<vec3f>{pathStart, pathEnd});
+    buffers.points[0] = pathStart;
+    buffers.points[1] = pathEnd;
+    buffers.numPoints = 2;
+    return 0.0f;
   }
 
   // Check if there is a path between the start and any of the ends
@@ -993,34 +2305,37 @@ PathFinder::Impl::findPathInternal(const vec3f& start,
     return Cr::Containers::NullOpt;
   }
 
-  static const int MAX_POLYS = 256;
-  dtPolyRef polys[MAX_POLYS];
-
-  int numPolys = 0;
-  dtStatus status =
-      navQuery_->findPath(startRef, endRef, pathStart.data(), pathEnd.data(),
-                          filter_.get(), polys, &numPolys, MAX_POLYS);
-  if (status != DT_SUCCESS || numPolys == 0) {
+  const int numPolys = findPolyPath(navQuery, startRef, pathStart, endRef,
+                                    pathEnd, buffers.polys);
+  if (numPolys == 0) {
     return Cr::Containers::NullOpt;
   }
 
+  // The straight path has at most one corner per portal plus both end points
+  if (buffers.points.size() < static_cast<size_t>(numPolys) + 1)
+    buffers.points.resize(numPolys + 1);
+
   int numPoints = 0;
-  std::vector<vec3f> points(MAX_POLYS);
-  status = navQuery_->findStraightPath(start.data(), end.data(), polys,
-                                       numPolys, points[0].data(), nullptr,
-                                       nullptr, &numPoints, MAX_POLYS);
+  dtStatus status = navQuery->findStraightPath(
+      start.data(), end.data(), buffers.polys.data(), numPolys,
+      buffers.points[0].data(), nullptr, nullptr, &numPoints,
+      static_cast<int>(buffers.points.size()));
   if (status != DT_SUCCESS || numPoints == 0) {
     return Corrade::Containers::NullOpt;
   }
 
-  points.resize(numPoints);
+  buffers.numPoints = numPoints;
 
-  const float length = pathLength(points);
+  float length = 0.0f;
+  for (int i = 1; i < numPoints; ++i) {
+    length += (buffers.points[i] - buffers.points[i - 1]).norm();
+  }
 
-  return std::make_tuple(length, std::move(points));
+  return length;
 }
 
-bool PathFinder::Impl::findPathSetup(MultiGoalShortestPath& path,
+bool PathFinder::Impl::findPathSetup(dtNavMeshQuery* navQuery,
+                                     MultiGoalShortestPath& path,
                                      dtPolyRef& startRef,
                                      vec3f& pathStart) {
   path.geodesicDistance = std::numeric_limits<float>::infinity();
@@ -1029,7 +2344,7 @@ bool PathFinder::Impl::findPathSetup(MultiGoalShortestPath& path,
   // find nearest polys and path
   dtStatus status = 0;
   std::tie(status, startRef, pathStart) =
-      projectToPoly(path.requestedStart, navQuery_.get(), filter_.get());
+      projectToPoly(path.requestedStart, navQuery, filter_.get());
 
   if (status != DT_SUCCESS || startRef == 0) {
     return false;
@@ -1042,7 +2357,7 @@ bool PathFinder::Impl::findPathSetup(MultiGoalShortestPath& path,
     dtPolyRef endRef = 0;
     vec3f pathEnd;
     std::tie(status, endRef, pathEnd) =
-        projectToPoly(rqEnd, navQuery_.get(), filter_.get());
+        projectToPoly(rqEnd, navQuery, filter_.get());
 
     if (status != DT_SUCCESS || endRef == 0) {
       return false;
@@ -1056,9 +2371,15 @@ bool PathFinder::Impl::findPathSetup(MultiGoalShortestPath& path,
 }
 
 bool PathFinder::Impl::findPath(MultiGoalShortestPath& path) {
+  return findPath(path, navQuery_.get(), pathBuffers_);
+}
+
+bool PathFinder::Impl::findPath(MultiGoalShortestPath& path,
+                                dtNavMeshQuery* navQuery,
+                                PathBuffers& buffers) {
   dtPolyRef startRef = 0;
   vec3f pathStart;
-  if (!findPathSetup(path, startRef, pathStart))
+  if (!findPathSetup(navQuery, path, startRef, pathStart))
     return false;
 
   if (path.pimpl_->requestedEnds.size() > 1) {
@@ -1069,7 +2390,7 @@ bool PathFinder::Impl::findPath(MultiGoalShortestPath& path) {
     ShortestPath prevPath;
     prevPath.requestedStart = path.requestedStart;
     prevPath.requestedEnd = path.pimpl_->prevRequestedStart;
-    findPath(prevPath);
+    findPath(prevPath, navQuery, buffers);
     const float movedAmount = prevPath.geodesicDistance;
 
     for (int i = 0; i < path.pimpl_->requestedEnds.size(); ++i) {
@@ -1094,22 +2415,133 @@ bool PathFinder::Impl::findPath(MultiGoalShortestPath& path) {
     if (path.pimpl_->minTheoreticalDist[i] > path.geodesicDistance)
       continue;
 
-    const Cr::Containers::Optional<std::tuple<float, std::vector<vec3f>>>
-        findResult =
-            findPathInternal(path.requestedStart, startRef, pathStart,
-                             path.pimpl_->requestedEnds[i],
-                             path.pimpl_->endRefs[i], path.pimpl_->pathEnds[i]);
+    const Cr::Containers::Optional<float> findResult = findPathInternal(
+        navQuery, buffers, path.requestedStart, startRef, pathStart,
+        path.pimpl_->requestedEnds[i], path.pimpl_->endRefs[i],
+        path.pimpl_->pathEnds[i]);
 
-    if (findResult && std::get<0>(*findResult) < path.geodesicDistance) {
-      path.pimpl_->minTheoreticalDist[i] = std::get<0>(*findResult);
-      path.geodesicDistance = std::get<0>(*findResult);
-      path.points = std::get<1>(*findResult);
+    if (findResult && *findResult < path.geodesicDistance) {
+      path.pimpl_->minTheoreticalDist[i] = *findResult;
+      path.geodesicDistance = *findResult;
+      path.points.assign(buffers.points.begin(),
+                         buffers.points.begin() + buffers.numPoints);
     }
   }
 
   return path.geodesicDistance < std::numeric_limits<float>::infinity();
 }
 
+bool PathFinder::Impl::findPath(PathCorridor& path) {
+  path.geodesicDistance = std::numeric_limits<float>::infinity();
+  path.points.clear();
+
+  PathCorridor::Impl& corridor = *path.pimpl_;
+
+  dtStatus status = 0;
+  dtPolyRef startRef = 0, endRef = 0;
+  vec3f pathStart, pathEnd;
+  std::tie(status, startRef, pathStart) =
+      projectToPoly(path.requestedStart, navQuery_.get(), filter_.get());
+  if (status == DT_SUCCESS && startRef != 0)
+    std::tie(status, endRef, pathEnd) =
+        projectToPoly(path.requestedEnd, navQuery_.get(), filter_.get());
+  if (status != DT_SUCCESS || startRef == 0 || endRef == 0 ||
+      !islandSystem_->hasConnection(startRef, endRef)) {
+    corridor.valid = false;
+    return false;
+  }
+
+  // Maximum number of polygons dtPathCorridor::movePosition and
+  // moveTargetPosition can add to the corridor in a single move
+  static const int MAX_VISITED = 16;
+  const auto xzDistance = [](const float* a, const vec3f& b) {
+    return std::hypot(a[0] - b[0], a[2] - b[2]);
+  };
+
+  bool replan = !corridor.valid || corridor.owner != this ||
+                corridor.navMeshVersion != navMeshVersion_ ||
+                xzDistance(corridor.corridor.getPos(), pathStart) >
+                    path.maxUpdateDistance ||
+                xzDistance(corridor.corridor.getTarget(), pathEnd) >
+                    path.maxUpdateDistance;
+  if (!replan && corridor.corridor.getPathCount() + 2 * MAX_VISITED >
+                     corridor.capacity) {
+    // The corridor may be truncated when moving, make room first
+    const std::vector<dtPolyRef> polys(
+        corridor.corridor.getPath(),
+        corridor.corridor.getPath() + corridor.corridor.getPathCount());
+    const vec3f pos = Eigen::Map<const vec3f>(corridor.corridor.getPos());
+    const vec3f target =
+        Eigen::Map<const vec3f>(corridor.corridor.getTarget());
+
+    corridor.capacity = 2 * (static_cast<int>(polys.size()) + 2 * MAX_VISITED);
+    corridor.corridor.init(corridor.capacity);
+    corridor.corridor.reset(polys.front(), pos.data());
+    corridor.corridor.setCorridor(target.data(), polys.data(),
+                                  static_cast<int>(polys.size()));
+  }
+
+  if (!replan) {
+    // Move both ends of the corridor along the navmesh surface. This only
+    // follows motions along the surface; if either end ends up somewhere
+    // else, e.g. on the other side of a wall, search for a new corridor.
+    corridor.corridor.movePosition(pathStart.data(), navQuery_.get(),
+                                   filter_.get());
+    corridor.corridor.moveTargetPosition(pathEnd.data(), navQuery_.get(),
+                                         filter_.get());
+    replan = xzDistance(corridor.corridor.getPos(), pathStart) > 1e-3f ||
+             xzDistance(corridor.corridor.getTarget(), pathEnd) > 1e-3f;
+
+    // Shortcut detours the corridor picked up while the agent moved
+    if (!replan)
+      corridor.corridor.optimizePathTopology(navQuery_.get(), filter_.get());
+  }
+
+  if (replan) {
+    const int numPolys = findPolyPath(navQuery_.get(), startRef, pathStart,
+                                      endRef, pathEnd, pathBuffers_.polys);
+    if (numPolys == 0) {
+      corridor.valid = false;
+      return false;
+    }
+
+    if (corridor.capacity < numPolys + 2 * MAX_VISITED) {
+      corridor.capacity = 2 * (numPolys + 2 * MAX_VISITED);
+      corridor.corridor.init(corridor.capacity);
+    }
+    corridor.corridor.reset(startRef, pathStart.data());
+    corridor.corridor.setCorridor(pathEnd.data(), pathBuffers_.polys.data(),
+                                  numPolys);
+
+    corridor.owner = this;
+    corridor.navMeshVersion = navMeshVersion_;
+    corridor.valid = true;
+  }
+
+  const int maxCorners = corridor.corridor.getPathCount() + 1;
+  if (corridor.corners.size() < static_cast<size_t>(maxCorners)) {
+    corridor.corners.resize(maxCorners);
+    corridor.cornerFlags.resize(maxCorners);
+    corridor.cornerPolys.resize(maxCorners);
+  }
+  const int numCorners = corridor.corridor.findCorners(
+      corridor.corners[0].data(), corridor.cornerFlags.data(),
+      corridor.cornerPolys.data(), maxCorners, navQuery_.get(), filter_.get());
+
+  // findCorners leaves out the current position, and the target as well once
+  // it is reached
+  path.points.emplace_back(Eigen::Map<const vec3f>(corridor.corridor.getPos()));
+  path.points.insert(path.points.end(), corridor.corners.begin(),
+                     corridor.corners.begin() + numCorners);
+  if (numCorners == 0)
+    path.points.emplace_back(
+        Eigen::Map<const vec3f>(corridor.corridor.getTarget()));
+
+  path.geodesicDistance = pathLength(path.points);
+
+  return true;
+}
+
 template <typename T>
 T PathFinder::Impl::tryStep(const T& start, const T& end, bool allowSliding) {
   static const int MAX_POLYS = 256;
@@ -1257,6 +2689,71 @@ bool PathFinder::Impl::isNavigable(const vec3f& pt,
   return true;
 }
 
+PointsQueryResult PathFinder::Impl::queryPoints(
+    const Eigen::Ref<const Eigen::RowMatrixXf>& points,
+    const float maxYDelta,
+    const float maxSearchRadius,
+    const bool computeDistances) {
+  if (points.cols() != 3)
+    throw std::runtime_error("Expected an N x 3 matrix of points");
+
+  const int numPoints = points.rows();
+  PointsQueryResult result;
+  result.snappedPoints.resize(numPoints, 3);
+  result.navigable.resize(numPoints);
+  if (computeDistances)
+    result.distancesToClosestObstacle.resize(numPoints);
+  if (numPoints == 0)
+    return result;
+
+  const int numWorkers = std::min(maxWorkers(), numPoints);
+  if (!initWorkerQueries(numWorkers))
+    throw std::runtime_error("Could not create navmesh queries");
+
+#pragma omp parallel for schedule(dynamic, 64) num_threads(numWorkers)
+  for (int i = 0; i < numPoints; ++i) {
+    const dtNavMeshQuery* navQuery = workerQueries_[workerIndex()].get();
+    const vec3f pt = points.row(i).transpose();
+
+    // A single projection is shared by all of the queries, each of which
+    // then matches its single point version
+    dtStatus status = 0;
+    dtPolyRef ptRef = 0;
+    vec3f polyPt;
+    std::tie(status, ptRef, polyPt) =
+        projectToPoly(pt, navQuery, filter_.get());
+
+    // snapPoint
+    result.snappedPoints.row(i) =
+        dtStatusSucceed(status) ? polyPt.transpose()
+                                : Eigen::RowVector3f::Constant(
+                                      Mn::Constants::nan());
+
+    const bool found = status == DT_SUCCESS && ptRef != 0;
+
+    // isNavigable
+    result.navigable[i] =
+        found && std::abs(polyPt[1] - pt[1]) <= maxYDelta &&
+        (Eigen::Vector2f(pt[0], pt[2]) - Eigen::Vector2f(polyPt[0], polyPt[2]))
+                .norm() <= 1e-2;
+
+    // distanceToClosestObstacle
+    if (computeDistances) {
+      float hitDist = std::numeric_limits<float>::infinity();
+      if (found) {
+        vec3f hitPos, hitNormal;
+        hitDist = NAN;
+        navQuery->findDistanceToWall(ptRef, polyPt.data(), maxSearchRadius,
+                                     filter_.get(), &hitDist, hitPos.data(),
+                                     hitNormal.data());
+      }
+      result.distancesToClosestObstacle[i] = hitDist;
+    }
+  }
+
+  return result;
+}
+
 typedef Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic> MatrixXb;
 
 Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic>
@@ -1272,18 +2769,134 @@ PathFinder::Impl::getTopDownView(const float metersPerPixel,
   int zResolution = zspan / metersPerPixel;
   float startx = fmin(bound1[0], bound2[0]);
   float startz = fmin(bound1[2], bound2[2]);
-  MatrixXb topdownMap(zResolution, xResolution);
-
-  float curz = startz;
-  float curx = startx;
-  for (int h = 0; h < zResolution; h++) {
-    for (int w = 0; w < xResolution; w++) {
-      vec3f point = vec3f(curx, height, curz);
-      topdownMap(h, w) = isNavigable(point, 0.5);
-      curx = curx + metersPerPixel;
+  MatrixXb topdownMap = MatrixXb::Zero(zResolution, xResolution);
+  if (!isLoaded() || xResolution <= 0 || zResolution <= 0)
+    return topdownMap;
+
+  // Pixel (h, w) samples the point (startx + w * metersPerPixel, height,
+  // startz + h * metersPerPixel), which isNavigable(point, 0.5) accepts if it
+  // is within 1cm of a walkable polygon in x-z and the navmesh surface there
+  // is within 0.5 of height. Instead of snapping every pixel, scan-convert the
+  // detail triangles of the walkable polygons directly.
+  constexpr float maxYDelta = 0.5f;
+  constexpr float xzTolerance = 1e-2f;
+
+  std::vector<vec3f> triVerts;
+  for (int iTile = 0; iTile < navMesh_->getMaxTiles(); ++iTile) {
+    const dtMeshTile* tile =
+        const_cast<const dtNavMesh*>(navMesh_.get())->getTile(iTile);
+    if (!tile || !tile->header)
+      continue;
+
+    const dtPolyRef base = navMesh_->getPolyRefBase(tile);
+    for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
+      const dtPoly* poly = &tile->polys[jPoly];
+      if (!filter_->passFilter(base | static_cast<dtPolyRef>(jPoly), tile,
+                               poly))
+        continue;
+
+      for (const Triangle& tri : getPolygonTriangles(poly, tile)) {
+        const float minY = std::min({tri.v[0][1], tri.v[1][1], tri.v[2][1]});
+        const float maxY = std::max({tri.v[0][1], tri.v[1][1], tri.v[2][1]});
+        if (minY > height + maxYDelta || maxY < height - maxYDelta)
+          continue;
+
+        triVerts.insert(triVerts.end(), tri.v.begin(), tri.v.end());
+      }
+    }
+  }
+  const int numTris = triVerts.size() / 3;
+
+  // Bin the triangles by the rows they cover so that rows can be filled
+  // independently
+  const auto rowRange = [&](int iTri) {
+    const vec3f* v = &triVerts[3 * iTri];
+    const float minZ = std::min({v[0][2], v[1][2], v[2][2]}) - xzTolerance;
+    const float maxZ = std::max({v[0][2], v[1][2], v[2][2]}) + xzTolerance;
+    return std::make_pair(
+        std::max(static_cast<int>(std::ceil((minZ - startz) / metersPerPixel)),
+                 0),
+        std::min(
+            static_cast<int>(std::floor((maxZ - startz) / metersPerPixel)),
+            zResolution - 1));
+  };
+
+  std::vector<int> rowOffsets(zResolution + 1, 0);
+  for (int iTri = 0; iTri < numTris; ++iTri) {
+    const std::pair<int, int> rows = rowRange(iTri);
+    for (int h = rows.first; h <= rows.second; ++h)
+      ++rowOffsets[h + 1];
+  }
+  std::partial_sum(rowOffsets.begin(), rowOffsets.end(), rowOffsets.begin());
+
+  std::vector<int> rowTris(rowOffsets.back());
+  {
+    std::vector<int> rowFill(rowOffsets.begin(), rowOffsets.end() - 1);
+    for (int iTri = 0; iTri < numTris; ++iTri) {
+      const std::pair<int, int> rows = rowRange(iTri);
+      for (int h = rows.first; h <= rows.second; ++h)
+        rowTris[rowFill[h]++] = iTri;
+    }
+  }
+
+#pragma omp parallel for schedule(dynamic, 16)
+  for (int h = 0; h < zResolution; ++h) {
+    const float z = startz + h * metersPerPixel;
+
+    for (int iEntry = rowOffsets[h]; iEntry < rowOffsets[h + 1]; ++iEntry) {
+      const vec3f* v = &triVerts[3 * rowTris[iEntry]];
+
+      // Twice the signed area in x-z, which also gives the winding
+      const float area2 = (v[1][0] - v[0][0]) * (v[2][2] - v[0][2]) -
+                          (v[1][2] - v[0][2]) * (v[2][0] - v[0][0]);
+      if (std::abs(area2) < 1e-12f)
+        continue;
+      const float winding = area2 > 0 ? 1.0f : -1.0f;
+
+      // Intersect the row with the triangle grown by xzTolerance: for each
+      // edge, the signed distance of (x, z) to it is linear in x
+      float minX = -std::numeric_limits<float>::infinity();
+      float maxX = std::numeric_limits<float>::infinity();
+      for (int k = 0; k < 3; ++k) {
+        const vec3f& p = v[k];
+        const vec3f& q = v[(k + 1) % 3];
+        const float dx = q[0] - p[0];
+        const float dz = q[2] - p[2];
+        const float len = std::sqrt(dx * dx + dz * dz);
+        // winding * (dx * (z - p.z) - dz * (x - p.x)) >= -xzTolerance * len
+        const float slope = -winding * dz;
+        const float offset =
+            winding * (dx * (z - p[2]) + dz * p[0]) + xzTolerance * len;
+        if (slope > 0)
+          minX = std::max(minX, -offset / slope);
+        else if (slope < 0)
+          maxX = std::min(maxX, -offset / slope);
+        else if (offset < 0)
+          maxX = -std::numeric_limits<float>::infinity();
+      }
+      if (minX > maxX)
+        continue;
+
+      const int minW = std::max(
+          static_cast<int>(std::ceil((minX - startx) / metersPerPixel)), 0);
+      const int maxW = std::min(
+          static_cast<int>(std::floor((maxX - startx) / metersPerPixel)),
+          xResolution - 1);
+
+      // Height of the triangle's plane over (x, z)
+      const vec3f normal = (v[1] - v[0]).cross(v[2] - v[0]);
+      for (int w = minW; w <= maxW; ++w) {
+        if (topdownMap(h, w))
+          continue;
+
+        const float x = startx + w * metersPerPixel;
+        const float y = v[0][1] - (normal[0] * (x - v[0][0]) +
+                                   normal[2] * (z - v[0][2])) /
+                                      normal[1];
+        if (std::abs(y - height) <= maxYDelta)
+          topdownMap(h, w) = true;
+      }
     }
-    curz = curz + metersPerPixel;
-    curx = startx;
   }
 
   return topdownMap;
@@ -1299,7 +2912,7 @@ const assets::MeshData::ptr PathFinder::Impl::getNavMeshData() {
     for (int iTile = 0; iTile < navMesh_->getMaxTiles(); ++iTile) {
       const dtMeshTile* tile =
           const_cast<const dtNavMesh*>(navMesh_.get())->getTile(iTile);
-      if (!tile)
+      if (!tile || !tile->header)
         continue;
 
       // Iterate over all polygons in a tile
@@ -1327,6 +2940,66 @@ const assets::MeshData::ptr PathFinder::Impl::getNavMeshData() {
   return meshData_;
 }
 
+int PathFinder::Impl::addDistanceOracleGoal(const vec3f& goal) {
+  if (!isLoaded())
+    return ID_UNDEFINED;
+
+  dtStatus status = 0;
+  dtPolyRef goalRef = 0;
+  vec3f goalPt;
+  std::tie(status, goalRef, goalPt) =
+      projectToPoly(goal, navQuery_.get(), filter_.get());
+  if (status != DT_SUCCESS || goalRef == 0)
+    return ID_UNDEFINED;
+
+  if (!distanceOracle_)
+    distanceOracle_ =
+        std::make_unique<impl::DistanceOracle>(navMesh_.get(), filter_.get());
+
+  return distanceOracle_->addGoal(navMesh_.get(), goalRef, goalPt);
+}
+
+float PathFinder::Impl::getOracleGeodesicDistance(const vec3f& start,
+                                                  const int goalId) const {
+  if (goalId < 0 || goalId >= getNumDistanceOracleGoals()) {
+    LOG(ERROR) << "Invalid distance oracle goal id " << goalId;
+    return std::numeric_limits<float>::infinity();
+  }
+
+  dtStatus status = 0;
+  dtPolyRef startRef = 0;
+  vec3f startPt;
+  std::tie(status, startRef, startPt) =
+      projectToPoly(start, navQuery_.get(), filter_.get());
+  if (status != DT_SUCCESS || startRef == 0 ||
+      !islandSystem_->hasConnection(startRef,
+                                    distanceOracle_->goalRef(goalId)))
+    return std::numeric_limits<float>::infinity();
+
+  return distanceOracle_->distance(navMesh_.get(), navQuery_.get(),
+                                   filter_.get(), startRef, startPt, goalId);
+}
+
+bool PathFinder::Impl::saveDistanceOracle(const std::string& path) const {
+  if (!distanceOracle_)
+    return false;
+
+  return distanceOracle_->save(path);
+}
+
+bool PathFinder::Impl::loadDistanceOracle(const std::string& path) {
+  if (!isLoaded())
+    return false;
+
+  auto distanceOracle =
+      std::make_unique<impl::DistanceOracle>(navMesh_.get(), filter_.get());
+  if (!distanceOracle->load(path))
+    return false;
+
+  distanceOracle_ = std::move(distanceOracle);
+  return true;
+}
+
 PathFinder::PathFinder() : pimpl_{spimpl::make_unique_impl<Impl>()} {};
 
 bool PathFinder::build(const NavMeshSettings& bs,
@@ -1343,10 +3016,20 @@ bool PathFinder::build(const NavMeshSettings& bs,
   return pimpl_->build(bs, mesh);
 }
 
+bool PathFinder::rebuildTiles(
+    const esp::assets::MeshData& mesh,
+    const std::vector<std::pair<vec3f, vec3f>>& changedBounds) {
+  return pimpl_->rebuildTiles(mesh, changedBounds);
+}
+
 vec3f PathFinder::getRandomNavigablePoint(const int maxTries /*= 10*/) {
   return pimpl_->getRandomNavigablePoint(maxTries);
 }
 
+std::vector<vec3f> PathFinder::getRandomNavigablePoints(const int numPoints) {
+  return pimpl_->getRandomNavigablePoints(numPoints);
+}
+
 bool PathFinder::findPath(ShortestPath& path) {
   return pimpl_->findPath(path);
 }
@@ -1355,6 +3038,14 @@ bool PathFinder::findPath(MultiGoalShortestPath& path) {
   return pimpl_->findPath(path);
 }
 
+bool PathFinder::findPath(PathCorridor& path) {
+  return pimpl_->findPath(path);
+}
+
+std::vector<bool> PathFinder::findPaths(std::vector<ShortestPath>& paths) {
+  return pimpl_->findPaths(paths);
+}
+
 template vec3f PathFinder::tryStep<vec3f>(const vec3f&, const vec3f&);
 template Mn::Vector3 PathFinder::tryStep<Mn::Vector3>(const Mn::Vector3&,
                                                       const Mn::Vector3&);
@@ -1390,6 +3081,14 @@ bool PathFinder::saveNavMesh(const std::string& path) {
   return pimpl_->saveNavMesh(path);
 }
 
+bool PathFinder::loadNavMeshCache(const std::string& path) {
+  return pimpl_->loadNavMeshCache(path);
+}
+
+bool PathFinder::saveNavMeshCache(const std::string& path) {
+  return pimpl_->saveNavMeshCache(path);
+}
+
 bool PathFinder::isLoaded() const {
   return pimpl_->isLoaded();
 }
@@ -1413,6 +3112,32 @@ HitRecord PathFinder::closestObstacleSurfacePoint(
   return pimpl_->closestObstacleSurfacePoint(pt, maxSearchRadius);
 }
 
+PointsQueryResult PathFinder::queryPoints(
+    const Eigen::Ref<const Eigen::RowMatrixXf>& points,
+    const float maxYDelta /*= 0.5*/,
+    const float maxSearchRadius /*= 2.0*/) {
+  return pimpl_->queryPoints(points, maxYDelta, maxSearchRadius, true);
+}
+
+Eigen::RowMatrixXf PathFinder::snapPoints(
+    const Eigen::Ref<const Eigen::RowMatrixXf>& points) {
+  return pimpl_->queryPoints(points, 0.5, 0.0, false).snappedPoints;
+}
+
+Eigen::Matrix<bool, Eigen::Dynamic, 1> PathFinder::areNavigable(
+    const Eigen::Ref<const Eigen::RowMatrixXf>& points,
+    const float maxYDelta /*= 0.5*/) {
+  return pimpl_->queryPoints(points, maxYDelta, 0.0, false).navigable;
+}
+
+Eigen::VectorXf PathFinder::distancesToClosestObstacle(
+    const Eigen::Ref<const Eigen::RowMatrixXf>& points,
+    const float maxSearchRadius /*= 2.0*/) {
+  return pimpl_
+      ->queryPoints(points, 0.5, maxSearchRadius, true)
+      .distancesToClosestObstacle;
+}
+
 bool PathFinder::isNavigable(const vec3f& pt, const float maxYDelta) const {
   return pimpl_->isNavigable(pt, maxYDelta);
 }
@@ -1435,5 +3160,30 @@ const assets::MeshData::ptr PathFinder::getNavMeshData() {
   return pimpl_->getNavMeshData();
 }
 
+int PathFinder::addDistanceOracleGoal(const vec3f& goal) {
+  return pimpl_->addDistanceOracleGoal(goal);
+}
+
+int PathFinder::getNumDistanceOracleGoals() const {
+  return pimpl_->getNumDistanceOracleGoals();
+}
+
+void PathFinder::clearDistanceOracle() {
+  pimpl_->clearDistanceOracle();
+}
+
+float PathFinder::getOracleGeodesicDistance(const vec3f& start,
+                                            const int goalId) const {
+  return pimpl_->getOracleGeodesicDistance(start, goalId);
+}
+
+bool PathFinder::saveDistanceOracle(const std::string& path) const {
+  return pimpl_->saveDistanceOracle(path);
+}
+
+bool PathFinder::loadDistanceOracle(const std::string& path) {
+  return pimpl_->loadDistanceOracle(path);
+}
+
 }  // namespace nav
 }  // namespace esp
@@ -26,6 +26,30 @@ struct HitRecord {
   float hitDist;
 };
 
+/**
+ * @brief Results of @ref PathFinder.queryPoints, one row or entry per queried
+ * point
+ */
+struct PointsQueryResult {
+  /**
+   * @brief The points snapped to the navigation mesh, as by @ref
+   * PathFinder.snapPoint
+   */
+  Eigen::RowMatrixXf snappedPoints;
+
+  /**
+   * @brief Whether or not each point is navigable, as by @ref
+   * PathFinder.isNavigable
+   */
+  Eigen::Matrix<bool, Eigen::Dynamic, 1> navigable;
+
+  /**
+   * @brief The distance of each point to the closest obstacle, as by @ref
+   * PathFinder.distanceToClosestObstacle
+   */
+  Eigen::VectorXf distancesToClosestObstacle;
+};
+
 /**
  * @brief Struct for shortest path finding. Used in conjunction with @ref
  * PathFinder.findPath
@@ -100,6 +124,61 @@ struct MultiGoalShortestPath {
   ESP_SMART_POINTERS_WITH_UNIQUE_PIMPL(MultiGoalShortestPath);
 };
 
+/**
+ * @brief Struct for shortest path finding that keeps the polygon corridor of
+ * the path between calls. Used in conjunction with @ref PathFinder.findPath
+ *
+ * When @ref requestedStart and @ref requestedEnd only move a little between
+ * calls, e.g. for an agent following the path, the corridor is moved along
+ * with them and the path is updated locally instead of being searched for
+ * again.
+ */
+struct PathCorridor {
+  PathCorridor();
+
+  /**
+   * @brief The starting point for the path
+   */
+  vec3f requestedStart;
+
+  /**
+   * @brief The ending point for the path
+   */
+  vec3f requestedEnd;
+
+  /**
+   * @brief A list of points that specify the shortest path on the navigation
+   * mesh between @ref requestedStart and @ref requestedEnd
+   *
+   * Will be empty if no path exists
+   */
+  std::vector<vec3f> points;
+
+  /**
+   * @brief The geodesic distance
+   *
+   * Will be inf if no path exists
+   */
+  float geodesicDistance{};
+
+  /**
+   * @brief Moves of either end point longer than this (in world units) are
+   * treated as a new request and searched for from scratch. The corridor
+   * update is local, so it can miss shortcuts after large moves.
+   */
+  float maxUpdateDistance = 0.5f;
+
+  /**
+   * @brief Discards the corridor so that the next @ref PathFinder.findPath
+   * searches for the path from scratch
+   */
+  void reset();
+
+  friend class PathFinder;
+
+  ESP_SMART_POINTERS_WITH_UNIQUE_PIMPL(PathCorridor);
+};
+
 struct NavMeshSettings {
   //! Cell size in world units
   float cellSize;
@@ -130,6 +209,12 @@ struct NavMeshSettings {
   vec3f navMeshBMin;
   vec3f navMeshBMax;
 
+  //! Tile size in voxels. If positive, the navmesh is built as a grid of
+  //! tiles of this size in parallel instead of as a single tile. Fractions
+  //! of a voxel are dropped. A tile has to be at least twice the border
+  //! every tile is rasterized with, ceil(agentRadius / cellSize) + 3 voxels.
+  float tileSize;
+
   bool filterLowHangingObstacles;
   bool filterLedgeSpans;
   bool filterWalkableLowHeightSpans;
@@ -148,6 +233,7 @@ struct NavMeshSettings {
     vertsPerPoly = 6.0f;
     detailSampleDist = 6.0f;
     detailSampleMaxError = 1.0f;
+    tileSize = 0.0f;
     filterLowHangingObstacles = true;
     filterLedgeSpans = true;
     filterWalkableLowHeightSpans = true;
@@ -179,20 +265,47 @@ class PathFinder {
              const float* bmax);
   bool build(const NavMeshSettings& bs, const esp::assets::MeshData& mesh);
 
+  /**
+   * @brief Rebuilds only the tiles of a tiled navmesh that are affected by
+   * some changed geometry and swaps them into the live navmesh.
+   *
+   * Requires the navmesh to have been built with a positive @ref
+   * NavMeshSettings::tileSize, the same settings are used to rebuild the
+   * tiles. Connectivity information is only recomputed for the islands that
+   * touch the rebuilt tiles.
+   *
+   * @param[in] mesh The full, updated navmesh source geometry
+   * @param[in] changedBounds World space min/max bounds of the geometry that
+   * changed, both where it was and where it is now
+   *
+   * @return Whether or not the tiles were successfully rebuilt
+   */
+  bool rebuildTiles(const esp::assets::MeshData& mesh,
+                    const std::vector<std::pair<vec3f, vec3f>>& changedBounds);
+
   /**
    * @brief Returns a random navigable point
    *
-   * @param maxTries[in] The maximum number of tries sampling will be retried if
-   * it fails.
+   * Points are distributed uniformly over the area of the navigation mesh,
+   * drawn from this PathFinder's own random stream (see @ref seed).
    *
-   * @return A random navigable point.
+   * @param maxTries[in] Unused. Sampling from the precomputed area table
+   * always succeeds.
    *
-   * @note This method can fail.  If it does,
-   * the returned point will be `{NAN, NAN, NAN}`. Use @ref
-   * isNavigable to check if the point is navigable.
+   * @return A random navigable point.
    */
   vec3f getRandomNavigablePoint(int maxTries = 10);
 
+  /**
+   * @brief Returns a batch of random navigable points, distributed as
+   * @ref getRandomNavigablePoint
+   *
+   * @param numPoints[in] The number of points to sample
+   *
+   * @return The random navigable points
+   */
+  std::vector<vec3f> getRandomNavigablePoints(int numPoints);
+
   /**
    * @brief Finds the shortest path between two points on the navigation mesh
    *
@@ -220,6 +333,32 @@ class PathFinder {
    */
   bool findPath(MultiGoalShortestPath& path);
 
+  /**
+   * @brief Finds the shortest path between two points on the navigation mesh,
+   * updating the corridor found by the previous call if possible
+   *
+   * @param[inout] path The @ref PathCorridor structure contain the starting
+   * and end point. This method will populate the @ref PathCorridor.points and
+   * @ref PathCorridor.geodesicDistance fields.
+   *
+   * @return Whether or not a path exists between @ref
+   * PathCorridor.requestedStart and @ref PathCorridor.requestedEnd
+   */
+  bool findPath(PathCorridor& path);
+
+  /**
+   * @brief Finds the shortest paths for a batch of start/end pairs.
+   *
+   * The queries are spread over a pool of worker threads, each of which owns
+   * its own query object over the shared (read-only) navigation mesh.
+   *
+   * @param[inout] paths The @ref ShortestPath structures to solve. Each one is
+   * populated exactly as @ref findPath(ShortestPath&) would.
+   *
+   * @return For each entry of @p paths, whether or not a path exists
+   */
+  std::vector<bool> findPaths(std::vector<ShortestPath>& paths);
+
   /**
    * @brief Attempts to move from @ref start to @ref end and returns the
    * navigable point closest to @ref end that is feasibly reachable from @ref
@@ -269,6 +408,32 @@ class PathFinder {
    */
   bool saveNavMesh(const std::string& path);
 
+  /**
+   * @brief Loads a navigation mesh cache saved by @ref saveNavMeshCache
+   *
+   * Unlike @ref loadNavMesh, the tiles are used in place from a private
+   * memory mapping of the file and the connectivity information is read
+   * instead of recomputed. Processes loading the same cache share the
+   * memory of the tiles.
+   *
+   * @param[in] path The saved navigation mesh cache file
+   *
+   * @return Whether or not the navmesh was successfully loaded
+   */
+  bool loadNavMeshCache(const std::string& path);
+
+  /**
+   * @brief Saves the navigation mesh along with its connectivity information
+   * to later be loaded by @ref loadNavMeshCache
+   *
+   * The cache is specific to the platform it was saved on.
+   *
+   * @param[in] path The name of the file
+   *
+   * @return Whether or not the cache was successfully saved
+   */
+  bool saveNavMeshCache(const std::string& path);
+
   /**
    * @return If a navigation mesh is current loaded or not
    */
@@ -279,7 +444,8 @@ class PathFinder {
    *
    * @param[in] newSeed The random seed
    *
-   * @note This just seeds the global c @ref rand function.
+   * @note Every PathFinder has its own random stream, seeding one does not
+   * affect any other.
    */
   void seed(uint32_t newSeed);
 
@@ -327,6 +493,59 @@ class PathFinder {
    */
   bool isNavigable(const vec3f& pt, const float maxYDelta = 0.5) const;
 
+  /**
+   * @brief Batched version of @ref snapPoint, @ref isNavigable and @ref
+   * distanceToClosestObstacle
+   *
+   * Every point is projected to the navigation mesh once and the projection
+   * is shared by all three queries. The points are processed by a pool of
+   * worker threads.
+   *
+   * @param[in] points An N x 3 matrix of points
+   * @param[in] maxYDelta See @ref isNavigable
+   * @param[in] maxSearchRadius See @ref distanceToClosestObstacle
+   *
+   * @return The results of the three queries for every point
+   */
+  PointsQueryResult queryPoints(
+      const Eigen::Ref<const Eigen::RowMatrixXf>& points,
+      const float maxYDelta = 0.5,
+      const float maxSearchRadius = 2.0);
+
+  /**
+   * @brief Batched version of @ref snapPoint
+   *
+   * @param[in] points An N x 3 matrix of points
+   *
+   * @return An N x 3 matrix of the snapped points
+   */
+  Eigen::RowMatrixXf snapPoints(
+      const Eigen::Ref<const Eigen::RowMatrixXf>& points);
+
+  /**
+   * @brief Batched version of @ref isNavigable
+   *
+   * @param[in] points An N x 3 matrix of points
+   * @param[in] maxYDelta The maximum y displacement
+   *
+   * @return Whether or not each point is navigable
+   */
+  Eigen::Matrix<bool, Eigen::Dynamic, 1> areNavigable(
+      const Eigen::Ref<const Eigen::RowMatrixXf>& points,
+      const float maxYDelta = 0.5);
+
+  /**
+   * @brief Batched version of @ref distanceToClosestObstacle
+   *
+   * @param[in] points An N x 3 matrix of points
+   * @param[in] maxSearchRadius The radius to search in
+   *
+   * @return The distance to the closest obstacle for each point
+   */
+  Eigen::VectorXf distancesToClosestObstacle(
+      const Eigen::Ref<const Eigen::RowMatrixXf>& points,
+      const float maxSearchRadius = 2.0);
+
   /**
    * Compute and return the total area of all NavMesh polygons
    */
@@ -351,6 +570,66 @@ class PathFinder {
    */
   const std::shared_ptr<assets::MeshData> getNavMeshData();
 
+  /**
+   * @brief Registers a goal with the geodesic distance oracle and precomputes
+   * the distance from every navmesh vertex to it.
+   *
+   * Repeated geodesic distance queries to the same goals, e.g. for reward
+   * computation, can then be answered with @ref getOracleGeodesicDistance
+   * without searching the navmesh. The returned distances are upper bounds
+   * of the geodesic distance: the shortest path over the navmesh polygon
+   * vertices and portal end points, pulled taut with navmesh raycasts at
+   * query time. They are within a few percent of the ones found by
+   * @ref findPath. All goals are discarded when the navmesh changes.
+   *
+   * @param[in] goal The goal location
+   *
+   * @return The id of the goal or @ref ID_UNDEFINED if @ref goal could not be
+   * snapped to the navmesh
+   */
+  int addDistanceOracleGoal(const vec3f& goal);
+
+  /**
+   * @return The number of goals registered with the distance oracle
+   */
+  int getNumDistanceOracleGoals() const;
+
+  /**
+   * @brief Discards all goals of the distance oracle
+   */
+  void clearDistanceOracle();
+
+  /**
+   * @brief Looks up the geodesic distance from a point to a goal registered
+   * with @ref addDistanceOracleGoal
+   *
+   * @param[in] start The starting location
+   * @param[in] goalId The id of the goal
+   *
+   * @return The geodesic distance. Will be inf if no path exists
+   */
+  float getOracleGeodesicDistance(const vec3f& start, int goalId) const;
+
+  /**
+   * @brief Saves the precomputed distance oracle goals to a file
+   *
+   * @param[in] path The name of the file
+   *
+   * @return Whether or not the goals were successfully saved
+   */
+  bool saveDistanceOracle(const std::string& path) const;
+
+  /**
+   * @brief Loads distance oracle goals saved by @ref saveDistanceOracle,
+   * replacing the current ones. The file must have been saved for the
+   * currently loaded navmesh.
+   *
+   * @param[in] path The saved distance oracle file
+   *
+   * @return Whether or not the goals were successfully loaded
+   */
+  bool loadDistanceOracle(const std::string& path);
+
   ESP_SMART_POINTERS_WITH_UNIQUE_PIMPL(PathFinder);
 };
 
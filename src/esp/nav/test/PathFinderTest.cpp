@@ -1,7 +1,10 @@
+#include <Corrade/Containers/Array.h>
 #include <Corrade/Containers/ArrayView.h>
 #include <Corrade/TestSuite/Compare/Numeric.h>
 #include <Corrade/TestSuite/Tester.h>
 
+#include <esp/core/random.h>
+#include <esp/nav/IslandSystem.h>
 #include <esp/nav/PathFinder.h>
 
 #include <Corrade/Utility/Directory.h>
@@ -10,6 +13,12 @@
 #include <Magnum/Math/Swizzle.h>
 #include <Magnum/Math/Vector3.h>
 
+#include <memory>
+#include <unordered_map>
+
+#include "DetourAlloc.h"
+#include "DetourNavMeshBuilder.h"
+
 #include "configure.h"
 
 namespace Cr = Corrade;
@@ -27,26 +36,146 @@ constexpr struct {
 } MultiGoalBenchMarkData[]{{"path to closest of 1000", false},
                            {"cached path to closest of 1000", true}};
 
+constexpr struct {
+  const char* name;
+  bool batched;
+} FindPathsBenchMarkData[]{{"1000 paths, findPath", false},
+                           {"1000 paths, findPaths", true}};
+
+constexpr struct {
+  const char* name;
+  bool oracle;
+} DistanceOracleBenchMarkData[]{{"1000 distances, findPath", false},
+                                {"1000 distances, oracle", true}};
+
+constexpr struct {
+  const char* name;
+  bool hashMap;
+} IslandLookupBenchMarkData[]{{"100000 lookups, flat arrays", false},
+                              {"100000 lookups, hash map", true}};
+
+// A single tile navmesh of 64x64 unit quads, split into 4x4 rooms of 16x16
+// quads that are not connected to each other
+constexpr int GridSize = 64;
+constexpr int RoomSize = 16;
+
+using NavMeshPtr = std::unique_ptr<dtNavMesh, void (*)(dtNavMesh*)>;
+
+NavMeshPtr createGridNavMesh() {
+  constexpr int nvp = 4;
+  const auto vertIndex = [](int x, int z) {
+    return static_cast<unsigned short>(z * (GridSize + 1) + x);
+  };
+  const auto polyIndex = [](int x, int z) {
+    return static_cast<unsigned short>(z * GridSize + x);
+  };
+  const auto sameRoom = [](int x, int z, int nx, int nz) {
+    return nx >= 0 && nx < GridSize && nz >= 0 && nz < GridSize &&
+           nx / RoomSize == x / RoomSize && nz / RoomSize == z / RoomSize;
+  };
+
+  std::vector<unsigned short> verts;
+  for (int z = 0; z <= GridSize; ++z) {
+    for (int x = 0; x <= GridSize; ++x) {
+      verts.insert(verts.end(), {static_cast<unsigned short>(x), 0,
+                                 static_cast<unsigned short>(z)});
+    }
+  }
+
+  // Vertices followed by the neighbour across each edge, 0xffff for none
+  std::vector<unsigned short> polys;
+  for (int z = 0; z < GridSize; ++z) {
+    for (int x = 0; x < GridSize; ++x) {
+      polys.insert(polys.end(), {vertIndex(x, z), vertIndex(x, z + 1),
+                                 vertIndex(x + 1, z + 1), vertIndex(x + 1, z)});
+      const int neighbours[nvp][2]{{x - 1, z}, {x, z + 1}, {x + 1, z},
+                                   {x, z - 1}};
+      for (const auto& n : neighbours) {
+        polys.emplace_back(sameRoom(x, z, n[0], n[1]) ? polyIndex(n[0], n[1])
+                                                      : 0xffff);
+      }
+    }
+  }
+  std::vector<unsigned char> areas(GridSize * GridSize, 0);
+  std::vector<unsigned short> flags(GridSize * GridSize, 1);
+
+  dtNavMeshCreateParams params{};
+  params.verts = verts.data();
+  params.vertCount = verts.size() / 3;
+  params.polys = polys.data();
+  params.polyAreas = areas.data();
+  params.polyFlags = flags.data();
+  params.polyCount = GridSize * GridSize;
+  params.nvp = nvp;
+  params.walkableHeight = 2.0f;
+  params.walkableRadius = 0.5f;
+  params.walkableClimb = 0.5f;
+  params.bmax[0] = params.bmax[2] = GridSize;
+  params.bmax[1] = 1.0f;
+  params.cs = params.ch = 1.0f;
+  params.buildBvTree = true;
+
+  NavMeshPtr navMesh{nullptr, dtFreeNavMesh};
+  unsigned char* data = nullptr;
+  int dataSize = 0;
+  if (!dtCreateNavMeshData(&params, &data, &dataSize))
+    return navMesh;
+
+  navMesh.reset(dtAllocNavMesh());
+  if (dtStatusFailed(navMesh->init(data, dataSize, DT_TILE_FREE_DATA))) {
+    dtFree(data);
+    navMesh.reset();
+  }
+  return navMesh;
+}
+
 struct PathFinderTest : Cr::TestSuite::Tester {
   explicit PathFinderTest();
 
   void bounds();
   void tryStepNoSliding();
   void multiGoalPath();
+  void findPaths();
+  void queryPoints();
+  void pathCorridor();
+  void topDownView();
+  void randomNavigablePoints();
+  void navMeshCache();
+  void distanceOracle();
+  void distanceOracleSaveLoad();
 
   void benchmarkSingleGoal();
   void benchmarkMultiGoal();
+  void benchmarkFindPaths();
+  void benchmarkDistanceOracle();
+  void benchmarkTopDownView();
+  void benchmarkIslandLookup();
 
   void testCaching();
 };
 
 PathFinderTest::PathFinderTest() {
   addTests({&PathFinderTest::bounds, &PathFinderTest::tryStepNoSliding,
-            &PathFinderTest::multiGoalPath, &PathFinderTest::testCaching});
+            &PathFinderTest::multiGoalPath, &PathFinderTest::findPaths,
+            &PathFinderTest::queryPoints, &PathFinderTest::pathCorridor,
+            &PathFinderTest::topDownView,
+            &PathFinderTest::randomNavigablePoints,
+            &PathFinderTest::navMeshCache,
+            &PathFinderTest::distanceOracle,
+            &PathFinderTest::distanceOracleSaveLoad,
+            &PathFinderTest::testCaching});
 
   addBenchmarks({&PathFinderTest::benchmarkSingleGoal}, 1000);
+  addBenchmarks({&PathFinderTest::benchmarkTopDownView}, 10);
+  addInstancedBenchmarks({&PathFinderTest::benchmarkIslandLookup}, 100,
+                         Cr::Containers::arraySize(IslandLookupBenchMarkData));
   addInstancedBenchmarks({&PathFinderTest::benchmarkMultiGoal}, 100,
                          Cr::Containers::arraySize(MultiGoalBenchMarkData));
+  addInstancedBenchmarks({&PathFinderTest::benchmarkFindPaths}, 10,
+                         Cr::Containers::arraySize(FindPathsBenchMarkData));
+  addInstancedBenchmarks(
+      {&PathFinderTest::benchmarkDistanceOracle}, 10,
+      Cr::Containers::arraySize(DistanceOracleBenchMarkData));
 }
 
 void PathFinderTest::bounds() {
@@ -125,6 +254,337 @@ void PathFinderTest::multiGoalPath() {
   }
 }
 
+void PathFinderTest::findPaths() {
+  esp::nav::PathFinder pathFinder;
+  pathFinder.loadNavMesh(skokloster);
+  CORRADE_VERIFY(pathFinder.isLoaded());
+  pathFinder.seed(0);
+
+  std::vector<esp::nav::ShortestPath> paths(1000);
+  for (auto& path : paths) {
+    path.requestedStart = pathFinder.getRandomNavigablePoint();
+    path.requestedEnd = pathFinder.getRandomNavigablePoint();
+  }
+
+  std::vector<bool> found = pathFinder.findPaths(paths);
+  CORRADE_COMPARE(found.size(), paths.size());
+
+  for (int i = 0; i < paths.size(); ++i) {
+    CORRADE_ITERATION(i);
+
+    esp::nav::ShortestPath path;
+    path.requestedStart = paths[i].requestedStart;
+    path.requestedEnd = paths[i].requestedEnd;
+    CORRADE_COMPARE(bool(found[i]), pathFinder.findPath(path));
+    CORRADE_COMPARE(paths[i].geodesicDistance, path.geodesicDistance);
+    CORRADE_COMPARE(paths[i].points.size(), path.points.size());
+  }
+}
+
+void PathFinderTest::queryPoints() {
+  esp::nav::PathFinder pathFinder;
+  pathFinder.loadNavMesh(skokloster);
+  CORRADE_VERIFY(pathFinder.isLoaded());
+  pathFinder.seed(0);
+
+  // Navigable points moved by varying amounts so that some of them end up
+  // off the navmesh, above or below it or out of reach entirely
+  Eigen::RowMatrixXf points(1000, 3);
+  for (int i = 0; i < points.rows(); ++i) {
+    const esp::vec3f offset{0.3f * (i % 7 - 3), 0.4f * (i % 5 - 2),
+                            0.3f * (i % 3 - 1)};
+    points.row(i) =
+        (pathFinder.getRandomNavigablePoint() + (i % 4) * offset).transpose();
+  }
+
+  const esp::nav::PointsQueryResult result =
+      pathFinder.queryPoints(points, 0.5, 2.0);
+  CORRADE_COMPARE(result.snappedPoints.rows(), points.rows());
+  CORRADE_COMPARE(result.navigable.size(), points.rows());
+  CORRADE_COMPARE(result.distancesToClosestObstacle.size(), points.rows());
+
+  for (int i = 0; i < points.rows(); ++i) {
+    CORRADE_ITERATION(i);
+    const esp::vec3f pt = points.row(i).transpose();
+
+    const esp::vec3f snapped = pathFinder.snapPoint(pt);
+    const esp::vec3f batchSnapped = result.snappedPoints.row(i).transpose();
+    CORRADE_COMPARE(std::isnan(batchSnapped[0]), std::isnan(snapped[0]));
+    if (!std::isnan(snapped[0]))
+      CORRADE_COMPARE(Mn::Vector3{batchSnapped}, Mn::Vector3{snapped});
+
+    CORRADE_COMPARE(bool(result.navigable[i]), pathFinder.isNavigable(pt, 0.5));
+    CORRADE_COMPARE(result.distancesToClosestObstacle[i],
+                    pathFinder.distanceToClosestObstacle(pt, 2.0));
+  }
+
+  const Eigen::RowMatrixXf snapped = pathFinder.snapPoints(points);
+  CORRADE_VERIFY((snapped.array() == result.snappedPoints.array() ||
+                  (snapped.array().isNaN() &&
+                   result.snappedPoints.array().isNaN()))
+                     .all());
+  CORRADE_VERIFY(pathFinder.areNavigable(points, 0.5) == result.navigable);
+  CORRADE_VERIFY(pathFinder.distancesToClosestObstacle(points, 2.0) ==
+                 result.distancesToClosestObstacle);
+}
+
+void PathFinderTest::pathCorridor() {
+  esp::nav::PathFinder pathFinder;
+  pathFinder.loadNavMesh(skokloster);
+  CORRADE_VERIFY(pathFinder.isLoaded());
+  pathFinder.seed(0);
+
+  for (int i = 0; i < 10; ++i) {
+    CORRADE_ITERATION(i);
+
+    esp::nav::ShortestPath path;
+    do {
+      path.requestedStart = pathFinder.getRandomNavigablePoint();
+      path.requestedEnd = pathFinder.getRandomNavigablePoint();
+    } while (!pathFinder.findPath(path) || path.points.size() < 3);
+
+    // Walk along the path in small steps, updating the corridor as we go
+    esp::nav::PathCorridor corridor;
+    corridor.requestedEnd = path.requestedEnd;
+    for (size_t j = 1; j < path.points.size(); ++j) {
+      const esp::vec3f& a = path.points[j - 1];
+      const esp::vec3f& b = path.points[j];
+      const int numSteps = std::ceil((b - a).norm() / 0.25f);
+      for (int k = 0; k < numSteps; ++k) {
+        corridor.requestedStart =
+            pathFinder.snapPoint<esp::vec3f>(a + (b - a) * k / numSteps);
+
+        esp::nav::ShortestPath fullPath;
+        fullPath.requestedStart = corridor.requestedStart;
+        fullPath.requestedEnd = corridor.requestedEnd;
+        CORRADE_VERIFY(pathFinder.findPath(fullPath));
+
+        CORRADE_VERIFY(pathFinder.findPath(corridor));
+        CORRADE_COMPARE_WITH(
+            corridor.geodesicDistance, fullPath.geodesicDistance,
+            Cr::TestSuite::Compare::around(0.02f * fullPath.geodesicDistance +
+                                           1e-3f));
+      }
+    }
+  }
+
+  // Requests that cannot be followed along the surface are searched again
+  esp::nav::PathCorridor corridor;
+  esp::nav::ShortestPath fullPath;
+  for (int i = 0; i < 100; ++i) {
+    CORRADE_ITERATION(i);
+
+    corridor.requestedStart = fullPath.requestedStart =
+        pathFinder.getRandomNavigablePoint();
+    corridor.requestedEnd = fullPath.requestedEnd =
+        pathFinder.getRandomNavigablePoint();
+    CORRADE_COMPARE(pathFinder.findPath(corridor),
+                    pathFinder.findPath(fullPath));
+    if (!fullPath.points.empty()) {
+      CORRADE_COMPARE_WITH(
+          corridor.geodesicDistance, fullPath.geodesicDistance,
+          Cr::TestSuite::Compare::around(0.02f * fullPath.geodesicDistance +
+                                         1e-3f));
+    }
+  }
+}
+
+void PathFinderTest::topDownView() {
+  esp::nav::PathFinder pathFinder;
+  pathFinder.loadNavMesh(skokloster);
+  CORRADE_VERIFY(pathFinder.isLoaded());
+
+  const float metersPerPixel = 0.1f;
+  const std::pair<esp::vec3f, esp::vec3f> bounds = pathFinder.bounds();
+  const float heights[]{bounds.first[1],
+                        0.5f * (bounds.first[1] + bounds.second[1])};
+  for (const float height : heights) {
+    CORRADE_ITERATION(height);
+
+    const auto topDownView = pathFinder.getTopDownView(metersPerPixel, height);
+
+    // The rasterized view should agree with snapping every pixel, up to
+    // pixels right on the boundary of the navmesh
+    int numNavigable = 0;
+    int numMismatches = 0;
+    for (int h = 0; h < topDownView.rows(); ++h) {
+      for (int w = 0; w < topDownView.cols(); ++w) {
+        const esp::vec3f pt{bounds.first[0] + w * metersPerPixel, height,
+                            bounds.first[2] + h * metersPerPixel};
+        const bool navigable = pathFinder.isNavigable(pt, 0.5);
+        numNavigable += navigable;
+        numMismatches += navigable != topDownView(h, w);
+      }
+    }
+
+    CORRADE_VERIFY(numNavigable > 0);
+    CORRADE_COMPARE_AS(numMismatches, 0.01 * numNavigable,
+                       Cr::TestSuite::Compare::LessOrEqual);
+  }
+}
+
+void PathFinderTest::randomNavigablePoints() {
+  esp::nav::PathFinder pathFinder;
+  pathFinder.loadNavMesh(skokloster);
+  CORRADE_VERIFY(pathFinder.isLoaded());
+
+  esp::nav::PathFinder otherPathFinder;
+  otherPathFinder.loadNavMesh(skokloster);
+  CORRADE_VERIFY(otherPathFinder.isLoaded());
+
+  // Each PathFinder has its own stream, so interleaving does not matter
+  pathFinder.seed(7);
+  otherPathFinder.seed(7);
+  const std::vector<esp::vec3f> points =
+      pathFinder.getRandomNavigablePoints(1000);
+  CORRADE_COMPARE(points.size(), 1000);
+  for (int i = 0; i < points.size(); ++i) {
+    CORRADE_ITERATION(i);
+    CORRADE_VERIFY(pathFinder.isNavigable(points[i]));
+    CORRADE_COMPARE(Mn::Vector3{otherPathFinder.getRandomNavigablePoint()},
+                    Mn::Vector3{points[i]});
+  }
+
+  pathFinder.seed(7);
+  CORRADE_COMPARE(Mn::Vector3{pathFinder.getRandomNavigablePoint()},
+                  Mn::Vector3{points[0]});
+}
+
+void PathFinderTest::navMeshCache() {
+  esp::nav::PathFinder pathFinder;
+  pathFinder.loadNavMesh(skokloster);
+  CORRADE_VERIFY(pathFinder.isLoaded());
+
+  const std::string cacheFile = Cr::Utility::Directory::join(
+      Cr::Utility::Directory::tmp(), "PathFinderTest.navmeshcache");
+  CORRADE_VERIFY(pathFinder.saveNavMeshCache(cacheFile));
+
+  esp::nav::PathFinder cachedPathFinder;
+  CORRADE_VERIFY(!cachedPathFinder.loadNavMeshCache(skokloster));
+  CORRADE_VERIFY(!cachedPathFinder.isLoaded());
+  CORRADE_VERIFY(cachedPathFinder.loadNavMeshCache(cacheFile));
+  CORRADE_VERIFY(cachedPathFinder.isLoaded());
+
+  CORRADE_COMPARE(cachedPathFinder.getNavigableArea(),
+                  pathFinder.getNavigableArea());
+  CORRADE_COMPARE(Mn::Vector3{cachedPathFinder.bounds().first},
+                  Mn::Vector3{pathFinder.bounds().first});
+  CORRADE_COMPARE(Mn::Vector3{cachedPathFinder.bounds().second},
+                  Mn::Vector3{pathFinder.bounds().second});
+
+  pathFinder.seed(0);
+  for (int i = 0; i < 100; ++i) {
+    CORRADE_ITERATION(i);
+
+    esp::nav::ShortestPath path;
+    path.requestedStart = pathFinder.getRandomNavigablePoint();
+    path.requestedEnd = pathFinder.getRandomNavigablePoint();
+    const bool found = pathFinder.findPath(path);
+
+    esp::nav::ShortestPath cachedPath;
+    cachedPath.requestedStart = path.requestedStart;
+    cachedPath.requestedEnd = path.requestedEnd;
+    CORRADE_COMPARE(cachedPathFinder.findPath(cachedPath), found);
+    CORRADE_COMPARE(cachedPath.geodesicDistance, path.geodesicDistance);
+    CORRADE_COMPARE(cachedPathFinder.islandRadius(path.requestedStart),
+                    pathFinder.islandRadius(path.requestedStart));
+  }
+
+  // Replacing the cached navmesh releases the mapping
+  CORRADE_VERIFY(cachedPathFinder.loadNavMesh(skokloster));
+  CORRADE_VERIFY(cachedPathFinder.isLoaded());
+
+  Cr::Utility::Directory::rm(cacheFile);
+}
+
+void PathFinderTest::distanceOracle() {
+  esp::nav::PathFinder pathFinder;
+  pathFinder.loadNavMesh(skokloster);
+  CORRADE_VERIFY(pathFinder.isLoaded());
+  pathFinder.seed(0);
+
+  const esp::vec3f goal = pathFinder.getRandomNavigablePoint();
+  const int goalId = pathFinder.addDistanceOracleGoal(goal);
+  CORRADE_COMPARE(goalId, 0);
+  CORRADE_COMPARE(pathFinder.getNumDistanceOracleGoals(), 1);
+
+  // The oracle's paths are made of straight lines on the navmesh, so they are
+  // never shorter than the shortest path. findPath() only pulls its path taut
+  // within the polygon corridor its A* search found, which is not always the
+  // shortest one, so allow the oracle to beat it by a little.
+  int numFound = 0;
+  for (int i = 0; i < 1000; ++i) {
+    CORRADE_ITERATION(i);
+
+    esp::nav::ShortestPath path;
+    path.requestedStart = pathFinder.getRandomNavigablePoint();
+    path.requestedEnd = goal;
+    const bool found = pathFinder.findPath(path);
+
+    const float oracleDistance =
+        pathFinder.getOracleGeodesicDistance(path.requestedStart, goalId);
+    CORRADE_COMPARE(std::isfinite(oracleDistance), found);
+    if (found) {
+      CORRADE_COMPARE_AS(oracleDistance,
+                         0.99f * path.geodesicDistance - 1e-3f,
+                         Cr::TestSuite::Compare::GreaterOrEqual);
+      CORRADE_COMPARE_AS(oracleDistance,
+                         1.05f * path.geodesicDistance + 0.05f,
+                         Cr::TestSuite::Compare::LessOrEqual);
+      ++numFound;
+    }
+  }
+  CORRADE_VERIFY(numFound > 0);
+
+  pathFinder.clearDistanceOracle();
+  CORRADE_COMPARE(pathFinder.getNumDistanceOracleGoals(), 0);
+}
+
+void PathFinderTest::distanceOracleSaveLoad() {
+  esp::nav::PathFinder pathFinder;
+  pathFinder.loadNavMesh(skokloster);
+  CORRADE_VERIFY(pathFinder.isLoaded());
+  pathFinder.seed(0);
+
+  for (int i = 0; i < 5; ++i) {
+    const esp::vec3f goal = pathFinder.getRandomNavigablePoint();
+    CORRADE_COMPARE(pathFinder.addDistanceOracleGoal(goal), i);
+  }
+
+  const std::string oracleFile = Cr::Utility::Directory::join(
+      Cr::Utility::Directory::tmp(), "PathFinderTest.distanceoracle");
+  CORRADE_VERIFY(pathFinder.saveDistanceOracle(oracleFile));
+
+  esp::nav::PathFinder loadedPathFinder;
+  CORRADE_VERIFY(!loadedPathFinder.loadDistanceOracle(oracleFile));
+  loadedPathFinder.loadNavMesh(skokloster);
+  CORRADE_VERIFY(loadedPathFinder.loadDistanceOracle(oracleFile));
+  CORRADE_COMPARE(loadedPathFinder.getNumDistanceOracleGoals(), 5);
+
+  // A file computed on a different navmesh is rejected. The navmesh hash
+  // follows the magic, version, node and goal counts in the header.
+  Cr::Containers::Array<char> data = Cr::Utility::Directory::read(oracleFile);
+  CORRADE_VERIFY(data.size() > 4 * sizeof(int));
+  data[4 * sizeof(int)] ^= 0x1;
+  const std::string otherOracleFile = Cr::Utility::Directory::join(
+      Cr::Utility::Directory::tmp(), "PathFinderTest.other.distanceoracle");
+  CORRADE_VERIFY(Cr::Utility::Directory::write(otherOracleFile, data));
+  CORRADE_VERIFY(!loadedPathFinder.loadDistanceOracle(otherOracleFile));
+  Cr::Utility::Directory::rm(otherOracleFile);
+
+  for (int i = 0; i < 100; ++i) {
+    CORRADE_ITERATION(i);
+
+    const esp::vec3f start = pathFinder.getRandomNavigablePoint();
+    for (int goalId = 0; goalId < 5; ++goalId) {
+      CORRADE_COMPARE(loadedPathFinder.getOracleGeodesicDistance(start, goalId),
+                      pathFinder.getOracleGeodesicDistance(start, goalId));
+    }
+  }
+
+  Cr::Utility::Directory::rm(oracleFile);
+}
+
 void PathFinderTest::testCaching() {
   esp::nav::PathFinder pathFinder;
   pathFinder.loadNavMesh(skokloster);
@@ -199,6 +659,136 @@ void PathFinderTest::benchmarkMultiGoal() {
   CORRADE_VERIFY(status);
 }
 
+void PathFinderTest::benchmarkFindPaths() {
+  esp::nav::PathFinder pathFinder;
+  pathFinder.loadNavMesh(skokloster);
+  CORRADE_VERIFY(pathFinder.isLoaded());
+  pathFinder.seed(0);
+
+  auto&& data = FindPathsBenchMarkData[testCaseInstanceId()];
+  setTestCaseDescription(data.name);
+
+  std::vector<esp::nav::ShortestPath> paths(1000);
+  for (auto& path : paths) {
+    path.requestedStart = pathFinder.getRandomNavigablePoint();
+    path.requestedEnd = pathFinder.getRandomNavigablePoint();
+  }
+
+  if (data.batched) {
+    CORRADE_BENCHMARK(1) { pathFinder.findPaths(paths); };
+  } else {
+    CORRADE_BENCHMARK(1) {
+      for (auto& path : paths) {
+        pathFinder.findPath(path);
+      }
+    };
+  }
+}
+
+void PathFinderTest::benchmarkDistanceOracle() {
+  esp::nav::PathFinder pathFinder;
+  pathFinder.loadNavMesh(skokloster);
+  CORRADE_VERIFY(pathFinder.isLoaded());
+  pathFinder.seed(0);
+
+  auto&& data = DistanceOracleBenchMarkData[testCaseInstanceId()];
+  setTestCaseDescription(data.name);
+
+  const esp::vec3f goal = pathFinder.getRandomNavigablePoint();
+  const int goalId = pathFinder.addDistanceOracleGoal(goal);
+  CORRADE_VERIFY(goalId != esp::ID_UNDEFINED);
+
+  std::vector<esp::nav::ShortestPath> paths(1000);
+  for (auto& path : paths) {
+    path.requestedStart = pathFinder.getRandomNavigablePoint();
+    path.requestedEnd = goal;
+  }
+
+  if (data.oracle) {
+    CORRADE_BENCHMARK(1) {
+      for (auto& path : paths) {
+        path.geodesicDistance =
+            pathFinder.getOracleGeodesicDistance(path.requestedStart, goalId);
+      }
+    };
+  } else {
+    CORRADE_BENCHMARK(1) {
+      for (auto& path : paths) {
+        pathFinder.findPath(path);
+      }
+    };
+  }
+}
+
+void PathFinderTest::benchmarkTopDownView() {
+  esp::nav::PathFinder pathFinder;
+  pathFinder.loadNavMesh(skokloster);
+  CORRADE_VERIFY(pathFinder.isLoaded());
+
+  const float height = pathFinder.bounds().first[1];
+  Eigen::Matrix<bool, Eigen::Dynamic, Eigen::Dynamic> topDownView;
+  CORRADE_BENCHMARK(1) {
+    topDownView = pathFinder.getTopDownView(0.01f, height);
+  };
+  CORRADE_VERIFY(topDownView.any());
+}
+
+void PathFinderTest::benchmarkIslandLookup() {
+  auto&& data = IslandLookupBenchMarkData[testCaseInstanceId()];
+  setTestCaseDescription(data.name);
+
+  const NavMeshPtr navMesh = createGridNavMesh();
+  CORRADE_VERIFY(navMesh);
+  const dtQueryFilter filter;
+  const esp::nav::impl::IslandSystem islandSystem{navMesh.get(), &filter};
+  CORRADE_COMPARE(islandSystem.islandRadii().size(),
+                  (GridSize / RoomSize) * (GridSize / RoomSize));
+
+  // The polygons are already known, so only the island lookups are timed and
+  // not snapping the points to the navmesh
+  const dtMeshTile* tile = navMesh->getTile(0);
+  const dtPolyRef base = navMesh->getPolyRefBase(tile);
+  esp::core::Random random{0};
+  std::vector<std::pair<dtPolyRef, dtPolyRef>> refPairs(100000);
+  const auto randomRef = [&]() {
+    return base | static_cast<dtPolyRef>(
+                      random.uniform_int(0, tile->header->polyCount));
+  };
+  for (auto& refPair : refPairs) {
+    refPair.first = randomRef();
+    refPair.second = randomRef();
+  }
+
+  // The polygon to island hash map IslandSystem used before, as a baseline
+  std::unordered_map<dtPolyRef, uint32_t> polyToIsland;
+  for (int jPoly = 0; jPoly < tile->header->polyCount; ++jPoly) {
+    const dtPolyRef ref = base | static_cast<dtPolyRef>(jPoly);
+    polyToIsland.emplace(ref, islandSystem.islandOf(ref));
+  }
+
+  int numConnected = 0;
+  if (data.hashMap) {
+    CORRADE_BENCHMARK(1) {
+      for (const auto& refPair : refPairs) {
+        auto itStart = polyToIsland.find(refPair.first);
+        auto itEnd = polyToIsland.find(refPair.second);
+        numConnected += itStart != polyToIsland.end() &&
+                        itEnd != polyToIsland.end() &&
+                        itStart->second == itEnd->second;
+      }
+    };
+  } else {
+    CORRADE_BENCHMARK(1) {
+      for (const auto& refPair : refPairs) {
+        numConnected +=
+            islandSystem.hasConnection(refPair.first, refPair.second);
+      }
+    };
+  }
+  // About one in 16 pairs is in the same room
+  CORRADE_VERIFY(numConnected > 0);
+}
+
 }  // namespace
 
 CORRADE_TEST_MAIN(PathFinderTest)
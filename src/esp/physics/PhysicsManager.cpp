@@ -6,6 +6,7 @@
 #include "esp/assets/CollisionMeshData.h"
 
 #include <Magnum/Math/Range.h>
+#include <algorithm>
 
 namespace esp {
 namespace physics {
@@ -557,5 +558,29 @@ void PhysicsManager::setSemanticId(const int physObjectID,
   existingObjects_.at(physObjectID)->setSemanticId(semanticId);
 }
 
+RaycastBatchResults PhysicsManager::castRays(
+    const std::vector<esp::geo::Ray>& rays,
+    double maxDistance,
+    bool closestHitOnly) {
+  RaycastBatchResults results;
+  results.rayHitOffsets.reserve(rays.size() + 1);
+  results.rayHitOffsets.push_back(0);
+  for (const esp::geo::Ray& ray : rays) {
+    const RaycastResults rayResults = castRay(ray, maxDistance);
+    const std::size_t numHits =
+        closestHitOnly ? std::min<std::size_t>(rayResults.hits.size(), 1)
+                       : rayResults.hits.size();
+    for (std::size_t i = 0; i < numHits; ++i) {
+      const RayHitInfo& hit = rayResults.hits[i];
+      results.objectIds.push_back(hit.objectId);
+      results.points.push_back(hit.point);
+      results.normals.push_back(hit.normal);
+      results.rayDistances.push_back(hit.rayDistance);
+    }
+    results.rayHitOffsets.push_back(results.objectIds.size());
+  }
+  return results;
+}
+
 }  // namespace physics
 }  // namespace esp
@@ -65,6 +65,45 @@ struct RaycastResults {
   ESP_SMART_POINTERS(RaycastResults)
 };
 
+//! Holds the hits of a batch of rays in flat arrays with one element per hit.
+//! The hits of ray i are the elements [rayHitOffsets[i], rayHitOffsets[i + 1])
+//! of the arrays, sorted by distance.
+struct RaycastBatchResults {
+  //! The index of the first hit of each ray, followed by the number of hits.
+  std::vector<int> rayHitOffsets;
+  //! The ids of the objects hit. Stage hits are -1.
+  std::vector<int> objectIds;
+  //! The first impact points of the rays in world space.
+  std::vector<Magnum::Vector3> points;
+  //! The collision object normals at the points of impact.
+  std::vector<Magnum::Vector3> normals;
+  //! Distances along the ray directions from the ray origins (in units of ray
+  //! length).
+  std::vector<double> rayDistances;
+
+  int numRays() const {
+    return rayHitOffsets.empty() ? 0 : rayHitOffsets.size() - 1;
+  }
+
+  int numHits(int rayIndex) const {
+    return rayHitOffsets[rayIndex + 1] - rayHitOffsets[rayIndex];
+  }
+
+  ESP_SMART_POINTERS(RaycastBatchResults)
+};
+
+//! Holds information about a pair of collision objects in contact.
+struct ContactPairInfo {
+  //! The id of the first object of the pair. Stage contacts are -1.
+  int objectIdA;
+  //! The id of the second object of the pair. Stage contacts are -1.
+  int objectIdB;
+  //! The number of contact points between the two objects.
+  int numContactPoints;
+
+  ESP_SMART_POINTERS(ContactPairInfo)
+};
+
 // TODO: repurpose to manage multiple physical worlds. Currently represents
 // exactly one world.
 
@@ -841,6 +880,37 @@ class PhysicsManager {
     return false;
   };
 
+  /**
+   * @brief Check for each of several objects whether it is in contact with any
+   * other objects or the scene. Equivalent to @ref contactTest() for each
+   * object, implementations run collision detection for the whole world once
+   * only.
+   *
+   * @param physObjectIDs The object IDs and keys identifying the objects in
+   * @ref PhysicsManager::existingObjects_.
+   * @return Whether or not each object is in contact with any other collision
+   * enabled objects, in the order of @p physObjectIDs.
+   */
+  virtual std::vector<bool> contactTestBatch(
+      const std::vector<int>& physObjectIDs) {
+    std::vector<bool> results;
+    results.reserve(physObjectIDs.size());
+    for (const int physObjectID : physObjectIDs) {
+      results.push_back(contactTest(physObjectID));
+    }
+    return results;
+  }
+
+  /**
+   * @brief Run collision detection and get all the pairs of collision objects
+   * in contact.
+   *
+   * Not implemented for default @ref PhysicsManager. See @ref
+   * BulletPhysicsManager.
+   * @return The pairs in contact, with their number of contact points.
+   */
+  virtual std::vector<ContactPairInfo> getContactPairs() { return {}; }
+
   /**
    * @brief Set an object to collidable or not.
    */
@@ -939,6 +1009,23 @@ class PhysicsManager {
     return results;
   }
 
+  /**
+   * @brief Cast a batch of rays into the collision world and return the hits
+   * of all of them in a @ref RaycastBatchResults.
+   *
+   * The default implementation casts the rays one by one with @ref castRay.
+   *
+   * @param rays The rays to cast. Need not be unit length, but returned hit
+   * distances will be in units of ray length.
+   * @param maxDistance The maximum distance along the ray directions to
+   * search. In units of ray length.
+   * @param closestHitOnly Whether to only return the closest hit of each ray.
+   * @return The hits of the rays, sorted by distance for each ray.
+   */
+  virtual RaycastBatchResults castRays(const std::vector<esp::geo::Ray>& rays,
+                                       double maxDistance = 100.0,
+                                       bool closestHitOnly = false);
+
   virtual int getNumActiveContactPoints() { return -1; }
 
  protected:
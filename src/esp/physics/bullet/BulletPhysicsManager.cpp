@@ -6,12 +6,105 @@
 //#include "BulletCollision/Gimpact/btGImpactShape.h"
 
 #include "BulletPhysicsManager.h"
+
+#include <algorithm>
+#include <unordered_set>
+
 #include "BulletRigidObject.h"
+#include "LinearMath/btThreads.h"
 #include "esp/assets/ResourceManager.h"
 
 namespace esp {
 namespace physics {
 
+namespace {
+
+// Tests a ray against the collision objects of the broadphase leaves it
+// crosses, which btCollisionWorld::rayTest() also does but with a traversal
+// stack shared by all its callers
+struct RayTestLeafCallback : btDbvt::ICollide {
+  RayTestLeafCallback(const btVector3& from,
+                      const btVector3& to,
+                      btCollisionWorld::RayResultCallback& resultCallback)
+      : resultCallback_(resultCallback) {
+    rayFromTrans_.setIdentity();
+    rayFromTrans_.setOrigin(from);
+    rayToTrans_.setIdentity();
+    rayToTrans_.setOrigin(to);
+  }
+
+  void Process(const btDbvtNode* leaf) override {
+    btBroadphaseProxy* proxy = static_cast<btDbvtProxy*>(leaf->data);
+    if (!resultCallback_.needsCollision(proxy)) {
+      return;
+    }
+    btCollisionObject* collisionObject =
+        static_cast<btCollisionObject*>(proxy->m_clientObject);
+    btCollisionWorld::rayTestSingle(
+        rayFromTrans_, rayToTrans_, collisionObject,
+        collisionObject->getCollisionShape(),
+        collisionObject->getWorldTransform(), resultCallback_);
+  }
+
+  btTransform rayFromTrans_;
+  btTransform rayToTrans_;
+  btCollisionWorld::RayResultCallback& resultCallback_;
+};
+
+// Same as btCollisionWorld::rayTest() on a world with the given broadphase,
+// but safe to call from several threads at once as long as each has its own
+// stack
+void rayTestWithStack(const btDbvtBroadphase& broadphase,
+                      const btVector3& from,
+                      const btVector3& to,
+                      btCollisionWorld::RayResultCallback& resultCallback,
+                      btAlignedObjectArray<const btDbvtNode*>& stack) {
+  btVector3 rayDirection = to - from;
+  rayDirection.normalize();
+  btVector3 rayDirectionInverse;
+  unsigned int signs[3];
+  for (int i = 0; i < 3; ++i) {
+    rayDirectionInverse[i] = rayDirection[i] == btScalar(0.0)
+                                 ? btScalar(BT_LARGE_FLOAT)
+                                 : btScalar(1.0) / rayDirection[i];
+    signs[i] = rayDirectionInverse[i] < btScalar(0.0);
+  }
+  const btScalar lambdaMax = rayDirection.dot(to - from);
+  const btVector3 zero{0, 0, 0};
+
+  RayTestLeafCallback leafCallback{from, to, resultCallback};
+  // the dynamic and the static trees
+  for (const btDbvt& tree : broadphase.m_sets) {
+    tree.rayTestInternal(tree.m_root, from, to, rayDirectionInverse, signs,
+                         lambdaMax, zero, zero, stack, leafCallback);
+  }
+}
+
+// Number of the points of a manifold at which its objects touch or
+// penetrate. Manifolds also keep points up to the contact breaking threshold
+// apart, which contactTest() does not report.
+int numTouchingContacts(const btPersistentManifold* manifold) {
+  int numContacts = 0;
+  for (int i = 0; i < manifold->getNumContacts(); ++i) {
+    if (manifold->getContactPoint(i).getDistance() <= 0) {
+      ++numContacts;
+    }
+  }
+  return numContacts;
+}
+
+// pairs of collision objects per task of the multithreaded dispatcher
+constexpr int CollisionDispatcherGrainSize = 40;
+
+// Bullet's own thread pool, created on first use and shared by all the
+// multithreaded worlds. Null if Bullet was built without multithreading.
+btITaskScheduler* getDefaultTaskScheduler() {
+  static btITaskScheduler* taskScheduler = btCreateDefaultTaskScheduler();
+  return taskScheduler;
+}
+
+}  // namespace
+
 BulletPhysicsManager::~BulletPhysicsManager() {
   LOG(INFO) << "Deconstructing BulletPhysicsManager";
 
@@ -19,14 +112,53 @@ BulletPhysicsManager::~BulletPhysicsManager() {
   staticStageObject_.reset(nullptr);
 }
 
+bool BulletPhysicsManager::isMultithreadingAvailable() {
+  return getDefaultTaskScheduler() != nullptr;
+}
+
 bool BulletPhysicsManager::initPhysicsFinalize() {
   activePhysSimLib_ = BULLET;
 
-  //! We can potentially use other collision checking algorithms, by
-  //! uncommenting the line below
-  // btGImpactCollisionAlgorithm::registerAlgorithm(&bDispatcher_);
-  bWorld_ = std::make_shared<btMultiBodyDynamicsWorld>(
-      &bDispatcher_, &bBroadphase_, &bSolver_, &bCollisionConfig_);
+  btITaskScheduler* taskScheduler = nullptr;
+  if (physicsManagerAttributes_->getMultithreaded()) {
+    taskScheduler = getDefaultTaskScheduler();
+    if (taskScheduler == nullptr) {
+      LOG(WARNING) << "BulletPhysicsManager::initPhysicsFinalize : Bullet was "
+                      "built without BULLET2_MULTITHREADING (see "
+                      "BUILD_WITH_BULLET_MT), using the single-threaded "
+                      "world.";
+    }
+  }
+
+  if (taskScheduler != nullptr) {
+    // the task scheduler is global to Bullet, so the last multithreaded world
+    // created sets the number of threads of all of them
+    const int numThreads = physicsManagerAttributes_->getNumThreads();
+    btSetTaskScheduler(taskScheduler);
+    taskScheduler->setNumThreads(
+        numThreads > 0 ? numThreads : taskScheduler->getMaxNumThreads());
+    LOG(INFO) << "BulletPhysicsManager::initPhysicsFinalize : Using the "
+                 "multithreaded world with "
+              << taskScheduler->getNumThreads() << " threads.";
+
+    bDispatcher_ = std::make_unique<btCollisionDispatcherMt>(
+        &bCollisionConfig_, CollisionDispatcherGrainSize);
+    bSolverPool_ =
+        std::make_unique<btConstraintSolverPoolMt>(BT_MAX_THREAD_COUNT);
+    bSolver_ = std::make_unique<btSequentialImpulseConstraintSolverMt>();
+    bWorld_ = std::make_shared<btDiscreteDynamicsWorldMt>(
+        bDispatcher_.get(), &bBroadphase_, bSolverPool_.get(), bSolver_.get(),
+        &bCollisionConfig_);
+  } else {
+    bDispatcher_ = std::make_unique<btCollisionDispatcher>(&bCollisionConfig_);
+    //! We can potentially use other collision checking algorithms, by
+    //! uncommenting the line below
+    // btGImpactCollisionAlgorithm::registerAlgorithm(bDispatcher_.get());
+    auto solver = std::make_unique<btMultiBodyConstraintSolver>();
+    bWorld_ = std::make_shared<btMultiBodyDynamicsWorld>(
+        bDispatcher_.get(), &bBroadphase_, solver.get(), &bCollisionConfig_);
+    bSolver_ = std::move(solver);
+  }
 
   debugDrawer_.setMode(
       Magnum::BulletIntegration::DebugDraw::Mode::DrawWireframe |
@@ -40,7 +172,8 @@ bool BulletPhysicsManager::initPhysicsFinalize() {
   //! Create new scene node
   staticStageObject_ = physics::BulletRigidStage::create_unique(
       &physicsNode_->createChild(), resourceManager_, bWorld_,
-      collisionObjToObjIds_);
+      collisionObjToObjIds_,
+      physicsManagerAttributes_->getStageBvhCacheDirectory());
   Corrade::Utility::Debug() << "creating staticStageObject_ .. done";
 
   return true;
@@ -60,7 +193,7 @@ bool BulletPhysicsManager::makeAndAddRigidObject(int newObjectID,
                                                  scene::SceneNode* objectNode) {
   auto ptr = physics::BulletRigidObject::create_unique(
       objectNode, newObjectID, resourceManager_, bWorld_,
-      collisionObjToObjIds_);
+      collisionObjToObjIds_, collisionShapeCache_);
   bool objSuccess = ptr->initialize(handle);
   if (objSuccess) {
     existingObjects_.emplace(newObjectID, std::move(ptr));
@@ -223,6 +356,73 @@ bool BulletPhysicsManager::contactTest(const int physObjectID) {
       ->contactTest();
 }
 
+std::vector<bool> BulletPhysicsManager::contactTestBatch(
+    const std::vector<int>& physObjectIDs) {
+  for (const int physObjectID : physObjectIDs) {
+    assertIDValidity(physObjectID);
+  }
+  bWorld_->getCollisionWorld()->performDiscreteCollisionDetection();
+
+  // all collision objects with contact points after this pass
+  std::unordered_set<const btCollisionObject*> objectsInContact;
+  auto* dispatcher = bWorld_->getDispatcher();
+  for (int i = 0; i < dispatcher->getNumManifolds(); i++) {
+    const btPersistentManifold* manifold =
+        dispatcher->getManifoldByIndexInternal(i);
+    if (numTouchingContacts(manifold) > 0) {
+      objectsInContact.insert(manifold->getBody0());
+      objectsInContact.insert(manifold->getBody1());
+    }
+  }
+
+  std::vector<bool> results;
+  results.reserve(physObjectIDs.size());
+  for (const int physObjectID : physObjectIDs) {
+    auto* object = static_cast<BulletRigidObject*>(
+        existingObjects_.at(physObjectID).get());
+    if (!object->isActive()) {
+      // the manifolds of two sleeping objects are not updated
+      results.push_back(object->contactTest());
+    } else {
+      results.push_back(objectsInContact.count(object->getCollisionObject()) >
+                        0);
+    }
+  }
+  return results;
+}
+
+std::vector<ContactPairInfo> BulletPhysicsManager::getContactPairs() {
+  bWorld_->getCollisionWorld()->performDiscreteCollisionDetection();
+
+  std::vector<ContactPairInfo> contactPairs;
+  auto* dispatcher = bWorld_->getDispatcher();
+  for (int i = 0; i < dispatcher->getNumManifolds(); i++) {
+    const btPersistentManifold* manifold =
+        dispatcher->getManifoldByIndexInternal(i);
+    const int numContacts = numTouchingContacts(manifold);
+    if (numContacts == 0) {
+      continue;
+    }
+
+    ContactPairInfo contactPair;
+    // default to -1 for "stage collision" if we don't know which object was
+    // involved
+    contactPair.objectIdA = -1;
+    contactPair.objectIdB = -1;
+    auto objectA = collisionObjToObjIds_->find(manifold->getBody0());
+    if (objectA != collisionObjToObjIds_->end()) {
+      contactPair.objectIdA = objectA->second;
+    }
+    auto objectB = collisionObjToObjIds_->find(manifold->getBody1());
+    if (objectB != collisionObjToObjIds_->end()) {
+      contactPair.objectIdB = objectB->second;
+    }
+    contactPair.numContactPoints = numContacts;
+    contactPairs.push_back(contactPair);
+  }
+  return contactPairs;
+}
+
 RaycastResults BulletPhysicsManager::castRay(const esp::geo::Ray& ray,
                                              double maxDistance) {
   RaycastResults results;
@@ -259,6 +459,103 @@ RaycastResults BulletPhysicsManager::castRay(const esp::geo::Ray& ray,
   return results;
 }
 
+RaycastBatchResults BulletPhysicsManager::castRays(
+    const std::vector<esp::geo::Ray>& rays,
+    double maxDistance,
+    bool closestHitOnly) {
+  const int numRays = rays.size();
+  if (std::any_of(rays.begin(), rays.end(), [](const esp::geo::Ray& ray) {
+        return ray.direction.dot() == 0.0f;
+      })) {
+    LOG(ERROR) << "BulletPhysicsManager::castRays : Cannot cast rays with "
+                  "zero length, they have no hits.";
+  }
+
+  // the hits of each ray, sorted by distance
+  std::vector<std::vector<RayHitInfo>> rayHits(numRays);
+  const auto getObjectId = [this](const btCollisionObject* collisionObject) {
+    // default to -1 for "scene collision" if we don't know which object was
+    // involved
+    auto objectId = collisionObjToObjIds_->find(collisionObject);
+    return objectId != collisionObjToObjIds_->end() ? objectId->second : -1;
+  };
+
+  // the rays only read the broadphase trees and the collision shapes, so each
+  // thread casts its share of them with a traversal stack of its own
+#pragma omp parallel
+  {
+    btAlignedObjectArray<const btDbvtNode*> stack;
+
+#pragma omp for schedule(dynamic, 64)
+    for (int i = 0; i < numRays; ++i) {
+      const esp::geo::Ray& ray = rays[i];
+      const double rayLength = ray.direction.length();
+      if (rayLength == 0) {
+        continue;
+      }
+      btVector3 from(ray.origin);
+      btVector3 to(ray.origin + ray.direction * maxDistance);
+      std::vector<RayHitInfo>& hits = rayHits[i];
+
+      if (closestHitOnly) {
+        btCollisionWorld::ClosestRayResultCallback closestResult(from, to);
+        rayTestWithStack(bBroadphase_, from, to, closestResult, stack);
+        if (closestResult.hasHit()) {
+          RayHitInfo hit;
+          hit.normal = Magnum::Vector3{closestResult.m_hitNormalWorld};
+          hit.point = Magnum::Vector3{closestResult.m_hitPointWorld};
+          hit.rayDistance =
+              (closestResult.m_closestHitFraction * maxDistance) / rayLength;
+          hit.objectId = getObjectId(closestResult.m_collisionObject);
+          hits.push_back(hit);
+        }
+        continue;
+      }
+
+      btCollisionWorld::AllHitsRayResultCallback allResults(from, to);
+      rayTestWithStack(bBroadphase_, from, to, allResults, stack);
+      hits.reserve(allResults.m_hitPointWorld.size());
+      for (int j = 0; j < allResults.m_hitPointWorld.size(); ++j) {
+        RayHitInfo hit;
+        hit.normal = Magnum::Vector3{allResults.m_hitNormalWorld[j]};
+        hit.point = Magnum::Vector3{allResults.m_hitPointWorld[j]};
+        hit.rayDistance =
+            (allResults.m_hitFractions[j] * maxDistance) / rayLength;
+        hit.objectId = getObjectId(allResults.m_collisionObjects[j]);
+        hits.push_back(hit);
+      }
+      std::sort(hits.begin(), hits.end(),
+                [](const RayHitInfo& A, const RayHitInfo& B) {
+                  return A.rayDistance < B.rayDistance;
+                });
+    }
+  }
+
+  // flatten the hits into the result arrays
+  RaycastBatchResults results;
+  results.rayHitOffsets.resize(numRays + 1);
+  results.rayHitOffsets[0] = 0;
+  for (int i = 0; i < numRays; ++i) {
+    results.rayHitOffsets[i + 1] = results.rayHitOffsets[i] + rayHits[i].size();
+  }
+  const int numHits = results.rayHitOffsets[numRays];
+  results.objectIds.resize(numHits);
+  results.points.resize(numHits);
+  results.normals.resize(numHits);
+  results.rayDistances.resize(numHits);
+  for (int i = 0; i < numRays; ++i) {
+    int hitIndex = results.rayHitOffsets[i];
+    for (const RayHitInfo& hit : rayHits[i]) {
+      results.objectIds[hitIndex] = hit.objectId;
+      results.points[hitIndex] = hit.point;
+      results.normals[hitIndex] = hit.normal;
+      results.rayDistances[hitIndex] = hit.rayDistance;
+      ++hitIndex;
+    }
+  }
+  return results;
+}
+
 int BulletPhysicsManager::getNumActiveContactPoints() {
   int pointCount = 0;
   auto* dispatcher = bWorld_->getDispatcher();
@@ -15,6 +15,9 @@
 #include <Magnum/BulletIntegration/MotionState.h>
 #include <btBulletDynamicsCommon.h>
 
+#include "BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h"
+#include "BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h"
+#include "BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.h"
 #include "BulletDynamics/Featherstone/btMultiBodyConstraintSolver.h"
 #include "BulletDynamics/Featherstone/btMultiBodyDynamicsWorld.h"
 
@@ -30,7 +33,8 @@ namespace physics {
 @brief Dynamic stage and object manager interfacing with Bullet physics
 engine: https://github.com/bulletphysics/bullet3.
 
-See @ref btMultiBodyDynamicsWorld.
+See @ref btMultiBodyDynamicsWorld, or @ref btDiscreteDynamicsWorldMt when
+@ref metadata::attributes::PhysicsManagerAttributes::getMultithreaded is set.
 
 Enables @ref RigidObject simulation with @ref MotionType::DYNAMIC.
 
@@ -56,6 +60,7 @@ class BulletPhysicsManager : public PhysicsManager {
       : PhysicsManager(_resourceManager, _physicsManagerAttributes) {
     collisionObjToObjIds_ =
         std::make_shared<std::map<const btCollisionObject*, int>>();
+    collisionShapeCache_ = BulletCollisionShapeCache::create();
   };
 
   /** @brief Destructor which destructs necessary Bullet physics structures.*/
@@ -65,7 +70,7 @@ class BulletPhysicsManager : public PhysicsManager {
 
   /** @brief Step the physical world forward in time. Time may only advance in
    * increments of @ref fixedTimeStep_. See @ref
-   * btMultiBodyDynamicsWorld::stepSimulation.
+   * btDiscreteDynamicsWorld::stepSimulation.
    * @param dt The desired amount of time to advance the physical world.
    */
   void stepPhysics(double dt) override;
@@ -80,6 +85,17 @@ class BulletPhysicsManager : public PhysicsManager {
    */
   Magnum::Vector3 getGravity() const override;
 
+  /** @brief Whether Bullet was built with BULLET2_MULTITHREADING (see
+   * BUILD_WITH_BULLET_MT), so that multithreaded worlds can be created.
+   */
+  static bool isMultithreadingAvailable();
+
+  /** @brief Whether the world is a @ref btDiscreteDynamicsWorldMt. Requesting
+   * a multithreaded world falls back to the single-threaded one if
+   * multithreading is not available.
+   */
+  bool isMultithreaded() const { return bSolverPool_ != nullptr; }
+
   //============ Interacting with objects =============
   // NOTE: engine specifics for interaction are handled by the objects
   // themselves...
@@ -171,6 +187,34 @@ class BulletPhysicsManager : public PhysicsManager {
    */
   bool contactTest(const int physObjectID) override;
 
+  /**
+   * @brief Check for each of several objects whether it is in contact with any
+   * other objects or the stage. Runs collision detection for the whole world
+   * once and reads the contacts of the objects from the contact manifolds of
+   * the dispatcher, instead of once per object as @ref contactTest() does.
+   * As in @ref contactTest(), only the manifold points at which the objects
+   * touch or penetrate count, not those kept up to the contact breaking
+   * threshold apart. Sleeping objects, whose contacts with other sleeping
+   * objects are not updated by collision detection, are tested on their own.
+   *
+   * @param physObjectIDs The object IDs and keys identifying the objects in
+   * @ref PhysicsManager::existingObjects_.
+   * @return Whether or not each object is in contact with any other collision
+   * enabled objects, in the order of @p physObjectIDs.
+   */
+  std::vector<bool> contactTestBatch(
+      const std::vector<int>& physObjectIDs) override;
+
+  /**
+   * @brief Run collision detection and get all the pairs of collision objects
+   * in contact from the contact manifolds of the dispatcher. Pairs of sleeping
+   * objects are reported with the contacts they had when they fell asleep.
+   * Only the manifold points at which the objects touch or penetrate count.
+   *
+   * @return The pairs in contact, with their number of contact points.
+   */
+  std::vector<ContactPairInfo> getContactPairs() override;
+
   /**
    * @brief Cast a ray into the collision world and return a @ref RaycastResults
    * with hit information.
@@ -184,6 +228,24 @@ class BulletPhysicsManager : public PhysicsManager {
   virtual RaycastResults castRay(const esp::geo::Ray& ray,
                                  double maxDistance = 100.0) override;
 
+  /**
+   * @brief Cast a batch of rays into the collision world and return the hits
+   * of all of them in a @ref RaycastBatchResults.
+   *
+   * The rays are cast in parallel. The collision world must not be modified
+   * during the call.
+   *
+   * @param rays The rays to cast. Need not be unit length, but returned hit
+   * distances will be in units of ray length.
+   * @param maxDistance The maximum distance along the ray directions to
+   * search. In units of ray length.
+   * @param closestHitOnly Whether to only return the closest hit of each ray.
+   * @return The hits of the rays, sorted by distance for each ray.
+   */
+  RaycastBatchResults castRays(const std::vector<esp::geo::Ray>& rays,
+                               double maxDistance = 100.0,
+                               bool closestHitOnly = false) override;
+
   // The number of contact points that were active during the last step. An
   // object resting on another object will involve several active contact
   // points. Once both objects are asleep, the contact points are inactive. This
@@ -228,11 +290,15 @@ class BulletPhysicsManager : public PhysicsManager {
   btDbvtBroadphase bBroadphase_;
   btDefaultCollisionConfiguration bCollisionConfig_;
 
-  btMultiBodyConstraintSolver bSolver_;
-  btCollisionDispatcher bDispatcher_{&bCollisionConfig_};
+  /** @brief The pool of constraint solvers the islands are solved with in
+   * the multithreaded world, null otherwise.*/
+  std::unique_ptr<btConstraintSolverPoolMt> bSolverPool_;
+  std::unique_ptr<btConstraintSolver> bSolver_;
+  std::unique_ptr<btCollisionDispatcher> bDispatcher_;
 
-  /** @brief A pointer to the Bullet world. See @ref btMultiBodyDynamicsWorld.*/
-  std::shared_ptr<btMultiBodyDynamicsWorld> bWorld_;
+  /** @brief A pointer to the Bullet world. See @ref btMultiBodyDynamicsWorld
+   * and @ref btDiscreteDynamicsWorldMt.*/
+  std::shared_ptr<btDiscreteDynamicsWorld> bWorld_;
 
   mutable Magnum::BulletIntegration::DebugDraw debugDrawer_;
 
@@ -241,6 +307,10 @@ class BulletPhysicsManager : public PhysicsManager {
   std::shared_ptr<std::map<const btCollisionObject*, int>>
       collisionObjToObjIds_;
 
+  //! convex hulls of the collision assets, shared between the objects
+  //! instancing them
+  BulletCollisionShapeCache::ptr collisionShapeCache_;
+
  private:
   /** @brief Check if a particular mesh can be used as a collision mesh for
    * Bullet.
@@ -36,12 +36,14 @@ BulletRigidObject::BulletRigidObject(
     scene::SceneNode* rigidBodyNode,
     int objectId,
     const assets::ResourceManager& resMgr,
-    std::shared_ptr<btMultiBodyDynamicsWorld> bWorld,
+    std::shared_ptr<btDiscreteDynamicsWorld> bWorld,
     std::shared_ptr<std::map<const btCollisionObject*, int> >
-        collisionObjToObjIds)
+        collisionObjToObjIds,
+    std::shared_ptr<BulletCollisionShapeCache> collisionShapeCache)
     : BulletBase(std::move(bWorld), std::move(collisionObjToObjIds)),
       RigidObject(rigidBodyNode, objectId, resMgr),
-      MotionState(*rigidBodyNode) {}
+      MotionState(*rigidBodyNode),
+      collisionShapeCache_(std::move(collisionShapeCache)) {}
 
 BulletRigidObject::~BulletRigidObject() {
   if (!isActive()) {
@@ -114,34 +116,57 @@ bool BulletRigidObject::constructCollisionShape() {
     bGenericShapes_.emplace_back(std::move(primObjPtr));
     bObjectShape_->addChildShape(btTransform::getIdentity(),
                                  bGenericShapes_.back().get());
-    bObjectShape_->recalculateLocalAabb();
+    bObjectShape_->setLocalScaling(btVector3{tmpAttr->getScale()});
+  } else if (usingBBCollisionShape_) {
+    // the box is added once the bounding box is known
+    bObjectShape_->setLocalScaling(btVector3{tmpAttr->getScale()});
   } else {
-    // mesh collider
-    const std::vector<assets::CollisionMeshData>& meshGroup =
-        resMgr_.getCollisionMesh(collisionAssetHandle);
-    const assets::MeshMetaData& metaData =
-        resMgr_.getMeshMetaData(collisionAssetHandle);
-
-    if (!usingBBCollisionShape_) {
+    // mesh collider, built once per asset and scale and shared with the other
+    // instances
+    const BulletCollisionShapeCache::Key key{
+        collisionAssetHandle, joinCollisionMeshes,
+        tmpAttr->getCollisionAssetSize(), tmpAttr->getScale()};
+    auto cached = collisionShapeCache_->hulls.find(key);
+    if (cached != collisionShapeCache_->hulls.end()) {
+      bObjectConvexShapes_ = cached->second;
+    } else {
+      const std::vector<assets::CollisionMeshData>& meshGroup =
+          resMgr_.getCollisionMesh(collisionAssetHandle);
+      const assets::MeshMetaData& metaData =
+          resMgr_.getMeshMetaData(collisionAssetHandle);
       constructBulletCompoundFromMeshes(Magnum::Matrix4{}, meshGroup,
                                         metaData.root, joinCollisionMeshes);
 
-      // add the final object after joining meshes
-      if (joinCollisionMeshes) {
-        bObjectConvexShapes_.back()->setLocalScaling(
-            btVector3(tmpAttr->getCollisionAssetSize()));
-        bObjectConvexShapes_.back()->setMargin(0.0);
-        bObjectConvexShapes_.back()->recalcLocalAabb();
-        bObjectShape_->addChildShape(btTransform::getIdentity(),
-                                     bObjectConvexShapes_.back().get());
+      // bake the scale of the object into the hulls, the collision asset
+      // size only applies to joined meshes
+      const Magnum::Vector3 hullScale =
+          joinCollisionMeshes
+              ? tmpAttr->getCollisionAssetSize() * tmpAttr->getScale()
+              : tmpAttr->getScale();
+      for (auto& convexShape : bObjectConvexShapes_) {
+        // keep only the vertices on the hull, all the vertices of the mesh
+        // were added
+        if (convexShape->getNumPoints() > 0) {
+          convexShape->optimizeConvexHull();
+        }
+        convexShape->setLocalScaling(btVector3{hullScale});
+        // Remove local convex margin in favor of margin on the containing
+        // compound
+        convexShape->setMargin(0.0);
+        convexShape->recalcLocalAabb();
       }
+      collisionShapeCache_->hulls.emplace(key, bObjectConvexShapes_);
+    }
+
+    //! Add to compound shape stucture
+    for (auto& convexShape : bObjectConvexShapes_) {
+      bObjectShape_->addChildShape(btTransform::getIdentity(),
+                                   convexShape.get());
     }
   }  // if using prim collider else use mesh collider
 
   //! Set properties
   bObjectShape_->setMargin(margin);
-
-  bObjectShape_->setLocalScaling(btVector3{tmpAttr->getScale()});
   bObjectShape_->recalculateLocalAabb();
 
   if (!originShift_.isZero()) {
@@ -239,7 +264,7 @@ void BulletRigidObject::constructBulletCompoundFromMeshes(
       if (bObjectConvexShapes_.empty()) {
         // create the convex if it does not exist
         bObjectConvexShapes_.emplace_back(
-            std::make_unique<btConvexHullShape>());
+            std::make_shared<btConvexHullShape>());
       }
 
       // add points
@@ -249,22 +274,14 @@ void BulletRigidObject::constructBulletCompoundFromMeshes(
       }
 
     } else {
-      bObjectConvexShapes_.emplace_back(std::make_unique<btConvexHullShape>());
+      bObjectConvexShapes_.emplace_back(std::make_shared<btConvexHullShape>());
       // transform points into world space, including any scale/shear in
       // transformFromLocalToWorld.
       for (auto& v : mesh.positions) {
         bObjectConvexShapes_.back()->addPoint(
             btVector3(transformFromLocalToWorld.transformPoint(v)), false);
       }
-      // bObjectConvexShapes_.back()->optimizeConvexHull();
       // bObjectConvexShapes_.back()->initializePolyhedralFeatures();
-      // Remove local convex margin in favor of margin on the containing
-      // compound
-      bObjectConvexShapes_.back()->setMargin(0.0);
-      bObjectConvexShapes_.back()->recalcLocalAabb();
-      //! Add to compound shape stucture
-      bObjectShape_->addChildShape(btTransform::getIdentity(),
-                                   bObjectConvexShapes_.back().get());
     }
   }
 
@@ -274,6 +291,36 @@ void BulletRigidObject::constructBulletCompoundFromMeshes(
   }
 }  // constructBulletCompoundFromMeshes
 
+void BulletRigidObject::setMargin(const double margin) {
+  for (auto& convexShape : bObjectConvexShapes_) {
+    if (convexShape->getMargin() == margin) {
+      continue;
+    }
+    if (convexShape.use_count() > 1) {
+      // shared with the cache and possibly other objects, replace it in the
+      // compound by a copy of this object's own
+      auto copy = std::make_shared<btConvexHullShape>();
+      for (int i = 0; i < convexShape->getNumPoints(); ++i) {
+        copy->addPoint(convexShape->getUnscaledPoints()[i], false);
+      }
+      copy->setLocalScaling(convexShape->getLocalScaling());
+      for (int i = 0; i < bObjectShape_->getNumChildShapes(); ++i) {
+        if (bObjectShape_->getChildShape(i) == convexShape.get()) {
+          const btTransform childTransform =
+              bObjectShape_->getChildTransform(i);
+          bObjectShape_->removeChildShapeByIndex(i);
+          bObjectShape_->addChildShape(childTransform, copy.get());
+          break;
+        }
+      }
+      convexShape = std::move(copy);
+    }
+    convexShape->setMargin(margin);
+  }
+  bObjectShape_->setMargin(margin);
+  bObjectShape_->recalculateLocalAabb();
+}  // setMargin
+
 void BulletRigidObject::setCollisionFromBB() {
   btVector3 dim(node().getCumulativeBB().size() / 2.0);
 
@@ -6,7 +6,7 @@
 #define ESP_PHYSICS_BULLET_BULLETRIGIDOBJECT_H_
 
 /** @file
- * @brief Struct SimulationContactResultCallback, class @ref
+ * @brief Struct @ref esp::physics::BulletCollisionShapeCache, class @ref
  * esp::physics::BulletRigidObject
  */
 
@@ -16,7 +16,11 @@
 #include <Magnum/BulletIntegration/MotionState.h>
 #include <btBulletDynamicsCommon.h>
 
-#include "BulletDynamics/Featherstone/btMultiBodyDynamicsWorld.h"
+#include <map>
+#include <string>
+#include <tuple>
+
+#include "BulletDynamics/Dynamics/btDiscreteDynamicsWorld.h"
 
 #include "esp/core/esp.h"
 
@@ -26,6 +30,40 @@
 namespace esp {
 namespace physics {
 
+/**
+ * @brief Convex hulls built from the collision meshes of assets, shared by all
+ * the @ref BulletRigidObject instances of an asset at the same scale.
+ *
+ * The hulls are scaled when they are built since scaling a @ref
+ * btCompoundShape scales its children, so each scale has its own entry.
+ */
+struct BulletCollisionShapeCache {
+  //! Identifies the hulls built for a collision asset
+  struct Key {
+    std::string collisionAssetHandle;
+    bool joinCollisionMeshes;
+    Magnum::Vector3 collisionAssetSize;
+    Magnum::Vector3 scale;
+
+    bool operator<(const Key& other) const {
+      return std::make_tuple(collisionAssetHandle, joinCollisionMeshes,
+                             collisionAssetSize.x(), collisionAssetSize.y(),
+                             collisionAssetSize.z(), scale.x(), scale.y(),
+                             scale.z()) <
+             std::make_tuple(other.collisionAssetHandle,
+                             other.joinCollisionMeshes,
+                             other.collisionAssetSize.x(),
+                             other.collisionAssetSize.y(),
+                             other.collisionAssetSize.z(), other.scale.x(),
+                             other.scale.y(), other.scale.z());
+    }
+  };
+
+  std::map<Key, std::vector<std::shared_ptr<btConvexHullShape>>> hulls;
+
+  ESP_SMART_POINTERS(BulletCollisionShapeCache)
+};
+
 /**
  * @brief An individual rigid object instance implementing an interface with
  * Bullet physics to enable dynamic objects. See @ref btRigidBody for @ref
@@ -48,13 +86,17 @@ class BulletRigidObject : public BulletBase,
    * @param bWorld The Bullet world to which this object will belong.
    * @param collisionObjToObjIds The global map of btCollisionObjects to Habitat
    * object IDs for contact query identification.
-   */
-  BulletRigidObject(scene::SceneNode* rigidBodyNode,
-                    int objectId,
-                    const assets::ResourceManager& resMgr,
-                    std::shared_ptr<btMultiBodyDynamicsWorld> bWorld,
-                    std::shared_ptr<std::map<const btCollisionObject*, int>>
-                        collisionObjToObjIds);
+   * @param collisionShapeCache The convex hulls shared between the objects of
+   * the world.
+   */
+  BulletRigidObject(
+      scene::SceneNode* rigidBodyNode,
+      int objectId,
+      const assets::ResourceManager& resMgr,
+      std::shared_ptr<btDiscreteDynamicsWorld> bWorld,
+      std::shared_ptr<std::map<const btCollisionObject*, int>>
+          collisionObjToObjIds,
+      std::shared_ptr<BulletCollisionShapeCache> collisionShapeCache);
 
   /**
    * @brief Destructor cleans up simulation structures for the object.
@@ -81,10 +123,10 @@ class BulletRigidObject : public BulletBase,
   // const assets::AbstractPrimitiveAttributes& primAttributes);
 
   /**
-   * @brief Recursively construct a @ref btCompoundShape for collision from
-   * loaded mesh assets. A @ref btConvexHullShape is constructed for each
-   * sub-component, transformed to object-local space and added to the compound
-   * in a flat manner for efficiency.
+   * @brief Recursively construct the convex hulls for collision from loaded
+   * mesh assets into @ref bObjectConvexShapes_. A @ref btConvexHullShape is
+   * constructed for each sub-component, transformed to object-local space, in
+   * a flat manner for efficiency.
    * @param transformFromParentToWorld The cumulative parent-to-world
    * transformation matrix constructed by composition down the @ref
    * MeshTransformNode tree to the current node.
@@ -100,7 +142,9 @@ class BulletRigidObject : public BulletBase,
       bool join);
 
   /**
-   * @brief Construct the @ref bObjectShape_ for this object.
+   * @brief Construct the @ref bObjectShape_ for this object. The convex hulls
+   * of mesh colliders are taken from the @ref BulletCollisionShapeCache if
+   * another object of the same asset and scale built them already.
    * @return Whether or not construction was successful.
    */
   bool constructCollisionShape();
@@ -399,15 +443,11 @@ class BulletRigidObject : public BulletBase,
   }
 
   /** @brief Set the scalar collision margin of an object. See @ref
-   * btCompoundShape::setMargin.
+   * btCompoundShape::setMargin. Convex hulls shared with other objects are
+   * copied first so that their margin is left untouched.
    * @param margin The new scalar collision margin of the object.
    */
-  void setMargin(const double margin) override {
-    for (std::size_t i = 0; i < bObjectConvexShapes_.size(); i++) {
-      bObjectConvexShapes_[i]->setMargin(margin);
-    }
-    bObjectShape_->setMargin(margin);
-  }
+  void setMargin(const double margin) override;
 
   /** @brief Sets the object's collision shape to its bounding box.
    * Since the bounding hierarchy is not constructed when the object is
@@ -432,6 +472,14 @@ class BulletRigidObject : public BulletBase,
    */
   bool contactTest();
 
+  /**
+   * @brief Get the collision object of this object in the Bullet world, e.g.
+   * to find it in the contact manifolds of the dispatcher.
+   */
+  const btCollisionObject* getCollisionObject() const {
+    return bObjectRigidBody_.get();
+  }
+
   /**
    * @brief Query the Aabb from bullet physics for the root compound shape of
    * the rigid body in its local space. See @ref btCompoundShape::getAabb.
@@ -483,8 +531,12 @@ class BulletRigidObject : public BulletBase,
   //! deffered construction of collision shape
   Mn::Vector3 originShift_;
 
-  //! Object data: Composite convex collision shape
-  std::vector<std::unique_ptr<btConvexHullShape>> bObjectConvexShapes_;
+  //! Object data: Composite convex collision shape, possibly shared with
+  //! other objects through the @ref collisionShapeCache_
+  std::vector<std::shared_ptr<btConvexHullShape>> bObjectConvexShapes_;
+
+  //! convex hulls shared between the objects of the world
+  std::shared_ptr<BulletCollisionShapeCache> collisionShapeCache_;
 
   //! list of @ref btCollisionShape for storing arbitrary collision shapes
   //! referenced within the @ref bObjectShape_.
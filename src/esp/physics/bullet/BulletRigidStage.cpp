@@ -5,6 +5,13 @@
 #include <Magnum/BulletIntegration/DebugDraw.h>
 #include <Magnum/BulletIntegration/Integration.h>
 
+#include <Corrade/Utility/Directory.h>
+
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <random>
+#include <sstream>
 #include <utility>
 
 #include "BulletCollision/CollisionShapes/btCompoundShape.h"
@@ -14,17 +21,127 @@
 #include "BulletCollision/NarrowPhaseCollision/btRaycastCallback.h"
 #include "BulletRigidStage.h"
 
+namespace Cr = Corrade;
+
 namespace esp {
 namespace physics {
 
+namespace {
+
+//! header of a cached bounding volume hierarchy, followed by the hierarchy
+//! serialized in place
+struct BvhCacheHeader {
+  char magic[8];
+  std::uint64_t size;
+};
+
+constexpr char BvhCacheMagic[8] = "ESPBVH1";
+
+//! memory aligned as the in-place (de)serialization of btQuantizedBvh needs
+Cr::Containers::Array<char> alignedBvhData(std::size_t size) {
+  return Cr::Containers::Array<char>{
+      static_cast<char*>(btAlignedAlloc(size, 16)), size,
+      [](char* data, std::size_t) { btAlignedFree(data); }};
+}
+
+std::uint64_t fnv1a(std::uint64_t hash, const void* data, std::size_t size) {
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  for (std::size_t i = 0; i < size; ++i) {
+    hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+  }
+  return hash;
+}
+
+//! name of the cached hierarchy of a mesh, a hash of everything it depends on
+std::string bvhCacheFilename(const assets::CollisionMeshData& mesh,
+                             const btScalar margin,
+                             const btVector3& scaling) {
+  std::uint64_t hash = 0xcbf29ce484222325ull;
+  const int version[]{BT_BULLET_VERSION, int(sizeof(btScalar)),
+                      int(sizeof(void*))};
+  hash = fnv1a(hash, version, sizeof(version));
+  hash = fnv1a(hash, mesh.positions.data(),
+               mesh.positions.size() * sizeof(Magnum::Vector3));
+  hash = fnv1a(hash, mesh.indices.data(),
+               mesh.indices.size() * sizeof(Magnum::UnsignedInt));
+  hash = fnv1a(hash, &margin, sizeof(margin));
+  const btScalar scale[]{scaling.x(), scaling.y(), scaling.z()};
+  hash = fnv1a(hash, scale, sizeof(scale));
+
+  std::ostringstream filename;
+  filename << std::hex << std::setw(16) << std::setfill('0') << hash << ".bvh";
+  return filename.str();
+}
+
+//! returns an empty array if the file does not exist or is not a valid cache
+Cr::Containers::Array<char> readBvhCache(const std::string& filename) {
+  std::ifstream file{filename, std::ios::binary | std::ios::ate};
+  if (!file) {
+    return nullptr;
+  }
+  const std::uint64_t fileSize = file.tellg();
+  file.seekg(0);
+
+  BvhCacheHeader header;
+  if (fileSize < sizeof(BvhCacheHeader) ||
+      !file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+      std::memcmp(header.magic, BvhCacheMagic, sizeof(BvhCacheMagic)) != 0 ||
+      header.size != fileSize - sizeof(BvhCacheHeader)) {
+    LOG(WARNING) << "BulletRigidStage: ignoring invalid BVH cache file "
+                 << filename;
+    return nullptr;
+  }
+
+  Cr::Containers::Array<char> data = alignedBvhData(header.size);
+  if (!file.read(data.data(), data.size())) {
+    return nullptr;
+  }
+  return data;
+}
+
+void writeBvhCache(const std::string& filename, const btOptimizedBvh& bvh) {
+  const unsigned size = bvh.calculateSerializeBufferSize();
+  Cr::Containers::Array<char> data = alignedBvhData(size);
+  if (!bvh.serializeInPlace(data.data(), size, false)) {
+    return;
+  }
+
+  // write to a file of its own first, so that concurrent loads of the stage
+  // never see a partial file
+  const std::string tmpFilename =
+      filename + "." + std::to_string(std::random_device{}()) + ".tmp";
+  {
+    std::ofstream file{tmpFilename, std::ios::binary};
+    BvhCacheHeader header;
+    std::memcpy(header.magic, BvhCacheMagic, sizeof(BvhCacheMagic));
+    header.size = size;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(data.data(), data.size());
+    if (!file) {
+      LOG(WARNING) << "BulletRigidStage: cannot write BVH cache file "
+                   << tmpFilename;
+      file.close();
+      Cr::Utility::Directory::rm(tmpFilename);
+      return;
+    }
+  }
+  if (!Cr::Utility::Directory::move(tmpFilename, filename)) {
+    Cr::Utility::Directory::rm(tmpFilename);
+  }
+}
+
+}  // namespace
+
 BulletRigidStage::BulletRigidStage(
     scene::SceneNode* rigidBodyNode,
     const assets::ResourceManager& resMgr,
-    std::shared_ptr<btMultiBodyDynamicsWorld> bWorld,
+    std::shared_ptr<btDiscreteDynamicsWorld> bWorld,
     std::shared_ptr<std::map<const btCollisionObject*, int> >
-        collisionObjToObjIds)
+        collisionObjToObjIds,
+    std::string bvhCacheDirectory)
     : BulletBase(std::move(bWorld), std::move(collisionObjToObjIds)),
-      RigidStage{rigidBodyNode, resMgr} {}
+      RigidStage{rigidBodyNode, resMgr},
+      bvhCacheDirectory_(std::move(bvhCacheDirectory)) {}
 
 BulletRigidStage::~BulletRigidStage() {
   // remove collision objects from the world
@@ -129,16 +246,16 @@ void BulletRigidStage::constructBulletSceneFromMeshes(
     //! Embed 3D mesh into bullet shape
     //! btBvhTriangleMeshShape is the most generic/slow choice
     //! which allows concavity if the object is static
+    //! The bvh is built once margin and scale are set, or loaded
     std::unique_ptr<btBvhTriangleMeshShape> meshShape =
         std::make_unique<btBvhTriangleMeshShape>(indexedVertexArray.get(),
-                                                 true);
+                                                 true, false);
     meshShape->setMargin(initializationAttributes_->getMargin());
-    meshShape->setLocalScaling(
+    loadOrBuildOptimizedBvh(
+        *meshShape, mesh,
         btVector3{transformFromLocalToWorld
                       .scaling()});  // scale is a property of the shape
 
-    // re-build the bvh after setting margin
-    meshShape->buildOptimizedBvh();
     // mass == 0 to indicate static. See isStaticObject assert below. See also
     // examples/MultiThreadedDemo/CommonRigidBodyMTBase.h
     btVector3 localInertia(0, 0, 0);
@@ -160,6 +277,41 @@ void BulletRigidStage::constructBulletSceneFromMeshes(
   }
 }  // constructBulletSceneFromMeshes
 
+void BulletRigidStage::loadOrBuildOptimizedBvh(
+    btBvhTriangleMeshShape& meshShape,
+    const assets::CollisionMeshData& mesh,
+    const btVector3& scaling) {
+  std::string cacheFilename;
+  if (!bvhCacheDirectory_.empty()) {
+    cacheFilename = Cr::Utility::Directory::join(
+        bvhCacheDirectory_,
+        bvhCacheFilename(mesh, meshShape.getMargin(), scaling));
+    Cr::Containers::Array<char> data = readBvhCache(cacheFilename);
+    if (!data.empty()) {
+      btOptimizedBvh* bvh =
+          btOptimizedBvh::deSerializeInPlace(data.data(), data.size(), false);
+      if (bvh != nullptr) {
+        // sets the scaling without rebuilding the hierarchy
+        meshShape.setOptimizedBvh(bvh, scaling);
+        bStageBvhData_.emplace_back(std::move(data));
+        return;
+      }
+      LOG(WARNING) << "BulletRigidStage: cannot load BVH cache file "
+                   << cacheFilename;
+    }
+  }
+
+  // btBvhTriangleMeshShape::setLocalScaling() would build the hierarchy a
+  // first time
+  meshShape.btTriangleMeshShape::setLocalScaling(scaling);
+  meshShape.buildOptimizedBvh();
+
+  if (!cacheFilename.empty() &&
+      Cr::Utility::Directory::mkpath(bvhCacheDirectory_)) {
+    writeBvhCache(cacheFilename, *meshShape.getOptimizedBvh());
+  }
+}  // loadOrBuildOptimizedBvh
+
 void BulletRigidStage::setFrictionCoefficient(
     const double frictionCoefficient) {
   for (std::size_t i = 0; i < bStaticCollisionObjects_.size(); i++) {
@@ -5,6 +5,10 @@
 #ifndef ESP_PHYSICS_BULLET_BULLETRIGIDSTAGE_H_
 #define ESP_PHYSICS_BULLET_BULLETRIGIDSTAGE_H_
 
+#include <Corrade/Containers/Array.h>
+
+#include <string>
+
 #include "esp/physics/RigidStage.h"
 #include "esp/physics/bullet/BulletBase.h"
 
@@ -21,11 +25,24 @@ namespace physics {
 
 class BulletRigidStage : public BulletBase, public RigidStage {
  public:
+  /**
+   * @brief Constructor for a @ref BulletRigidStage.
+   * @param rigidBodyNode The @ref scene::SceneNode this feature will be
+   * attached to.
+   * @param resMgr Reference to resource manager, to access relevant components
+   * pertaining to the stage
+   * @param bWorld The Bullet world to which this stage will belong.
+   * @param collisionObjToObjIds The global map of btCollisionObjects to Habitat
+   * object IDs for contact query identification.
+   * @param bvhCacheDirectory Directory where the bounding volume hierarchies
+   * of the stage meshes are cached between loads. Empty to always build them.
+   */
   BulletRigidStage(scene::SceneNode* rigidBodyNode,
                    const assets::ResourceManager& resMgr,
-                   std::shared_ptr<btMultiBodyDynamicsWorld> bWorld,
+                   std::shared_ptr<btDiscreteDynamicsWorld> bWorld,
                    std::shared_ptr<std::map<const btCollisionObject*, int>>
-                       collisionObjToObjIds);
+                       collisionObjToObjIds,
+                   std::string bvhCacheDirectory = "");
 
   /**
    * @brief Destructor cleans up simulation structures for the stage object.
@@ -56,6 +73,19 @@ class BulletRigidStage : public BulletBase, public RigidStage {
       const std::vector<assets::CollisionMeshData>& meshGroup,
       const assets::MeshTransformNode& node);
 
+  /**
+   * @brief Give a mesh shape its bounding volume hierarchy, loaded from the
+   * @ref bvhCacheDirectory_ if a previous load of the same mesh with the same
+   * margin and scale stored it there, built and stored there otherwise.
+   * @param meshShape The shape, constructed without a hierarchy and with its
+   * margin set.
+   * @param mesh The collision mesh of the shape.
+   * @param scaling The local scaling of the shape.
+   */
+  void loadOrBuildOptimizedBvh(btBvhTriangleMeshShape& meshShape,
+                               const assets::CollisionMeshData& mesh,
+                               const btVector3& scaling);
+
   /**
    * @brief Adds static stage collision objects to the simulation world after
    * contructing them if necessary.
@@ -108,9 +138,16 @@ class BulletRigidStage : public BulletBase, public RigidStage {
   //! Stage data: Bullet triangular mesh vertices
   std::vector<std::unique_ptr<btTriangleIndexVertexArray>> bStageArrays_;
 
+  //! Stage data: memory of the bounding volume hierarchies loaded from the
+  //! cache, which the mesh shapes reference without owning
+  std::vector<Corrade::Containers::Array<char>> bStageBvhData_;
+
   //! Stage data: Bullet triangular mesh shape
   std::vector<std::unique_ptr<btBvhTriangleMeshShape>> bStageShapes_;
 
+  //! directory of the cached bounding volume hierarchies, empty if disabled
+  std::string bvhCacheDirectory_;
+
  public:
   ESP_SMART_POINTERS(BulletRigidStage)
 
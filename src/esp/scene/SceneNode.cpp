@@ -47,5 +47,22 @@ const Mn::Range3D& SceneNode::computeCumulativeBB() {
   return cumulativeBB_;
 }
 
+Corrade::Containers::Optional<Mn::Range3D> SceneNode::getWorldAABB() {
+  if (aabb_) {
+    return aabb_;
+  }
+  if (!hasMeshBB_) {
+    return Corrade::Containers::NullOpt;
+  }
+  // any transformation of this node or of an ancestor marks it dirty again,
+  // so a clean node still has the transformation the box was computed with
+  if (!worldAABB_ || isDirty()) {
+    worldAABB_ =
+        esp::geo::getTransformedBB(meshBB_, absoluteTransformationMatrix());
+    setClean();
+  }
+  return worldAABB_;
+}
+
 }  // namespace scene
 }  // namespace esp
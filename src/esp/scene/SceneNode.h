@@ -46,10 +46,11 @@ class SceneNode : public MagnumObject {
   void setType(SceneNodeType type) { type_ = type; }
 
   // Add a feature. Used to avoid naked `new` and makes intent clearer.
+  // Returns the feature, which is owned by this node.
   template <class U, class... Args>
-  void addFeature(Args&&... args) {
+  U& addFeature(Args&&... args) {
     // NOLINTNEXTLINE(clang-analyzer-cplusplus.NewDeleteLeaks)
-    new U{*this, std::forward<Args>(args)...};
+    return *new U{*this, std::forward<Args>(args)...};
   }
 
   //! Create a new child SceneNode and return it. NOTE: this SceneNode owns and
@@ -89,8 +90,24 @@ class SceneNode : public MagnumObject {
   //! this node is the root
   const Magnum::Range3D& getCumulativeBB() const { return cumulativeBB_; };
 
+  /**
+   * @brief return the global bounding box for the mesh stored at this node,
+   * for static and dynamic meshes alike
+   *
+   * Static meshes return their precomputed absolute AABB. Otherwise the local
+   * mesh bounding box is transformed by the absolute transformation of this
+   * node and cached; the cache is only recomputed when this node or one of its
+   * ancestors has been transformed since (i.e. the node is dirty). Returns
+   * NullOpt if no mesh bounding box was set on this node.
+   */
+  Corrade::Containers::Optional<Magnum::Range3D> getWorldAABB();
+
   //! set local bounding box for meshes stored at this node
-  void setMeshBB(Magnum::Range3D meshBB) { meshBB_ = std::move(meshBB); };
+  void setMeshBB(Magnum::Range3D meshBB) {
+    meshBB_ = std::move(meshBB);
+    hasMeshBB_ = true;
+    worldAABB_ = Corrade::Containers::NullOpt;
+  };
 
   //! set the global bounding box for mesh stored in this node
   void setAbsoluteAABB(Magnum::Range3D aabb) { aabb_ = std::move(aabb); };
@@ -130,6 +147,14 @@ class SceneNode : public MagnumObject {
   Corrade::Containers::Optional<Magnum::Range3D> aabb_ =
       Corrade::Containers::NullOpt;
 
+  //! whether meshBB_ was set, i.e. this node stores a mesh
+  bool hasMeshBB_ = false;
+
+  //! the cached global bounding box for *dynamic* meshes stored at this node,
+  //  valid as long as the node stays clean
+  Corrade::Containers::Optional<Magnum::Range3D> worldAABB_ =
+      Corrade::Containers::NullOpt;
+
   //! the frustum plane in last frame that culls this node
   int frustumPlaneIndex = 0;
 };
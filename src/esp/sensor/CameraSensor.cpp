@@ -9,6 +9,7 @@
 
 #include "CameraSensor.h"
 #include "esp/gfx/DepthUnprojection.h"
+#include "esp/gfx/RenderTarget.h"
 #include "esp/gfx/Renderer.h"
 #include "esp/sim/Simulator.h"
 
@@ -112,6 +113,58 @@ bool CameraSensor::getObservation(sim::Simulator& sim, Observation& obs) {
   return true;
 }
 
+bool CameraSensor::getObservationAsync(sim::Simulator& sim,
+                                       Observation& obs) {
+  if (!hasRenderTarget())
+    return false;
+
+  drawObservation(sim);
+  readObservationAsync(obs);
+
+  return true;
+}
+
+bool CameraSensor::canShareObservationDraw(sim::Simulator& sim,
+                                          CameraSensor& other) {
+  if (&other == this) {
+    return true;
+  }
+  if (!other.hasRenderTarget() ||
+      other.framebufferSize() != framebufferSize() ||
+      other.projectionMatrix_ != projectionMatrix_ ||
+      other.node().absoluteTransformationMatrix() !=
+          node().absoluteTransformationMatrix()) {
+    return false;
+  }
+  // a semantic sensor with a separate semantic scene graph draws that graph
+  // instead of the stage of the active one, and draws without the mesh levels
+  // of detail the other sensors use
+  const bool separateSemanticGraph =
+      &sim.getActiveSemanticSceneGraph() != &sim.getActiveSceneGraph();
+  const bool meshLODs =
+      sim.getMetadataMediator()->getSimulatorConfiguration().generateMeshLODs;
+  return !(separateSemanticGraph || meshLODs) ||
+         (spec_->sensorType == SensorType::Semantic) ==
+             (other.spec_->sensorType == SensorType::Semantic);
+}
+
+bool CameraSensor::getObservationFrom(CameraSensor& drawn, Observation& obs) {
+  if (!drawn.hasRenderTarget())
+    return false;
+
+  readObservation(obs, drawn.renderTarget());
+  return true;
+}
+
+bool CameraSensor::getObservationFromAsync(CameraSensor& drawn,
+                                           Observation& obs) {
+  if (!drawn.hasRenderTarget())
+    return false;
+
+  readObservationAsync(obs, drawn.renderTarget());
+  return true;
+}
+
 bool CameraSensor::drawObservation(sim::Simulator& sim) {
   if (!hasRenderTarget()) {
     return false;
@@ -119,9 +172,13 @@ bool CameraSensor::drawObservation(sim::Simulator& sim) {
 
   renderTarget().renderEnter();
 
-  gfx::RenderCamera::Flags flags;
+  // copies of the same asset are merged into instanced draws where possible
+  gfx::RenderCamera::Flags flags{gfx::RenderCamera::Flag::Instancing};
   if (sim.isFrustumCullingEnabled())
     flags |= gfx::RenderCamera::Flag::FrustumCulling;
+  // simplified meshes would shift the boundaries between semantic ids
+  if (spec_->sensorType != SensorType::Semantic)
+    flags |= gfx::RenderCamera::Flag::MeshLOD;
 
   gfx::Renderer::ptr renderer = sim.getRenderer();
   if (spec_->sensorType == SensorType::Semantic) {
@@ -141,7 +198,8 @@ bool CameraSensor::drawObservation(sim::Simulator& sim) {
   return true;
 }
 
-void CameraSensor::readObservation(Observation& obs) {
+void CameraSensor::readObservation(Observation& obs,
+                                   gfx::RenderTarget& target) {
   // Make sure we have memory
   if (buffer_ == nullptr) {
     // TODO: check if our sensor was resized and resize our buffer if needed
@@ -154,20 +212,52 @@ void CameraSensor::readObservation(Observation& obs) {
   // TODO: have different classes for the different types of sensors
   // TODO: do we need to flip axis?
   if (spec_->sensorType == SensorType::Semantic) {
-    renderTarget().readFrameObjectId(Magnum::MutableImageView2D{
-        Magnum::PixelFormat::R32UI, renderTarget().framebufferSize(),
+    target.readFrameObjectId(Magnum::MutableImageView2D{
+        Magnum::PixelFormat::R32UI, target.framebufferSize(),
         obs.buffer->data});
   } else if (spec_->sensorType == SensorType::Depth) {
-    renderTarget().readFrameDepth(Magnum::MutableImageView2D{
-        Magnum::PixelFormat::R32F, renderTarget().framebufferSize(),
+    target.readFrameDepth(Magnum::MutableImageView2D{
+        Magnum::PixelFormat::R32F, target.framebufferSize(),
         obs.buffer->data});
   } else {
-    renderTarget().readFrameRgba(Magnum::MutableImageView2D{
-        Magnum::PixelFormat::RGBA8Unorm, renderTarget().framebufferSize(),
+    target.readFrameRgba(Magnum::MutableImageView2D{
+        Magnum::PixelFormat::RGBA8Unorm, target.framebufferSize(),
         obs.buffer->data});
   }
 }
 
+void CameraSensor::readObservationAsync(Observation& obs,
+                                        gfx::RenderTarget& target) {
+  // Make sure we have memory
+  if (asyncBuffers_.empty()) {
+    ObservationSpace space;
+    getObservationSpace(space);
+    for (int i = 0; i < gfx::RenderTarget::NumReadbackBuffers; ++i) {
+      asyncBuffers_.emplace_back(
+          core::Buffer::create(space.shape, space.dataType));
+    }
+  }
+  obs.buffer = asyncBuffers_[nextAsyncBuffer_];
+  nextAsyncBuffer_ = (nextAsyncBuffer_ + 1) % asyncBuffers_.size();
+
+  if (spec_->sensorType == SensorType::Semantic) {
+    obs.pending = target.readFrameObjectIdAsync(
+        Magnum::MutableImageView2D{Magnum::PixelFormat::R32UI,
+                                   target.framebufferSize(),
+                                   obs.buffer->data});
+  } else if (spec_->sensorType == SensorType::Depth) {
+    obs.pending = target.readFrameDepthAsync(
+        Magnum::MutableImageView2D{Magnum::PixelFormat::R32F,
+                                   target.framebufferSize(),
+                                   obs.buffer->data});
+  } else {
+    obs.pending = target.readFrameRgbaAsync(
+        Magnum::MutableImageView2D{Magnum::PixelFormat::RGBA8Unorm,
+                                   target.framebufferSize(),
+                                   obs.buffer->data});
+  }
+}
+
 Corrade::Containers::Optional<Magnum::Vector2> CameraSensor::depthUnprojection()
     const {
   // projectionMatrix_ is managed by implementation class and is set whenever
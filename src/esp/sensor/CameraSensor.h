@@ -44,6 +44,48 @@ class CameraSensor : public VisualSensor {
    */
   virtual bool getObservation(sim::Simulator& sim, Observation& obs) override;
 
+  /**
+   * @brief Draws an observation to the frame buffer using simulator's renderer,
+   * then starts reading it into one of the sensor's memory buffers without
+   * waiting for the GPU.  The observation is in obs.buffer once obs.pending
+   * has been waited on
+   * @return true if success, otherwise false (e.g., failed to draw or read
+   * observation)
+   * @param[in] sim Instance of Simulator class for which the observation needs
+   *                to be drawn, obs Instance of Observation class in which the
+   * observation will be stored
+   */
+  virtual bool getObservationAsync(sim::Simulator& sim,
+                                   Observation& obs) override;
+
+  /**
+   * @brief Whether the observation of this sensor can be read from the frame
+   * drawn for @p other instead of being drawn again: both sensors are at the
+   * same pose, have the same resolution and projection, and draw the same
+   * scene graphs. The render target holds color, depth and object ids of
+   * every frame, so e.g. co-located RGB, depth and semantic sensors share a
+   * single draw unless the semantic scene graph is a separate one or mesh
+   * levels of detail are generated.
+   * @param[in] sim Instance of Simulator class the observations are drawn for
+   * @param[in] other The sensor whose frame would be read
+   */
+  bool canShareObservationDraw(sim::Simulator& sim, CameraSensor& other);
+
+  /**
+   * @brief Reads the observation of this sensor from the frame that was
+   * drawn for @p drawn, see @ref canShareObservationDraw()
+   * @return true if success, otherwise false
+   * @param[in] drawn The sensor whose frame was drawn, obs Instance of
+   * Observation class in which the observation will be stored
+   */
+  bool getObservationFrom(CameraSensor& drawn, Observation& obs);
+
+  /**
+   * @brief Same as @ref getObservationFrom, but only starts reading the
+   * observation, as in @ref getObservationAsync
+   */
+  bool getObservationFromAsync(CameraSensor& drawn, Observation& obs);
+
   /**
    * @brief Updates ObservationSpace space with spaceType, shape, and dataType
    * of this sensor. The information in space is later used to resize the
@@ -191,7 +233,39 @@ class CameraSensor : public VisualSensor {
    * @param[in,out] obs Instance of Observation class in which the observation
    * will be stored
    */
-  virtual void readObservation(Observation& obs);
+  virtual void readObservation(Observation& obs) {
+    readObservation(obs, renderTarget());
+  }
+
+  /**
+   * @brief Read the attachment of this sensor's type from a frame rendered
+   * into @p target
+   */
+  void readObservation(Observation& obs, gfx::RenderTarget& target);
+
+  /**
+   * @brief Start reading the observation that was rendered by the simulator
+   * asynchronously. Rotates through as many memory buffers as the render
+   * target has pixel buffers, so an observation stays valid until that many
+   * more were read
+   * @param[in,out] obs Instance of Observation class in which the observation
+   * will be stored
+   */
+  virtual void readObservationAsync(Observation& obs) {
+    readObservationAsync(obs, renderTarget());
+  }
+
+  /**
+   * @brief Start reading the attachment of this sensor's type from a frame
+   * rendered into @p target asynchronously
+   */
+  void readObservationAsync(Observation& obs, gfx::RenderTarget& target);
+
+  /**
+   * @brief Memory buffers of the asynchronous reads
+   */
+  std::vector<core::Buffer::ptr> asyncBuffers_;
+  size_t nextAsyncBuffer_ = 0;
 
   /**
    * @brief This camera's projection matrix. Should be recomputeulated every
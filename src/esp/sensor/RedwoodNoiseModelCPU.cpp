@@ -0,0 +1,283 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include "RedwoodNoiseModelCPU.h"
+
+#include <Corrade/Corrade.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace esp {
+namespace sensor {
+
+namespace {
+const int MODEL_N_ROWS = 80;
+const int MODEL_N_DIMS = 4;
+const int MODEL_N_COLS = 100;
+
+// splitmix64 finalizer, derives the keys of a simulation from the seed
+uint64_t mix64(uint64_t x) {
+  x += 0x9e3779b97f4a7c15ull;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+// 32-bit integer hash with low bias (lowbias32), the counter-based generator
+// of the random numbers
+inline uint32_t hash32(uint32_t x) {
+  x ^= x >> 16;
+  x *= 0x7feb352du;
+  x ^= x >> 15;
+  x *= 0x846ca68bu;
+  x ^= x >> 16;
+  return x;
+}
+
+inline uint32_t randomBits(const uint32_t counter,
+                           const uint32_t key0,
+                           const uint32_t key1) {
+  return hash32(hash32(counter ^ key0) + key1);
+}
+
+// uniform in (0, 1]
+inline float uniformOpen(const uint32_t bits) {
+  return static_cast<float>((bits >> 8) + 1) * (1.0f / 16777216.0f);
+}
+
+// uniform in [0, 1)
+inline float uniform(const uint32_t bits) {
+  return static_cast<float>(bits >> 8) * (1.0f / 16777216.0f);
+}
+
+// The following approximations are made of operations that vectorize, unlike
+// calls to std::log(), std::sin() and std::cos(), and give the same results
+// with and without AVX2
+
+// natural logarithm of x in (0, 1]
+inline float logApprox(const float x) {
+  uint32_t bits;
+  std::memcpy(&bits, &x, sizeof(float));
+  const float exponent = static_cast<float>(int((bits >> 23) & 0xff) - 127);
+  bits = (bits & 0x007fffffu) | 0x3f800000u;
+  float mantissa;
+  std::memcpy(&mantissa, &bits, sizeof(float));
+  // ln(m) = 2 atanh(t) with t = (m - 1)/(m + 1) in [0, 1/3) for m in [1, 2)
+  const float t = (mantissa - 1.0f) / (mantissa + 1.0f);
+  const float t2 = t * t;
+  const float atanh =
+      t * (1.0f +
+           t2 * (1.0f / 3.0f +
+                 t2 * (1.0f / 5.0f + t2 * (1.0f / 7.0f + t2 * (1.0f / 9.0f)))));
+  return exponent * 0.69314718f + 2.0f * atanh;
+}
+
+// Taylor series of sin(a) and cos(a) for a in [-pi, pi)
+inline float sinApprox(const float a) {
+  const float a2 = a * a;
+  float s = 1.0f - a2 / 272.0f;
+  s = 1.0f - a2 / 210.0f * s;
+  s = 1.0f - a2 / 156.0f * s;
+  s = 1.0f - a2 / 110.0f * s;
+  s = 1.0f - a2 / 72.0f * s;
+  s = 1.0f - a2 / 42.0f * s;
+  s = 1.0f - a2 / 20.0f * s;
+  s = 1.0f - a2 / 6.0f * s;
+  return a * s;
+}
+
+inline float cosApprox(const float a) {
+  const float a2 = a * a;
+  float c = 1.0f - a2 / 306.0f;
+  c = 1.0f - a2 / 240.0f * c;
+  c = 1.0f - a2 / 182.0f * c;
+  c = 1.0f - a2 / 132.0f * c;
+  c = 1.0f - a2 / 90.0f * c;
+  c = 1.0f - a2 / 56.0f * c;
+  c = 1.0f - a2 / 30.0f * c;
+  c = 1.0f - a2 / 12.0f * c;
+  return 1.0f - a2 / 2.0f * c;
+}
+
+// Read about the noise model here: http://www.alexteichman.com/octo/clams/
+// Original source code: http://redwood-data.org/indoor/data/simdepth.py
+inline float undistort(const int _x,
+                       const int _y,
+                       const float z,
+                       const float* __restrict__ model) {
+  const int i2 = (z + 1) / 2;
+  const int i1 = i2 - 1;
+  const float a = (z - (i1 * 2.0f + 1.0f)) / 2.0f;
+  const int x = _x / 8;
+  const int y = _y / 6;
+
+  const float f =
+      (1.0f - a) * model[(y * MODEL_N_COLS + x) * MODEL_N_DIMS +
+                         std::min(std::max(i1, 0), 4)] +
+      a * model[(y * MODEL_N_COLS + x) * MODEL_N_DIMS + std::min(i2, 4)];
+
+  if (f < 1e-5f)
+    return 0.0f;
+  else
+    return z / f;
+}
+
+// samples the three standard normal random variables of the pixels
+// [firstPixel, firstPixel + n) with Box-Muller transforms of two pairs of
+// uniform ones
+/* Clang doesn't have target_clones yet: https://reviews.llvm.org/D51650 */
+#if defined(CORRADE_TARGET_X86) && defined(__GNUC__) && __GNUC__ >= 6
+__attribute__((target_clones("default", "avx2")))
+#endif
+void sampleNormals(const uint32_t key0,
+                   const uint32_t key1,
+                   const uint32_t firstPixel,
+                   const int n,
+                   float* __restrict__ shuffleY,
+                   float* __restrict__ shuffleX,
+                   float* __restrict__ quantization) {
+  const float pi = 3.14159265f;
+  for (int i = 0; i < n; ++i) {
+    const uint32_t counter = (firstPixel + uint32_t(i)) * 4u;
+    const float u0 = uniformOpen(randomBits(counter, key0, key1));
+    const float u1 = uniform(randomBits(counter + 1u, key0, key1));
+    const float u2 = uniformOpen(randomBits(counter + 2u, key0, key1));
+    const float u3 = uniform(randomBits(counter + 3u, key0, key1));
+
+    // sin(2 pi u) = -sin(2 pi (u - 1/2)), same for the cosine
+    const float r0 = std::sqrt(-2.0f * logApprox(u0));
+    const float a0 = 2.0f * pi * (u1 - 0.5f);
+    shuffleY[i] = -r0 * cosApprox(a0);
+    shuffleX[i] = -r0 * sinApprox(a0);
+
+    const float r1 = std::sqrt(-2.0f * logApprox(u2));
+    quantization[i] = -r1 * cosApprox(2.0f * pi * (u3 - 0.5f));
+  }
+}
+
+#if defined(CORRADE_TARGET_X86) && defined(__GNUC__) && __GNUC__ >= 6
+__attribute__((target_clones("default", "avx2")))
+#endif
+void simulateRow(const float* __restrict__ depth,
+                 const int depthStride,
+                 const int H,
+                 const int W,
+                 const int j,
+                 const float* __restrict__ model,
+                 const float noiseMultiplier,
+                 const float* __restrict__ shuffleY,
+                 const float* __restrict__ shuffleX,
+                 const float* __restrict__ quantization,
+                 float* __restrict__ noisyDepth) {
+  const float ymax = H - 1;
+  const float xmax = W - 1;
+  // the noise model was made for a 640x480 sensor, single-pixel images map
+  // to its first pixel
+  const float xScale = W > 1 ? 639.0f / xmax : 0.0f;
+  const float yScale = H > 1 ? 479.0f / ymax : 0.0f;
+
+  for (int i = 0; i < W; ++i) {
+    // Shuffle pixels
+    const int y =
+        std::min(std::max(j + shuffleY[i] * 0.25f * noiseMultiplier, 0.0f),
+                 ymax) +
+        0.5f;
+    const int x =
+        std::min(std::max(i + shuffleX[i] * 0.25f * noiseMultiplier, 0.0f),
+                 xmax) +
+        0.5f;
+
+    // downsample
+    const float d = depth[(y - y % 2) * depthStride + x - x % 2];
+    float noisy = 0.0f;
+    // If depth is greater than 10m, the sensor will just return a zero
+    if (d < 10.0f) {
+      // Distortion
+      const float undistortedD = undistort(int(x * xScale + 0.5f),
+                                           int(y * yScale + 0.5f), d, model);
+
+      // quantization and high freq noise
+      if (undistortedD != 0.0f) {
+        const float denom = std::round(
+            (35.130f / undistortedD +
+             quantization[i] * 0.027778f * noiseMultiplier) *
+            8.0f);
+        noisy = denom > 1e-5f ? (35.130f * 8.0f / denom) : 0.0f;
+      }
+    }
+    noisyDepth[i] = noisy;
+  }
+}
+
+void simulateImpl(const float* depth,
+                  const int depthStride,
+                  const int rows,
+                  const int cols,
+                  const float* model,
+                  const float noiseMultiplier,
+                  const uint64_t key,
+                  float* noisyDepth) {
+  const uint32_t key0 = key;
+  const uint32_t key1 = key >> 32;
+
+  // the random numbers are a function of the pixel, so it does not matter
+  // which thread processes which row
+#pragma omp parallel
+  {
+    std::vector<float> normals(3 * cols);
+    float* shuffleY = normals.data();
+    float* shuffleX = shuffleY + cols;
+    float* quantization = shuffleX + cols;
+
+#pragma omp for schedule(static)
+    for (int j = 0; j < rows; ++j) {
+      sampleNormals(key0, key1, uint32_t(j) * uint32_t(cols), cols, shuffleY,
+                    shuffleX, quantization);
+      simulateRow(depth, depthStride, rows, cols, j, model, noiseMultiplier,
+                  shuffleY, shuffleX, quantization, noisyDepth + j * cols);
+    }
+  }
+}
+
+}  // namespace
+
+RedwoodNoiseModelCPUImpl::RedwoodNoiseModelCPUImpl(
+    const Eigen::Ref<const Eigen::RowMatrixXf> model,
+    const float noiseMultiplier,
+    const uint64_t seed)
+    : noiseMultiplier_{noiseMultiplier}, seed_{seed} {
+  CHECK_EQ(model.rows() * model.cols(),
+           MODEL_N_ROWS * MODEL_N_COLS * MODEL_N_DIMS)
+      << "RedwoodNoiseModelCPUImpl: the distortion model must have "
+      << MODEL_N_ROWS << "x" << MODEL_N_COLS * MODEL_N_DIMS << " entries";
+  model_.resize(model.rows() * model.cols());
+  Eigen::Map<Eigen::RowMatrixXf>(model_.data(), model.rows(), model.cols()) =
+      model;
+}
+
+void RedwoodNoiseModelCPUImpl::setSeed(const uint64_t seed) {
+  seed_ = seed;
+  simulationIndex_ = 0;
+}
+
+Eigen::RowMatrixXf RedwoodNoiseModelCPUImpl::simulate(
+    const Eigen::Ref<const Eigen::RowMatrixXf> depth) {
+  Eigen::RowMatrixXf noisyDepth(depth.rows(), depth.cols());
+  simulateImpl(depth.data(), depth.outerStride(), depth.rows(), depth.cols(),
+               model_.data(), noiseMultiplier_,
+               mix64(seed_ ^ mix64(simulationIndex_++)), noisyDepth.data());
+  return noisyDepth;
+}
+
+void RedwoodNoiseModelCPUImpl::simulate(const float* depth,
+                                        const int rows,
+                                        const int cols,
+                                        float* noisyDepth) {
+  simulateImpl(depth, cols, rows, cols, model_.data(), noiseMultiplier_,
+               mix64(seed_ ^ mix64(simulationIndex_++)), noisyDepth);
+}
+
+}  // namespace sensor
+}  // namespace esp
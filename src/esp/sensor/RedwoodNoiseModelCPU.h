@@ -0,0 +1,85 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#ifndef ESP_SENSOR_REDWOODNOISEMODELCPU_H_
+#define ESP_SENSOR_REDWOODNOISEMODELCPU_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "esp/core/esp.h"
+
+namespace esp {
+namespace sensor {
+
+/**
+ * Provides a CPU implementation of the Redwood Noise Model for PrimSense
+ * Depth sensors, sampling the same noise as @ref RedwoodNoiseModelGPUImpl
+ * for machines without a CUDA device. See @ref RedwoodNoiseModelGPUImpl for
+ * the reference to cite.
+ *
+ * Rows are processed in parallel, with the random numbers of each row
+ * generated in a vectorized pass (AVX2 where the CPU supports it, scalar
+ * otherwise). The random numbers are a hash of the seed, the index of the
+ * simulation and the pixel, so the noise depends on neither the number of
+ * threads nor the instruction set.
+ */
+struct RedwoodNoiseModelCPUImpl {
+  /**
+   * @brief Constructor
+   * @param model             The distortion model from
+   *                          http://redwood-data.org/indoor/data/dist-model.txt
+   *                          The 3rd dimension is assumed to have been
+   *                          flattened into the second
+   * @param noiseMultiplier   Multiplier for the Gaussian random-variables. This
+   *                          can be used to increase or decrease the noise
+   *                          level
+   * @param seed              Seed of the random numbers
+   */
+  RedwoodNoiseModelCPUImpl(const Eigen::Ref<const Eigen::RowMatrixXf> model,
+                           const float noiseMultiplier,
+                           const uint64_t seed = 0);
+
+  /**
+   * @brief Simulates noisy depth from clean depth. Every call draws new
+   * noise, the sequence of calls is reproducible for a given seed.
+   *
+   * @param[in] depth  Clean depth, i.e. depth from habitat's depth shader
+   * @return Simulated noisy depth
+   */
+  Eigen::RowMatrixXf simulate(const Eigen::Ref<const Eigen::RowMatrixXf> depth);
+
+  /**
+   * @brief Similar to @ref simulate() but writes into preallocated memory
+   *
+   * @param[in] depth        Clean depth, a contiguous array in row-major order
+   * @param[in] rows         The number of rows in the depth image
+   * @param[in] cols         The number of columns
+   * @param[out] noisyDepth  The memory to write the noisy depth to, must not
+   *                         alias @p depth
+   */
+  void simulate(const float* depth,
+                const int rows,
+                const int cols,
+                float* noisyDepth);
+
+  /**
+   * @brief Restart the sequence of simulations from a seed
+   */
+  void setSeed(const uint64_t seed);
+
+ private:
+  std::vector<float> model_;
+  const float noiseMultiplier_;
+  uint64_t seed_;
+  // number of simulations drawn since the seed was set
+  uint64_t simulationIndex_ = 0;
+
+  ESP_SMART_POINTERS(RedwoodNoiseModelCPUImpl)
+};
+
+}  // namespace sensor
+}  // namespace esp
+
+#endif  // ESP_SENSOR_REDWOODNOISEMODELCPU_H_
@@ -11,6 +11,9 @@
 #include "esp/scene/SceneNode.h"
 
 namespace esp {
+namespace gfx {
+class PendingReadback;
+}
 namespace sim {
 class Simulator;
 }
@@ -71,6 +74,11 @@ using SensorSetup = std::vector<sensor::SensorSpec::ptr>;
 struct Observation {
   // TODO: populate this struct with raw data
   core::Buffer::ptr buffer{nullptr};
+  /**
+   * @brief Set if the observation is still being read into @ref buffer
+   * asynchronously, which it is in only once the read has been waited on
+   */
+  std::shared_ptr<gfx::PendingReadback> pending{nullptr};
   ESP_SMART_POINTERS(Observation)
 };
 
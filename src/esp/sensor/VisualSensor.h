@@ -81,6 +81,21 @@ class VisualSensor : public Sensor {
     return false;
   }
 
+  /**
+   * @brief Same as @ref getObservation, but does not wait for the observation
+   * to be read into @p obs, which carries the pending read instead
+   *
+   * Sensors that cannot read asynchronously read synchronously and leave
+   * the pending read of @p obs unset.
+   * @return true if success, otherwise false
+   * @param[in] sim Instance of Simulator class for which the observation needs
+   *                to be drawn, obs Instance of Observation class in which the
+   * observation will be stored
+   */
+  virtual bool getObservationAsync(sim::Simulator& sim, Observation& obs) {
+    return getObservation(sim, obs);
+  }
+
   /**
    * @brief Display next observation from Simulator on default frame buffer
    * @param[in] sim Instance of Simulator class for which the observation needs
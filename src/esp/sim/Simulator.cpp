@@ -55,6 +55,7 @@ Simulator::~Simulator() {
 
 void Simulator::close() {
   pathfinder_ = nullptr;
+  navMeshStaticObjects_.clear();
   navMeshVisPrimID_ = esp::ID_UNDEFINED;
   navMeshVisNode_ = nullptr;
   agents_.clear();
@@ -124,6 +125,8 @@ void Simulator::reconfigure(const SimulatorConfiguration& cfg) {
     LOG(WARNING) << "Not changing requiresTextures as the simulator was "
                     "initialized with True.  Call close() to change this.";
   }
+  // applies to the meshes loaded from now on, cached ones are kept as they are
+  resourceManager_->setGenerateMeshLODs(config_.generateMeshLODs);
 
   bool success = false;
   // (re) create scene instance based on whether or not a renderer is requested.
@@ -182,6 +185,7 @@ Simulator::setSceneInstanceAttributes(const std::string& activeSceneName) {
       << navmeshFileLoc;
   // Get name of navmesh and use to create pathfinder and load navmesh
   // create pathfinder and load navmesh if available
+  navMeshStaticObjects_.erase(pathfinder_.get());
   pathfinder_ = nav::PathFinder::create();
   if (FileUtil::exists(navmeshFileLoc)) {
     LOG(INFO) << "Simulator::setSceneInstanceAttributes : Loading navmesh from "
@@ -797,6 +801,22 @@ bool Simulator::contactTest(const int objectID, const int sceneID) {
   return false;
 }
 
+std::vector<bool> Simulator::contactTestBatch(const std::vector<int>& objectIDs,
+                                              const int sceneID) {
+  if (sceneHasPhysics(sceneID)) {
+    return physicsManager_->contactTestBatch(objectIDs);
+  }
+  return std::vector<bool>(objectIDs.size(), false);
+}
+
+std::vector<esp::physics::ContactPairInfo> Simulator::getContactPairs(
+    const int sceneID) {
+  if (sceneHasPhysics(sceneID)) {
+    return physicsManager_->getContactPairs();
+  }
+  return {};
+}
+
 esp::physics::RaycastResults Simulator::castRay(const esp::geo::Ray& ray,
                                                 float maxDistance,
                                                 const int sceneID) {
@@ -806,6 +826,20 @@ esp::physics::RaycastResults Simulator::castRay(const esp::geo::Ray& ray,
   return esp::physics::RaycastResults();
 }
 
+esp::physics::RaycastBatchResults Simulator::castRays(
+    const std::vector<esp::geo::Ray>& rays,
+    float maxDistance,
+    bool closestHitOnly,
+    const int sceneID) {
+  if (sceneHasPhysics(sceneID)) {
+    return physicsManager_->castRays(rays, maxDistance, closestHitOnly);
+  }
+  // no collision world, so no hits
+  esp::physics::RaycastBatchResults results;
+  results.rayHitOffsets.assign(rays.size() + 1, 0);
+  return results;
+}
+
 void Simulator::setObjectBBDraw(bool drawBB,
                                 const int objectID,
                                 const int sceneID) {
@@ -863,6 +897,94 @@ bool Simulator::recomputeNavMesh(nav::PathFinder& pathfinder,
                  "loaded without renderer initialization.",
                  false);
 
+  std::map<int, std::pair<vec3f, vec3f>> staticObjectBounds;
+  assets::MeshData::uptr joinedMesh =
+      joinNavMeshGeometry(includeStaticObjects, staticObjectBounds);
+
+  if (!pathfinder.build(navMeshSettings, *joinedMesh)) {
+    LOG(ERROR) << "Failed to build navmesh";
+    return false;
+  }
+  NavMeshStaticObjects& staticObjects = navMeshStaticObjects_[&pathfinder];
+  staticObjects.includeStaticObjects = includeStaticObjects;
+  staticObjects.bounds = std::move(staticObjectBounds);
+
+  if (&pathfinder == pathfinder_.get()) {
+    if (isNavMeshVisualizationActive()) {
+      // if updating pathfinder_ instance, refresh the visualization.
+      setNavMeshVisualization(false);  // first clear the old instance
+      setNavMeshVisualization(true);
+    }
+  }
+
+  LOG(INFO) << "reconstruct navmesh successful";
+  return true;
+}
+
+bool Simulator::updateNavMeshTiles(nav::PathFinder& pathfinder) {
+  CORRADE_ASSERT(config_.createRenderer,
+                 "Simulator::updateNavMeshTiles: "
+                 "SimulatorConfiguration::createRenderer is "
+                 "false. Scene geometry is required to update navmesh. No "
+                 "geometry is "
+                 "loaded without renderer initialization.",
+                 false);
+
+  auto found = navMeshStaticObjects_.find(&pathfinder);
+  if (found == navMeshStaticObjects_.end()) {
+    LOG(ERROR) << "Simulator::updateNavMeshTiles: the navmesh was not "
+                  "computed with recomputeNavMesh";
+    return false;
+  }
+  NavMeshStaticObjects& staticObjects = found->second;
+  // static objects don't affect a navmesh computed without them
+  if (!staticObjects.includeStaticObjects) {
+    return true;
+  }
+
+  std::map<int, std::pair<vec3f, vec3f>> staticObjectBounds;
+  assets::MeshData::uptr joinedMesh =
+      joinNavMeshGeometry(true, staticObjectBounds);
+
+  // Both where a changed object was and where it is now need to be rebuilt
+  std::vector<std::pair<vec3f, vec3f>> changedBounds;
+  for (const auto& prevObject : staticObjects.bounds) {
+    auto it = staticObjectBounds.find(prevObject.first);
+    if (it == staticObjectBounds.end() || it->second != prevObject.second) {
+      changedBounds.push_back(prevObject.second);
+    }
+  }
+  for (const auto& object : staticObjectBounds) {
+    auto it = staticObjects.bounds.find(object.first);
+    if (it == staticObjects.bounds.end() || it->second != object.second) {
+      changedBounds.push_back(object.second);
+    }
+  }
+
+  if (changedBounds.empty()) {
+    return true;
+  }
+
+  if (!pathfinder.rebuildTiles(*joinedMesh, changedBounds)) {
+    LOG(ERROR) << "Failed to update navmesh tiles";
+    return false;
+  }
+  staticObjects.bounds = std::move(staticObjectBounds);
+
+  if (&pathfinder == pathfinder_.get()) {
+    if (isNavMeshVisualizationActive()) {
+      // if updating pathfinder_ instance, refresh the visualization.
+      setNavMeshVisualization(false);  // first clear the old instance
+      setNavMeshVisualization(true);
+    }
+  }
+
+  return true;
+}
+
+assets::MeshData::uptr Simulator::joinNavMeshGeometry(
+    bool includeStaticObjects,
+    std::map<int, std::pair<vec3f, vec3f>>& staticObjectBounds) {
   assets::MeshData::uptr joinedMesh = assets::MeshData::create_unique();
   auto stageInitAttrs = physicsManager_->getStageInitAttributes();
   if (stageInitAttrs != nullptr) {
@@ -899,28 +1021,19 @@ bool Simulator::recomputeNavMesh(nav::PathFinder& pathfinder,
               joinedObjectMesh->ibo[ix] + prevNumVerts;
         }
         joinedMesh->vbo.reserve(joinedObjectMesh->vbo.size() + prevNumVerts);
+        vec3f boundsMin = vec3f::Constant(std::numeric_limits<float>::max());
+        vec3f boundsMax = -boundsMin;
         for (auto& vert : joinedObjectMesh->vbo) {
           joinedMesh->vbo.push_back(objectTransform * vert);
+          boundsMin = boundsMin.cwiseMin(joinedMesh->vbo.back());
+          boundsMax = boundsMax.cwiseMax(joinedMesh->vbo.back());
         }
+        staticObjectBounds[objectID] = std::make_pair(boundsMin, boundsMax);
       }
     }
   }
 
-  if (!pathfinder.build(navMeshSettings, *joinedMesh)) {
-    LOG(ERROR) << "Failed to build navmesh";
-    return false;
-  }
-
-  if (&pathfinder == pathfinder_.get()) {
-    if (isNavMeshVisualizationActive()) {
-      // if updating pathfinder_ instance, refresh the visualization.
-      setNavMeshVisualization(false);  // first clear the old instance
-      setNavMeshVisualization(true);
-    }
-  }
-
-  LOG(INFO) << "reconstruct navmesh successful";
-  return true;
+  return joinedMesh;
 }
 
 bool Simulator::setNavMeshVisualization(bool visualize) {
@@ -1092,6 +1205,7 @@ nav::PathFinder::ptr Simulator::getPathFinder() {
 }
 
 void Simulator::setPathFinder(nav::PathFinder::ptr pathfinder) {
+  navMeshStaticObjects_.erase(pathfinder_.get());
   pathfinder_ = std::move(pathfinder);
 }
 gfx::RenderTarget* Simulator::getRenderTarget(int agentId,
@@ -1151,14 +1265,58 @@ bool Simulator::getAgentObservation(const int agentId,
 int Simulator::getAgentObservations(
     const int agentId,
     std::map<std::string, sensor::Observation>& observations) {
+  return readAgentObservations(agentId, observations, false);
+}
+
+int Simulator::getAgentObservationsAsync(
+    const int agentId,
+    std::map<std::string, sensor::Observation>& observations) {
+  return readAgentObservations(agentId, observations, true);
+}
+
+int Simulator::readAgentObservations(
+    const int agentId,
+    std::map<std::string, sensor::Observation>& observations,
+    bool async) {
   observations.clear();
   agent::Agent::ptr ag = getAgent(agentId);
   if (ag != nullptr) {
     const std::map<std::string, sensor::Sensor::ptr>& sensors =
         ag->getSensorSuite().getSensors();
+    // camera sensors drawn so far, the ones seeing the same read from their
+    // frames
+    std::vector<sensor::CameraSensor*> drawn;
     for (const std::pair<const std::string, sensor::Sensor::ptr>& s : sensors) {
+      sensor::CameraSensor* camera =
+          fusedSensorRendering_
+              ? dynamic_cast<sensor::CameraSensor*>(s.second.get())
+              : nullptr;
+      sensor::CameraSensor* shared = nullptr;
+      if (camera != nullptr) {
+        for (sensor::CameraSensor* other : drawn) {
+          if (camera->canShareObservationDraw(*this, *other)) {
+            shared = other;
+            break;
+          }
+        }
+      }
+
       sensor::Observation obs;
-      if (s.second->getObservation(*this, obs)) {
+      bool success = false;
+      if (shared != nullptr) {
+        success = async ? camera->getObservationFromAsync(*shared, obs)
+                        : camera->getObservationFrom(*shared, obs);
+      } else {
+        success = async && s.second->isVisualSensor()
+                      ? std::static_pointer_cast<sensor::VisualSensor>(
+                            s.second)
+                            ->getObservationAsync(*this, obs)
+                      : s.second->getObservation(*this, obs);
+        if (success && camera != nullptr) {
+          drawn.push_back(camera);
+        }
+      }
+      if (success) {
         observations[s.first] = obs;
       }
     }
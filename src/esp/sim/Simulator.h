@@ -523,6 +523,27 @@ class Simulator {
    */
   bool contactTest(int objectID, int sceneID = 0);
 
+  /**
+   * @brief Discrete collision check for contact between each of several
+   * objects and the collision world, running collision detection once for all
+   * of them.
+   * @param objectIDs The IDs of the objects to check.
+   * @param sceneID !! Not used currently !! Specifies which physical scene of
+   * the objects.
+   * @return Whether or not each object is in contact with any other collision
+   * enabled objects, in the order of @p objectIDs.
+   */
+  std::vector<bool> contactTestBatch(const std::vector<int>& objectIDs,
+                                     int sceneID = 0);
+
+  /**
+   * @brief Run collision detection and get all the pairs of objects in
+   * contact.
+   * @param sceneID !! Not used currently !! Specifies which physical scene.
+   * @return The pairs in contact. Stage contacts have the object ID -1.
+   */
+  std::vector<esp::physics::ContactPairInfo> getContactPairs(int sceneID = 0);
+
   /**
    * @brief Set an object to collidable or not.
    */
@@ -581,6 +602,29 @@ class Simulator {
                                        float maxDistance = 100.0,
                                        int sceneID = 0);
 
+  /**
+   * @brief Cast a batch of rays into the collision world, in parallel, and
+   * return the hits of all of them.
+   *
+   * Note: A default @ref physics::PhysicsManager has no collision world, so
+   * physics must be enabled for this feature.
+   *
+   * @param rays The rays to cast. Need not be unit length, but returned hit
+   * distances will be in units of ray length.
+   * @param maxDistance The maximum distance along the ray directions to
+   * search. In units of ray length.
+   * @param closestHitOnly Whether to only return the closest hit of each ray.
+   * @param sceneID !! Not used currently !! Specifies which physical scene of
+   * the object.
+   * @return The hits of the rays in flat arrays, sorted by distance for each
+   * ray.
+   */
+  esp::physics::RaycastBatchResults castRays(
+      const std::vector<esp::geo::Ray>& rays,
+      float maxDistance = 100.0,
+      bool closestHitOnly = false,
+      int sceneID = 0);
+
   /**
    * @brief the physical world has a notion of time which passes during
    * animation/simulation/action/etc... Step the physical world forward in time
@@ -626,6 +670,21 @@ class Simulator {
                         const nav::NavMeshSettings& navMeshSettings,
                         bool includeStaticObjects = false);
 
+  /**
+   * @brief Incrementally update a tiled navmesh after MotionType::STATIC
+   * objects were added, removed or moved.
+   *
+   * Only the navmesh tiles overlapped by the old or new bounds of the changed
+   * objects are rebuilt. Changes are detected relative to the objects used by
+   * the last @ref recomputeNavMesh or @ref updateNavMeshTiles call for the
+   * same @p pathfinder. If that navmesh was computed without static objects,
+   * there is nothing to update.
+   * @param pathfinder The pathfinder object holding a navmesh computed by @ref
+   * recomputeNavMesh with a positive @ref nav::NavMeshSettings::tileSize.
+   * @return Whether or not the navmesh update succeeded.
+   */
+  bool updateNavMeshTiles(nav::PathFinder& pathfinder);
+
   /**
    * @brief Set visualization of the current NavMesh @ref pathfinder_ on or off.
    *
@@ -767,10 +826,32 @@ class Simulator {
   bool getAgentObservation(int agentId,
                            const std::string& sensorId,
                            sensor::Observation& observation);
+  /**
+   * @brief Get the observations of all sensors of an agent
+   *
+   * With @ref isFusedSensorRenderingEnabled(), camera sensors at the same
+   * pose and with the same intrinsics as a sensor drawn before them read
+   * their color, depth or object id from its frame instead of drawing the
+   * scene again, see @ref sensor::CameraSensor::canShareObservationDraw().
+   * @return The number of observations
+   */
   int getAgentObservations(
       int agentId,
       std::map<std::string, sensor::Observation>& observations);
 
+  /**
+   * @brief Same as @ref getAgentObservations, but only starts reading the
+   * observations of the visual sensors, without waiting for the GPU
+   *
+   * The simulation can be stepped while the reads are in flight, the
+   * observations are in their buffers once the pending reads of the
+   * observations have been waited on.
+   * @return The number of observations
+   */
+  int getAgentObservationsAsync(
+      int agentId,
+      std::map<std::string, sensor::Observation>& observations);
+
   bool getAgentObservationSpace(int agentId,
                                 const std::string& sensorId,
                                 sensor::ObservationSpace& space);
@@ -793,6 +874,21 @@ class Simulator {
    */
   bool isFrustumCullingEnabled() { return frustumCulling_; }
 
+  /**
+   * @brief Enable or disable drawing co-located camera sensors of an agent
+   * once and reading all their observations from that single frame (enabled
+   * by default). See @ref getAgentObservations()
+   * @param val true = enable, false = disable
+   */
+  void setFusedSensorRenderingEnabled(bool val) { fusedSensorRendering_ = val; }
+
+  /**
+   * @brief Get status, whether fused rendering of co-located sensors is
+   * enabled or not
+   * @return true if enabled, otherwise false
+   */
+  bool isFusedSensorRenderingEnabled() { return fusedSensorRendering_; }
+
   /**
    * @brief Get a copy of an existing @ref gfx::LightSetup by its key.
    *
@@ -864,6 +960,15 @@ class Simulator {
 
  protected:
   Simulator(){};
+
+  /**
+   * @brief Implementation of @ref getAgentObservations() and
+   * @ref getAgentObservationsAsync()
+   */
+  int readAgentObservations(
+      int agentId,
+      std::map<std::string, sensor::Observation>& observations,
+      bool async);
   /**
    * @brief Builds a scene instance and populates it with initial object layout,
    * if appropriate, based on @ref esp::metadata::attributes::SceneAttributes
@@ -911,6 +1016,17 @@ class Simulator {
 
   void reconfigureReplayManager();
 
+  /**
+   * @brief Join the stage collision mesh and, optionally, the collision meshes
+   * of all MotionType::STATIC objects into the navmesh source geometry.
+   * @param includeStaticObjects Whether or not to include the static objects.
+   * @param staticObjectBounds [out] World space bounds of each included
+   * object, keyed by object ID.
+   */
+  assets::MeshData::uptr joinNavMeshGeometry(
+      bool includeStaticObjects,
+      std::map<int, std::pair<vec3f, vec3f>>& staticObjectBounds);
+
   gfx::WindowlessContext::uptr context_ = nullptr;
   std::shared_ptr<gfx::Renderer> renderer_ = nullptr;
   // CANNOT make the specification of resourceManager_ above the context_!
@@ -954,10 +1070,25 @@ class Simulator {
   // rquires it when drawing the observation
   bool frustumCulling_ = true;
 
+  // whether co-located camera sensors share a single draw
+  bool fusedSensorRendering_ = true;
+
   //! NavMesh visualization variables
   int navMeshVisPrimID_ = esp::ID_UNDEFINED;
   esp::scene::SceneNode* navMeshVisNode_ = nullptr;
 
+  //! Static objects the navmesh of a pathfinder was last computed with
+  struct NavMeshStaticObjects {
+    //! Whether the navmesh includes static objects at all
+    bool includeStaticObjects = false;
+    //! World space bounds of the included static objects, used to find what
+    //! @ref updateNavMeshTiles has to rebuild
+    std::map<int, std::pair<vec3f, vec3f>> bounds;
+  };
+
+  //! Indexed by the pathfinders passed to @ref recomputeNavMesh
+  std::map<const nav::PathFinder*, NavMeshStaticObjects> navMeshStaticObjects_;
+
   //! Maps holding IDs and Names of trajectory visualizations
   std::map<std::string, int> trajVisIDByName;
   std::map<int, std::string> trajVisNameByID;
@@ -22,6 +22,7 @@ bool operator==(const SimulatorConfiguration& a,
          a.forceSeparateSemanticSceneGraph ==
              b.forceSeparateSemanticSceneGraph &&
          a.requiresTextures == b.requiresTextures &&
+         a.generateMeshLODs == b.generateMeshLODs &&
          a.sceneDatasetConfigFile.compare(b.sceneDatasetConfigFile) == 0 &&
          a.physicsConfigFile.compare(b.physicsConfigFile) == 0 &&
          a.overrideSceneLightDefaults == b.overrideSceneLightDefaults &&
@@ -53,6 +53,12 @@ struct SimulatorConfiguration {
    * for RGB rendering
    */
   bool requiresTextures = true;
+  /**
+   * @brief Whether or not to simplify loaded meshes into coarser levels of
+   * detail, which camera sensors draw when the simplification is not visible
+   * at their resolution
+   */
+  bool generateMeshLODs = false;
   std::string physicsConfigFile = ESP_DEFAULT_PHYSICS_CONFIG_REL_PATH;
 
   /**
@@ -29,6 +29,15 @@ layout(location = OUTPUT_ATTRIBUTE_LOCATION_OBJECT_ID) out highp uint
 #if (LIGHT_COUNT > 0)
 // -------------- lights -------------------
 // NOTE: In this shader, the light intensity is considered in the lightColor!!
+#if defined(LIGHT_BUFFER)
+// shared by all drawables lit by the same light setup, see LightBuffer
+layout(std140) uniform LightBuffer {
+  // same as LightDirections below
+  vec4 LightDirections[LIGHT_COUNT];
+  // .rgb is the light color, .w the light range
+  vec4 LightColorsRanges[LIGHT_COUNT];
+};
+#else
 uniform vec3 LightColors[LIGHT_COUNT];
 uniform float LightRanges[LIGHT_COUNT];
 
@@ -38,6 +47,7 @@ uniform float LightRanges[LIGHT_COUNT];
 // so it is computed in the vertex shader.
 uniform vec4 LightDirections[LIGHT_COUNT];
 #endif
+#endif
 
 // -------------- material, textures ------------------
 struct MaterialData {
@@ -257,6 +267,13 @@ void main() {
   // the following part of the code is inspired by the Phong.frag in Magnum
   // library (https://magnum.graphics/)
   for (int iLight = 0; iLight < LIGHT_COUNT; ++iLight) {
+#if defined(LIGHT_BUFFER)
+    vec3 lightColor = LightColorsRanges[iLight].rgb;
+    float lightRange = LightColorsRanges[iLight].w;
+#else
+    vec3 lightColor = LightColors[iLight];
+    float lightRange = LightRanges[iLight];
+#endif
     // Attenuation. Directional lights have the .w component set to 0, use
     // that to make the distance zero -- which will then ensure the
     // attenuation is always 1.0
@@ -266,12 +283,12 @@ void main() {
     // avoid a NaN when dist is 0 as well (which is the case for
     // directional lights).
     highp float attenuation =
-        clamp(1.0 - pow(dist / max(LightRanges[iLight], 0.0001), 4.0), 0.0,
+        clamp(1.0 - pow(dist / max(lightRange, 0.0001), 4.0), 0.0,
               1.0);
     attenuation = attenuation * attenuation / (1.0 + dist * dist);
 
     // radiance
-    vec3 lightRadiance = LightColors[iLight] * attenuation;
+    vec3 lightRadiance = lightColor * attenuation;
 
     // light source direction: a vector from current position to the light
     vec3 light = normalize(LightDirections[iLight].xyz -
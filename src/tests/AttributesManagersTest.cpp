@@ -426,7 +426,10 @@ TEST_F(AttributesManagersTest, AttributesManagers_PhysicsJSONLoadTest) {
       "timestep": 1.0,
       "gravity": [1,2,3],
       "friction_coefficient": 1.4,
-      "restitution_coefficient": 1.1
+      "restitution_coefficient": 1.1,
+      "stage_bvh_cache_directory": "bvh_cache",
+      "multithreaded": true,
+      "num_threads": 3
     })";
   auto physMgrAttr =
       testBuildAttributesFromJSONString<AttrMgrs::PhysicsAttributesManager,
@@ -441,6 +444,9 @@ TEST_F(AttributesManagersTest, AttributesManagers_PhysicsJSONLoadTest) {
   ASSERT_EQ(physMgrAttr->getSimulator(), "bullet_test");
   ASSERT_EQ(physMgrAttr->getFrictionCoefficient(), 1.4);
   ASSERT_EQ(physMgrAttr->getRestitutionCoefficient(), 1.1);
+  ASSERT_EQ(physMgrAttr->getStageBvhCacheDirectory(), "bvh_cache");
+  ASSERT_TRUE(physMgrAttr->getMultithreaded());
+  ASSERT_EQ(physMgrAttr->getNumThreads(), 3);
 }  // AttributesManagers_PhysicsJSONLoadTest
 
 /**
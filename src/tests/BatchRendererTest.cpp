@@ -0,0 +1,265 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Compare/Container.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Directory.h>
+#include <Magnum/Image.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/Math/Color.h>
+#include <Magnum/PixelFormat.h>
+#include <string>
+
+#include "esp/assets/ResourceManager.h"
+#include "esp/gfx/RenderCamera.h"
+#include "esp/gfx/RenderTarget.h"
+#include "esp/gfx/Renderer.h"
+#include "esp/gfx/WindowlessContext.h"
+#include "esp/scene/SceneManager.h"
+
+#include "configure.h"
+
+namespace Cr = Corrade;
+namespace Mn = Magnum;
+
+using esp::assets::ResourceManager;
+using esp::gfx::RenderCamera;
+using esp::gfx::Renderer;
+using esp::gfx::RenderTarget;
+using esp::metadata::MetadataMediator;
+using esp::scene::SceneManager;
+using Magnum::Math::Literals::operator""_degf;
+
+namespace Test {
+// on GCC and Clang, the following namespace causes useful warnings to be
+// printed when you have accidentally unused variables or functions in the test
+namespace {
+
+constexpr struct {
+  const char* name;
+  bool batched;
+} DrawBenchmarkData[]{
+    {"4 scenes x 16 views of 128x128, target per view", false},
+    {"4 scenes x 16 views of 128x128, batch", true}};
+
+struct BatchRendererTest : Cr::TestSuite::Tester {
+  explicit BatchRendererTest();
+
+  // tests
+  void batchMatchesSingle();
+
+  // benchmarks
+  void benchmarkDraw();
+  void benchmarkDrawCount();
+
+  void drawCountBegin();
+  std::uint64_t drawCountEnd();
+
+ protected:
+  // init, returns the id of a new scene graph with the test stage
+  int loadScene();
+  // creates views orbiting the stage of numScenes scene graphs
+  void setupViews(int numScenes, int viewsPerScene, const Mn::Vector2i& size);
+
+  // draws every view into its own render target and reads it back
+  std::uint32_t drawSingle();
+  // draws all views into the batch render target and reads it back
+  std::uint32_t drawBatch();
+
+  esp::gfx::WindowlessContext::uptr context_ = nullptr;
+  std::unique_ptr<ResourceManager> resourceManager_ = nullptr;
+  SceneManager::uptr sceneManager_ = nullptr;
+  Renderer::uptr renderer_ = nullptr;
+
+  std::vector<Renderer::BatchView> views_;
+  std::vector<RenderTarget::uptr> singleTargets_;
+  RenderTarget::uptr batchTarget_ = nullptr;
+  Cr::Containers::Array<char> singleRgba_;
+  Cr::Containers::Array<char> batchRgba_;
+  Cr::Containers::Array<char> singleObjectIds_;
+  Cr::Containers::Array<char> batchObjectIds_;
+
+  std::uint64_t numDrawn_ = 0;
+};
+
+BatchRendererTest::BatchRendererTest() {
+  // clang-format off
+  addTests({&BatchRendererTest::batchMatchesSingle});
+
+  addInstancedBenchmarks({&BatchRendererTest::benchmarkDraw}, 10,
+                         Cr::Containers::arraySize(DrawBenchmarkData));
+  addCustomInstancedBenchmarks({&BatchRendererTest::benchmarkDrawCount}, 1,
+                               Cr::Containers::arraySize(DrawBenchmarkData),
+                               &BatchRendererTest::drawCountBegin,
+                               &BatchRendererTest::drawCountEnd,
+                               BenchmarkUnits::Count);
+  // clang-format on
+}
+
+int BatchRendererTest::loadScene() {
+  // set up a default simulation config to initialize MM
+  auto cfg = esp::sim::SimulatorConfiguration{};
+  auto MM = MetadataMediator::create(cfg);
+  // must declare these in this order due to avoid deallocation errors
+  if (!resourceManager_) {
+    resourceManager_ = std::make_unique<ResourceManager>(MM);
+  }
+  if (!sceneManager_) {
+    sceneManager_ = SceneManager::create_unique();
+  }
+  if (!context_) {
+    context_ = esp::gfx::WindowlessContext::create_unique(0);
+  }
+  auto stageAttributesMgr = MM->getStageAttributesManager();
+  std::string stageFile =
+      Cr::Utility::Directory::join(TEST_ASSETS, "objects/5boxes.glb");
+  // create scene attributes file
+  auto stageAttributes = stageAttributesMgr->createObject(stageFile, true);
+  int sceneID = sceneManager_->initSceneGraph();
+
+  std::vector<int> tempIDs{sceneID, esp::ID_UNDEFINED};
+  bool result = resourceManager_->loadStage(
+      stageAttributes, nullptr, sceneManager_.get(), tempIDs, false);
+  CORRADE_VERIFY(result);
+  return sceneID;
+}
+
+void BatchRendererTest::setupViews(int numScenes,
+                                   int viewsPerScene,
+                                   const Mn::Vector2i& size) {
+  if (views_.size() == std::size_t(numScenes * viewsPerScene) &&
+      batchTarget_->tileSize() == size)
+    return;
+
+  views_.clear();
+  singleTargets_.clear();
+  for (int iScene = 0; iScene < numScenes; ++iScene) {
+    const int sceneID = loadScene();
+    auto& sceneGraph = sceneManager_->getSceneGraph(sceneID);
+    for (int iView = 0; iView < viewsPerScene; ++iView) {
+      esp::scene::SceneNode& cameraNode =
+          sceneGraph.getRootNode().createChild();
+      RenderCamera* camera = new RenderCamera(cameraNode);
+      camera->setProjectionMatrix(size.x(), size.y(), 0.01f, 100.0f,
+                                  60.0_degf);
+
+      // orbit the boxes, looking at the origin
+      const Mn::Rad angle{Mn::Constants::tau() * iView / viewsPerScene};
+      camera->resetViewingParameters(
+          {12.0f * Mn::Math::cos(angle), 3.0f, 12.0f * Mn::Math::sin(angle)},
+          {}, Mn::Vector3::yAxis());
+
+      views_.push_back({camera, &sceneGraph});
+    }
+  }
+
+  if (!renderer_) {
+    renderer_ = Renderer::create_unique();
+  }
+  const Mn::Vector2 depthUnprojection = esp::gfx::calculateDepthUnprojection(
+      views_.front().camera->projectionMatrix());
+  for (std::size_t i = 0; i < views_.size(); ++i) {
+    singleTargets_.emplace_back(
+        RenderTarget::create_unique(size, depthUnprojection));
+  }
+  batchTarget_ = renderer_->createBatchRenderTarget(size, views_.size(),
+                                                    depthUnprojection);
+
+  const std::size_t bytes = size.product() * views_.size() * 4;
+  singleRgba_ = Cr::Containers::Array<char>{Cr::Containers::ValueInit, bytes};
+  batchRgba_ = Cr::Containers::Array<char>{Cr::Containers::ValueInit, bytes};
+  singleObjectIds_ =
+      Cr::Containers::Array<char>{Cr::Containers::ValueInit, bytes};
+  batchObjectIds_ =
+      Cr::Containers::Array<char>{Cr::Containers::ValueInit, bytes};
+}
+
+std::uint32_t BatchRendererTest::drawSingle() {
+  std::uint32_t numDrawn = 0;
+  const std::size_t tileBytes =
+      batchTarget_->tileSize().product() * std::size_t{4};
+  for (std::size_t i = 0; i < views_.size(); ++i) {
+    RenderTarget& target = *singleTargets_[i];
+    target.renderEnter();
+    for (auto& it : views_[i].sceneGraph->getDrawableGroups()) {
+      numDrawn += views_[i].camera->draw(
+          it.second, {RenderCamera::Flag::FrustumCulling});
+    }
+    target.renderExit();
+
+    target.readFrameRgba(Mn::MutableImageView2D{
+        Mn::PixelFormat::RGBA8Unorm, target.framebufferSize(),
+        singleRgba_.slice(i * tileBytes, (i + 1) * tileBytes)});
+    target.readFrameObjectId(Mn::MutableImageView2D{
+        Mn::PixelFormat::R32UI, target.framebufferSize(),
+        singleObjectIds_.slice(i * tileBytes, (i + 1) * tileBytes)});
+  }
+  return numDrawn;
+}
+
+std::uint32_t BatchRendererTest::drawBatch() {
+  const std::uint32_t numDrawn = renderer_->drawBatch(*batchTarget_, views_);
+  batchTarget_->readFrameRgba(Mn::MutableImageView2D{
+      Mn::PixelFormat::RGBA8Unorm, batchTarget_->readFrameSize(), batchRgba_});
+  batchTarget_->readFrameObjectId(Mn::MutableImageView2D{
+      Mn::PixelFormat::R32UI, batchTarget_->readFrameSize(), batchObjectIds_});
+  return numDrawn;
+}
+
+void BatchRendererTest::batchMatchesSingle() {
+  setupViews(2, 8, {64, 48});
+
+  const std::uint32_t numDrawnSingle = drawSingle();
+  const std::uint32_t numDrawnBatch = drawBatch();
+  CORRADE_COMPARE(numDrawnBatch, numDrawnSingle);
+  CORRADE_VERIFY(numDrawnBatch > 0);
+
+  // every tile of the batch is the observation of its own view, in order
+  CORRADE_COMPARE_AS(
+      Cr::Containers::arrayCast<const Mn::UnsignedInt>(batchRgba_),
+      Cr::Containers::arrayCast<const Mn::UnsignedInt>(singleRgba_),
+      Cr::TestSuite::Compare::Container);
+  CORRADE_COMPARE_AS(
+      Cr::Containers::arrayCast<const Mn::UnsignedInt>(batchObjectIds_),
+      Cr::Containers::arrayCast<const Mn::UnsignedInt>(singleObjectIds_),
+      Cr::TestSuite::Compare::Container);
+}
+
+void BatchRendererTest::benchmarkDraw() {
+  auto&& data = DrawBenchmarkData[testCaseInstanceId()];
+  setTestCaseDescription(data.name);
+  setupViews(4, 16, {128, 128});
+
+  CORRADE_BENCHMARK(1) {
+    if (data.batched)
+      drawBatch();
+    else
+      drawSingle();
+  }
+}
+
+void BatchRendererTest::benchmarkDrawCount() {
+  auto&& data = DrawBenchmarkData[testCaseInstanceId()];
+  setTestCaseDescription(data.name);
+  setupViews(4, 16, {128, 128});
+
+  CORRADE_BENCHMARK(1) {
+    numDrawn_ += data.batched ? drawBatch() : drawSingle();
+  }
+}
+
+void BatchRendererTest::drawCountBegin() {
+  setBenchmarkName("drawables drawn");
+  numDrawn_ = 0;
+}
+
+std::uint64_t BatchRendererTest::drawCountEnd() {
+  return numDrawn_;
+}
+
+}  // namespace
+}  // namespace Test
+
+CORRADE_TEST_MAIN(Test::BatchRendererTest)
@@ -15,6 +15,7 @@
 #include <string>
 
 #include "esp/assets/ResourceManager.h"
+#include "esp/gfx/DrawableGroup.h"
 #include "esp/gfx/RenderCamera.h"
 #include "esp/gfx/RenderTarget.h"
 #include "esp/gfx/WindowlessContext.h"
@@ -42,7 +43,9 @@ struct CullingTest : Cr::TestSuite::Tester {
 
   // tests
   void computeAbsoluteAABB();
+  void dynamicWorldAABB();
   void frustumCulling();
+  void bvhCulling();
 
  protected:
   esp::gfx::WindowlessContext::uptr context_ = nullptr;
@@ -53,7 +56,9 @@ struct CullingTest : Cr::TestSuite::Tester {
 CullingTest::CullingTest() {
   // clang-format off
   addTests({&CullingTest::computeAbsoluteAABB,
-            &CullingTest::frustumCulling});
+            &CullingTest::dynamicWorldAABB,
+            &CullingTest::frustumCulling,
+            &CullingTest::bvhCulling});
   // clang-format on
 }
 
@@ -141,6 +146,50 @@ void CullingTest::computeAbsoluteAABB() {
   }
 }
 
+void CullingTest::dynamicWorldAABB() {
+  esp::scene::SceneGraph sceneGraph;
+  esp::scene::SceneNode& parentNode = sceneGraph.getRootNode().createChild();
+  esp::scene::SceneNode& meshNode = parentNode.createChild();
+  const float eps = 1e-6;
+
+  // no mesh stored at the node, nothing to cull against
+  CORRADE_VERIFY(!meshNode.getWorldAABB());
+
+  meshNode.setMeshBB({{-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}});
+  meshNode.translate({0.0f, 2.0f, 0.0f});
+  Cr::Containers::Optional<Mn::Range3D> aabb = meshNode.getWorldAABB();
+  CORRADE_VERIFY(aabb);
+  CORRADE_COMPARE_WITH(aabb->min(), (Mn::Vector3{-1.0f, 1.0f, -1.0f}),
+                       Cr::TestSuite::Compare::around(Mn::Vector3{eps}));
+  CORRADE_COMPARE_WITH(aabb->max(), (Mn::Vector3{1.0f, 3.0f, 1.0f}),
+                       Cr::TestSuite::Compare::around(Mn::Vector3{eps}));
+
+  // the cached box is clean until the node or an ancestor moves
+  CORRADE_VERIFY(!meshNode.isDirty());
+  parentNode.translate({4.0f, 0.0f, 0.0f});
+  CORRADE_VERIFY(meshNode.isDirty());
+  aabb = meshNode.getWorldAABB();
+  CORRADE_VERIFY(!meshNode.isDirty());
+  CORRADE_COMPARE_WITH(aabb->min(), (Mn::Vector3{3.0f, 1.0f, -1.0f}),
+                       Cr::TestSuite::Compare::around(Mn::Vector3{eps}));
+  CORRADE_COMPARE_WITH(aabb->max(), (Mn::Vector3{5.0f, 3.0f, 1.0f}),
+                       Cr::TestSuite::Compare::around(Mn::Vector3{eps}));
+
+  // a rotation by pi/4 around z grows the box by sqrt(2) in x and y
+  meshNode.rotateZLocal(Mn::Deg{45.0f});
+  aabb = meshNode.getWorldAABB();
+  CORRADE_COMPARE_WITH(
+      aabb->min(),
+      (Mn::Vector3{4.0f - Mn::Constants::sqrt2(),
+                   2.0f - Mn::Constants::sqrt2(), -1.0f}),
+      Cr::TestSuite::Compare::around(Mn::Vector3{eps}));
+  CORRADE_COMPARE_WITH(
+      aabb->max(),
+      (Mn::Vector3{4.0f + Mn::Constants::sqrt2(),
+                   2.0f + Mn::Constants::sqrt2(), 1.0f}),
+      Cr::TestSuite::Compare::around(Mn::Vector3{eps}));
+}
+
 void CullingTest::frustumCulling() {
   int sceneID = setupTests();
   auto& sceneGraph = sceneManager_->getSceneGraph(sceneID);
@@ -271,6 +320,60 @@ void CullingTest::frustumCulling() {
   target->renderExit();
   CORRADE_COMPARE(numVisibleObjects, numVisibleObjectsGroundTruth);
 }
+
+void CullingTest::bvhCulling() {
+  int sceneID = setupTests();
+  auto& sceneGraph = sceneManager_->getSceneGraph(sceneID);
+  auto& drawables = sceneGraph.getDrawables();
+
+  // all the boxes of the stage are static
+  const esp::gfx::DrawableBVH& bvh = drawables.getStaticBVH();
+  CORRADE_COMPARE(bvh.size(), drawables.size());
+  CORRADE_VERIFY(drawables.getDynamicDrawables().empty());
+
+  esp::scene::SceneNode& cameraNode = sceneGraph.getRootNode().createChild();
+  esp::gfx::RenderCamera& renderCamera =
+      *(new esp::gfx::RenderCamera(cameraNode));
+  renderCamera.setProjectionMatrix(800, 600, 0.01f, 100.0f, 39.6_degf);
+
+  // look around from the middle of the boxes and orbit them, the hierarchy
+  // must keep exactly the drawables the linear culling keeps
+  for (int iView = 0; iView < 16; ++iView) {
+    CORRADE_ITERATION(iView);
+    const Mn::Rad angle{Mn::Constants::tau() * iView / 16};
+    const Mn::Vector3 direction{Mn::Math::cos(angle), 0.0f,
+                                Mn::Math::sin(angle)};
+    const Mn::Vector3 eye = iView % 2 ? Mn::Vector3{0.0f, -2.0f, 2.0f}
+                                      : Mn::Vector3{0.0f, -2.0f, 2.0f} +
+                                            12.0f * direction;
+    renderCamera.resetViewingParameters(eye, eye - direction,
+                                        Mn::Vector3::yAxis());
+
+    std::vector<std::pair<std::reference_wrapper<Mn::SceneGraph::Drawable3D>,
+                          Mn::Matrix4>>
+        drawableTransforms = renderCamera.drawableTransformations(drawables);
+    drawableTransforms.erase(
+        drawableTransforms.begin() + renderCamera.cull(drawableTransforms),
+        drawableTransforms.end());
+    std::vector<Mn::SceneGraph::Drawable3D*> expected;
+    for (auto& a : drawableTransforms) {
+      expected.push_back(&a.first.get());
+    }
+
+    std::vector<std::reference_wrapper<Mn::SceneGraph::Drawable3D>> visible;
+    bvh.cull(Mn::Frustum::fromMatrix(renderCamera.projectionMatrix() *
+                                     renderCamera.cameraMatrix()),
+             visible);
+    std::vector<Mn::SceneGraph::Drawable3D*> actual;
+    for (Mn::SceneGraph::Drawable3D& drawable : visible) {
+      actual.push_back(&drawable);
+    }
+
+    std::sort(expected.begin(), expected.end());
+    std::sort(actual.begin(), actual.end());
+    CORRADE_VERIFY(actual == expected);
+  }
+}
 }  // namespace
 }  // namespace Test
 
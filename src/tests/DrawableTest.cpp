@@ -2,15 +2,23 @@
 // This source code is licensed under the MIT license found in the
 // LICENSE file in the root directory of this source tree.
 
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Compare/Container.h>
 #include <Corrade/TestSuite/Tester.h>
 #include <Corrade/Utility/Directory.h>
 #include <Magnum/GL/Mesh.h>
+#include <Magnum/ImageView.h>
+#include <Magnum/PixelFormat.h>
 #include <Magnum/MeshTools/Compile.h>
 #include <Magnum/Primitives/Cube.h>
 #include <Magnum/Shaders/Flat.h>
 #include <Magnum/Trade/MeshData.h>
+#include <algorithm>
+#include <set>
 #include "esp/assets/ResourceManager.h"
 #include "esp/gfx/GenericDrawable.h"
+#include "esp/gfx/PbrDrawable.h"
+#include "esp/gfx/RenderCamera.h"
 #include "esp/gfx/RenderTarget.h"
 #include "esp/gfx/WindowlessContext.h"
 #include "esp/scene/SceneManager.h"
@@ -41,6 +49,9 @@ struct DrawableTest : Cr::TestSuite::Tester {
   explicit DrawableTest();
   // tests
   void addRemoveDrawables();
+  void sortedDrawState();
+  void instancedDraw();
+  void sharedLightBuffer();
 
  protected:
   esp::gfx::WindowlessContext::uptr context_ =
@@ -51,6 +62,7 @@ struct DrawableTest : Cr::TestSuite::Tester {
   // must create a GL context which will be used in the resource manager
   int sceneID_ = -1;
   esp::gfx::DrawableGroup* drawableGroup_;
+  esp::metadata::attributes::StageAttributes::ptr stageAttributes_;
 };
 
 DrawableTest::DrawableTest() {
@@ -58,19 +70,22 @@ DrawableTest::DrawableTest() {
   auto MM = MetadataMediator::create(cfg);
   resourceManager_ = std::make_unique<ResourceManagerExtended>(MM);
   //clang-format off
-  addTests({&DrawableTest::addRemoveDrawables});
+  addTests({&DrawableTest::addRemoveDrawables,
+            &DrawableTest::sortedDrawState,
+            &DrawableTest::instancedDraw,
+            &DrawableTest::sharedLightBuffer});
   // flang-format on
   auto stageAttributesMgr = MM->getStageAttributesManager();
   std::string stageFile =
       Cr::Utility::Directory::join(TEST_ASSETS, "objects/5boxes.glb");
-  auto stageAttributes = stageAttributesMgr->createObject(stageFile, true);
+  stageAttributes_ = stageAttributesMgr->createObject(stageFile, true);
 
   sceneID_ = sceneManager_.initSceneGraph();
   auto& sceneGraph = sceneManager_.getSceneGraph(sceneID_);
   drawableGroup_ = &sceneGraph.getDrawables();
 
   std::vector<int> tempIDs{sceneID_, esp::ID_UNDEFINED};
-  bool result = resourceManager_->loadStage(stageAttributes, nullptr,
+  bool result = resourceManager_->loadStage(stageAttributes_, nullptr,
                                             &sceneManager_, tempIDs, false);
 }
 
@@ -150,6 +165,246 @@ void DrawableTest::addRemoveDrawables() {
   CORRADE_VERIFY(!drawableGroup_->hasDrawable(dr->getDrawableId()));
 }
 
+void DrawableTest::sortedDrawState() {
+  // the stage in a scene of its own, addRemoveDrawables leaves drawables with
+  // a dangling mesh in the shared one
+  const int sceneID = sceneManager_.initSceneGraph();
+  std::vector<int> tempIDs{sceneID, esp::ID_UNDEFINED};
+  CORRADE_VERIFY(resourceManager_->loadStage(stageAttributes_, nullptr,
+                                             &sceneManager_, tempIDs, false));
+  auto& sceneGraph = sceneManager_.getSceneGraph(sceneID);
+  esp::gfx::DrawableGroup& drawables = sceneGraph.getDrawables();
+
+  esp::scene::SceneNode& cameraNode = sceneGraph.getRootNode().createChild();
+  esp::gfx::RenderCamera& renderCamera =
+      *(new esp::gfx::RenderCamera(cameraNode));
+  const Mn::Vector2i size{64, 64};
+  renderCamera.setProjectionMatrix(size.x(), size.y(), 0.01f, 100.0f,
+                                   Mn::Deg{90.0f});
+  renderCamera.resetViewingParameters({0.0f, 0.0f, 20.0f}, {},
+                                      Mn::Vector3::yAxis());
+
+  // drawn sorted, each shader and each material is bound once per pass, and
+  // the lights are uploaded once per shader
+  std::set<const void*> shaders;
+  std::set<std::pair<const void*, const void*>> materials;
+  for (size_t i = 0; i < drawables.size(); ++i) {
+    esp::gfx::Drawable::StateKey key =
+        static_cast<esp::gfx::Drawable&>(drawables[i]).getStateKey();
+    shaders.insert(key.shader);
+    materials.emplace(key.shader, key.material);
+  }
+
+  esp::gfx::RenderTarget::uptr target = esp::gfx::RenderTarget::create_unique(
+      size, esp::gfx::calculateDepthUnprojection(
+                renderCamera.projectionMatrix()));
+  auto read = [&](Cr::Containers::Array<char>& rgba,
+                  Cr::Containers::Array<char>& objectIds) {
+    rgba = Cr::Containers::Array<char>{Cr::Containers::ValueInit,
+                                       std::size_t(size.product() * 4)};
+    objectIds = Cr::Containers::Array<char>{Cr::Containers::ValueInit,
+                                            std::size_t(size.product() * 4)};
+    target->readFrameRgba(
+        Mn::MutableImageView2D{Mn::PixelFormat::RGBA8Unorm, size, rgba});
+    target->readFrameObjectId(
+        Mn::MutableImageView2D{Mn::PixelFormat::R32UI, size, objectIds});
+  };
+
+  Cr::Containers::Array<char> rgba, objectIds;
+  for (int iPass = 0; iPass < 2; ++iPass) {
+    CORRADE_ITERATION(iPass);
+    target->renderEnter();
+    renderCamera.draw(drawables);
+    target->renderExit();
+
+    const esp::gfx::RenderCamera::DrawStatistics& stats =
+        renderCamera.getPreviousDrawStatistics();
+    CORRADE_COMPARE(stats.drawCalls, drawables.size());
+    CORRADE_COMPARE(stats.shaderBinds, shaders.size());
+    CORRADE_COMPARE(stats.materialBinds, materials.size());
+    CORRADE_COMPARE(stats.lightUploads, shaders.size());
+    CORRADE_VERIFY(stats.drawCalls > 0);
+  }
+  read(rgba, objectIds);
+
+  // the same image as drawing the drawables one at a time in scene graph
+  // order, every one of them binding all of its state
+  target->renderEnter();
+  for (size_t i = 0; i < drawables.size(); ++i) {
+    Mn::SceneGraph::Drawable3D& drawable = drawables[i];
+    const esp::gfx::RenderCamera::DrawableTransforms drawableTransform{
+        {drawable, drawable.object().absoluteTransformationMatrix()}};
+    renderCamera.draw(drawableTransform);
+    CORRADE_COMPARE(renderCamera.getPreviousDrawStatistics().shaderBinds, 1);
+  }
+  target->renderExit();
+  Cr::Containers::Array<char> unsortedRgba, unsortedObjectIds;
+  read(unsortedRgba, unsortedObjectIds);
+
+  CORRADE_COMPARE_AS(
+      Cr::Containers::arrayCast<const Mn::UnsignedInt>(rgba),
+      Cr::Containers::arrayCast<const Mn::UnsignedInt>(unsortedRgba),
+      Cr::TestSuite::Compare::Container);
+  CORRADE_COMPARE_AS(
+      Cr::Containers::arrayCast<const Mn::UnsignedInt>(objectIds),
+      Cr::Containers::arrayCast<const Mn::UnsignedInt>(unsortedObjectIds),
+      Cr::TestSuite::Compare::Container);
+  // and something was drawn over the black clear color to compare
+  bool drawn = false;
+  for (std::size_t i = 0; i < rgba.size(); ++i) {
+    drawn = drawn || (i % 4 != 3 && rgba[i] != 0);
+  }
+  CORRADE_VERIFY(drawn);
+}
+
+void DrawableTest::instancedDraw() {
+  Mn::GL::Mesh box = Mn::MeshTools::compile(Mn::Primitives::cubeSolid());
+
+  // a grid of copies of the same box, each with its own semantic id
+  const int sceneID = sceneManager_.initSceneGraph();
+  auto& sceneGraph = sceneManager_.getSceneGraph(sceneID);
+  esp::gfx::DrawableGroup& drawables = sceneGraph.getDrawables();
+  esp::gfx::Drawable::Flags meshAttributeFlags{};
+  constexpr int numBoxes = 8;
+  for (int i = 0; i < numBoxes; ++i) {
+    esp::scene::SceneNode& node = sceneGraph.getRootNode().createChild();
+    node.translate({3.0f * (i % 4) - 4.5f, 3.0f * (i / 4) - 1.5f, 0.0f});
+    node.setSemanticId(i + 1);
+    node.addFeature<esp::gfx::GenericDrawable>(
+        box, meshAttributeFlags, resourceManager_->getShaderManager(),
+        esp::DEFAULT_LIGHTING_KEY, esp::DEFAULT_MATERIAL_KEY, &drawables);
+  }
+
+  esp::scene::SceneNode& cameraNode = sceneGraph.getRootNode().createChild();
+  esp::gfx::RenderCamera& renderCamera =
+      *(new esp::gfx::RenderCamera(cameraNode));
+  const Mn::Vector2i size{128, 96};
+  renderCamera.setProjectionMatrix(size.x(), size.y(), 0.01f, 100.0f,
+                                   Mn::Deg{90.0f});
+  renderCamera.resetViewingParameters({0.0f, 0.0f, 12.0f}, {},
+                                      Mn::Vector3::yAxis());
+  esp::gfx::RenderTarget::uptr target = esp::gfx::RenderTarget::create_unique(
+      size, esp::gfx::calculateDepthUnprojection(
+                renderCamera.projectionMatrix()));
+
+  auto drawAndRead = [&](esp::gfx::RenderCamera::Flags flags,
+                         Cr::Containers::Array<char>& rgba,
+                         Cr::Containers::Array<char>& objectIds) {
+    target->renderEnter();
+    renderCamera.draw(drawables, flags);
+    target->renderExit();
+    rgba = Cr::Containers::Array<char>{Cr::Containers::ValueInit,
+                                       std::size_t(size.product() * 4)};
+    objectIds = Cr::Containers::Array<char>{Cr::Containers::ValueInit,
+                                            std::size_t(size.product() * 4)};
+    target->readFrameRgba(
+        Mn::MutableImageView2D{Mn::PixelFormat::RGBA8Unorm, size, rgba});
+    target->readFrameObjectId(
+        Mn::MutableImageView2D{Mn::PixelFormat::R32UI, size, objectIds});
+  };
+
+  Cr::Containers::Array<char> rgba, objectIds, instancedRgba,
+      instancedObjectIds;
+  drawAndRead({}, rgba, objectIds);
+  CORRADE_COMPARE(renderCamera.getPreviousDrawStatistics().drawCalls,
+                  numBoxes);
+  drawAndRead(esp::gfx::RenderCamera::Flag::Instancing, instancedRgba,
+              instancedObjectIds);
+  CORRADE_COMPARE(renderCamera.getPreviousDrawStatistics().drawCalls, 1);
+  CORRADE_COMPARE(renderCamera.getPreviousDrawStatistics().instancedDrawables,
+                  numBoxes);
+
+  // every instance keeps its own object id
+  CORRADE_COMPARE_AS(
+      Cr::Containers::arrayCast<const Mn::UnsignedInt>(instancedObjectIds),
+      Cr::Containers::arrayCast<const Mn::UnsignedInt>(objectIds),
+      Cr::TestSuite::Compare::Container);
+  CORRADE_COMPARE_AS(
+      Cr::Containers::arrayCast<const Mn::UnsignedInt>(instancedRgba),
+      Cr::Containers::arrayCast<const Mn::UnsignedInt>(rgba),
+      Cr::TestSuite::Compare::Container);
+}
+
+void DrawableTest::sharedLightBuffer() {
+  Mn::GL::Mesh box = Mn::MeshTools::compile(Mn::Primitives::cubeSolid());
+  esp::gfx::ShaderManager& shaderManager =
+      resourceManager_->getShaderManager();
+  const std::string lightSetupKey = "shared_light_buffer_test";
+  const std::string materialKey = "shared_light_buffer_test_material";
+  resourceManager_->setLightSetup(esp::gfx::getDefaultLights(),
+                                  lightSetupKey);
+  shaderManager.set<esp::gfx::MaterialData>(materialKey,
+                                            new esp::gfx::PbrMaterialData{});
+
+  // a few boxes lit by the same light setup
+  const int sceneID = sceneManager_.initSceneGraph();
+  auto& sceneGraph = sceneManager_.getSceneGraph(sceneID);
+  esp::gfx::DrawableGroup& drawables = sceneGraph.getDrawables();
+  esp::gfx::Drawable::Flags meshAttributeFlags{};
+  constexpr int numBoxes = 4;
+  for (int i = 0; i < numBoxes; ++i) {
+    esp::scene::SceneNode& node = sceneGraph.getRootNode().createChild();
+    node.translate({3.0f * i - 4.5f, 0.0f, 0.0f});
+    node.addFeature<esp::gfx::PbrDrawable>(box, meshAttributeFlags,
+                                           shaderManager, lightSetupKey,
+                                           materialKey, &drawables);
+  }
+
+  esp::scene::SceneNode& cameraNode = sceneGraph.getRootNode().createChild();
+  esp::gfx::RenderCamera& renderCamera =
+      *(new esp::gfx::RenderCamera(cameraNode));
+  const Mn::Vector2i size{64, 48};
+  renderCamera.setProjectionMatrix(size.x(), size.y(), 0.01f, 100.0f,
+                                   Mn::Deg{90.0f});
+  renderCamera.resetViewingParameters({0.0f, 2.0f, 8.0f}, {},
+                                      Mn::Vector3::yAxis());
+  esp::gfx::RenderTarget::uptr target = esp::gfx::RenderTarget::create_unique(
+      size, esp::gfx::calculateDepthUnprojection(
+                renderCamera.projectionMatrix()));
+
+  auto drawAndRead = [&](Cr::Containers::Array<char>& rgba) {
+    target->renderEnter();
+    renderCamera.draw(drawables, {});
+    target->renderExit();
+    rgba = Cr::Containers::Array<char>{Cr::Containers::ValueInit,
+                                       std::size_t(size.product() * 4)};
+    target->readFrameRgba(
+        Mn::MutableImageView2D{Mn::PixelFormat::RGBA8Unorm, size, rgba});
+  };
+
+  // the lights are uploaded once for all the drawables, and not again as
+  // long as the camera stays where it is
+  Cr::Containers::Array<char> rgba, sameCameraRgba, newLightsRgba;
+  drawAndRead(rgba);
+  Mn::Resource<esp::gfx::LightBuffer> lightBuffer =
+      shaderManager.get<esp::gfx::LightBuffer>(lightSetupKey);
+  CORRADE_VERIFY(lightBuffer);
+  CORRADE_COMPARE(lightBuffer->numUploads(), 1);
+  CORRADE_COMPARE(renderCamera.getPreviousDrawStatistics().lightUploads, 1);
+  drawAndRead(sameCameraRgba);
+  CORRADE_COMPARE(lightBuffer->numUploads(), 1);
+  CORRADE_COMPARE_AS(
+      Cr::Containers::arrayCast<const Mn::UnsignedInt>(sameCameraRgba),
+      Cr::Containers::arrayCast<const Mn::UnsignedInt>(rgba),
+      Cr::TestSuite::Compare::Container);
+
+  // a moved camera sees the lights elsewhere
+  renderCamera.node().translate({0.0f, 0.0f, 1.0f});
+  drawAndRead(sameCameraRgba);
+  CORRADE_COMPARE(lightBuffer->numUploads(), 2);
+  renderCamera.node().translate({0.0f, 0.0f, -1.0f});
+
+  // replacing the light setup updates the buffer
+  resourceManager_->setLightSetup(
+      esp::gfx::LightSetup{{{0.0f, -1.0f, 0.0f, 0.0f}, {0.2f, 0.0f, 0.0f}},
+                           {{0.0f, 0.0f, -1.0f, 0.0f}, {0.0f, 0.0f, 0.2f}}},
+      lightSetupKey);
+  drawAndRead(newLightsRgba);
+  CORRADE_COMPARE(lightBuffer->numUploads(), 3);
+  CORRADE_VERIFY(!std::equal(newLightsRgba.begin(), newLightsRgba.end(),
+                             rgba.begin()));
+}
+
 }  // namespace
 }  // namespace Test
 
@@ -0,0 +1,190 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Directory.h>
+#include <Magnum/GL/Renderer.h>
+#include <string>
+
+#include "esp/assets/ResourceManager.h"
+#include "esp/gfx/DepthUnprojection.h"
+#include "esp/gfx/RenderCamera.h"
+#include "esp/gfx/RenderTarget.h"
+#include "esp/gfx/WindowlessContext.h"
+#include "esp/scene/SceneManager.h"
+
+#include "configure.h"
+
+namespace Cr = Corrade;
+namespace Mn = Magnum;
+
+using esp::assets::ResourceManager;
+using esp::gfx::RenderCamera;
+using esp::gfx::RenderTarget;
+using esp::metadata::MetadataMediator;
+using esp::scene::SceneManager;
+using Magnum::Math::Literals::operator""_degf;
+
+namespace Test {
+// on GCC and Clang, the following namespace causes useful warnings to be
+// printed when you have accidentally unused variables or functions in the test
+namespace {
+
+// triangles of the two meshes of the donut
+constexpr std::uint64_t DonutTriangles = 8064 + 672;
+
+constexpr struct {
+  const char* name;
+  Mn::Vector2i size;
+  bool lod;
+} DrawBenchmarkData[]{
+    {"64x64, full detail", {64, 64}, false},
+    {"64x64, levels of detail", {64, 64}, true},
+    {"256x256, full detail", {256, 256}, false},
+    {"256x256, levels of detail", {256, 256}, true},
+    {"1024x1024, full detail", {1024, 1024}, false},
+    {"1024x1024, levels of detail", {1024, 1024}, true}};
+
+struct MeshLODRenderTest : Cr::TestSuite::Tester {
+  explicit MeshLODRenderTest();
+
+  // tests
+  void lodByDistance();
+
+  // benchmarks
+  void benchmarkDraw();
+  void benchmarkDrawTriangles();
+
+  void trianglesBegin();
+  std::uint64_t trianglesEnd();
+
+ protected:
+  // draws the donut seen from eye, returns the statistics of the pass
+  RenderCamera::DrawStatistics draw(const Mn::Vector2i& size,
+                                    const Mn::Vector3& eye,
+                                    bool lod);
+
+  esp::gfx::WindowlessContext::uptr context_ = nullptr;
+  // must declare these in this order due to avoid deallocation errors
+  std::unique_ptr<ResourceManager> resourceManager_ = nullptr;
+  SceneManager::uptr sceneManager_ = nullptr;
+  int sceneID_ = esp::ID_UNDEFINED;
+  RenderCamera* camera_ = nullptr;
+  RenderTarget::uptr target_ = nullptr;
+
+  std::uint64_t numTriangles_ = 0;
+};
+
+MeshLODRenderTest::MeshLODRenderTest() {
+  // clang-format off
+  addTests({&MeshLODRenderTest::lodByDistance});
+
+  addInstancedBenchmarks({&MeshLODRenderTest::benchmarkDraw}, 10,
+                         Cr::Containers::arraySize(DrawBenchmarkData));
+  addCustomInstancedBenchmarks({&MeshLODRenderTest::benchmarkDrawTriangles}, 1,
+                               Cr::Containers::arraySize(DrawBenchmarkData),
+                               &MeshLODRenderTest::trianglesBegin,
+                               &MeshLODRenderTest::trianglesEnd,
+                               BenchmarkUnits::Count);
+  // clang-format on
+
+  context_ = esp::gfx::WindowlessContext::create_unique(0);
+  auto cfg = esp::sim::SimulatorConfiguration{};
+  auto MM = MetadataMediator::create(cfg);
+  resourceManager_ = std::make_unique<ResourceManager>(MM);
+  resourceManager_->setGenerateMeshLODs(true);
+  sceneManager_ = SceneManager::create_unique();
+
+  auto stageAttributesMgr = MM->getStageAttributesManager();
+  std::string stageFile =
+      Cr::Utility::Directory::join(TEST_ASSETS, "objects/donut.glb");
+  auto stageAttributes = stageAttributesMgr->createObject(stageFile, true);
+  sceneID_ = sceneManager_->initSceneGraph();
+  std::vector<int> tempIDs{sceneID_, esp::ID_UNDEFINED};
+  resourceManager_->loadStage(stageAttributes, nullptr, sceneManager_.get(),
+                              tempIDs, false);
+
+  auto& sceneGraph = sceneManager_->getSceneGraph(sceneID_);
+  camera_ = new RenderCamera(sceneGraph.getRootNode().createChild());
+}
+
+RenderCamera::DrawStatistics MeshLODRenderTest::draw(const Mn::Vector2i& size,
+                                                     const Mn::Vector3& eye,
+                                                     bool lod) {
+  camera_->setProjectionMatrix(size.x(), size.y(), 0.01f, 100.0f, 60.0_degf);
+  camera_->resetViewingParameters(eye, {}, Mn::Vector3::yAxis());
+  if (!target_ || target_->framebufferSize() != size) {
+    target_ = RenderTarget::create_unique(
+        size,
+        esp::gfx::calculateDepthUnprojection(camera_->projectionMatrix()));
+  }
+
+  target_->renderEnter();
+  camera_->draw(sceneManager_->getSceneGraph(sceneID_).getDrawables(),
+                lod ? RenderCamera::Flags{RenderCamera::Flag::MeshLOD}
+                    : RenderCamera::Flags{});
+  target_->renderExit();
+  return camera_->getPreviousDrawStatistics();
+}
+
+void MeshLODRenderTest::lodByDistance() {
+  // without levels of detail, both meshes are drawn in full
+  RenderCamera::DrawStatistics stats =
+      draw({256, 256}, {0.0f, 0.0f, 20.0f}, false);
+  CORRADE_COMPARE(stats.triangles, DonutTriangles);
+  CORRADE_COMPARE(stats.reducedDrawables, 0);
+
+  // from inside their bounding spheres as well
+  stats = draw({256, 256}, {0.05f, 0.05f, 0.05f}, true);
+  CORRADE_COMPARE(stats.triangles, DonutTriangles);
+  CORRADE_COMPARE(stats.reducedDrawables, 0);
+
+  // far away, the donut covers a few pixels and both meshes are reduced
+  stats = draw({64, 64}, {0.0f, 0.0f, 20.0f}, true);
+  CORRADE_COMPARE(stats.reducedDrawables, 2);
+  CORRADE_VERIFY(stats.triangles * 4 < DonutTriangles);
+
+  // the higher the resolution, the finer the level
+  const std::uint64_t lowResolution =
+      draw({64, 64}, {0.0f, 0.0f, 1.0f}, true).triangles;
+  const std::uint64_t highResolution =
+      draw({1024, 1024}, {0.0f, 0.0f, 1.0f}, true).triangles;
+  CORRADE_VERIFY(lowResolution <= highResolution);
+  CORRADE_VERIFY(highResolution <= DonutTriangles);
+}
+
+void MeshLODRenderTest::benchmarkDraw() {
+  auto&& data = DrawBenchmarkData[testCaseInstanceId()];
+  setTestCaseDescription(data.name);
+  draw(data.size, {0.0f, 0.3f, 1.0f}, data.lod);
+
+  CORRADE_BENCHMARK(1) {
+    draw(data.size, {0.0f, 0.3f, 1.0f}, data.lod);
+    Mn::GL::Renderer::finish();
+  }
+}
+
+void MeshLODRenderTest::benchmarkDrawTriangles() {
+  auto&& data = DrawBenchmarkData[testCaseInstanceId()];
+  setTestCaseDescription(data.name);
+
+  CORRADE_BENCHMARK(1) {
+    numTriangles_ += draw(data.size, {0.0f, 0.3f, 1.0f}, data.lod).triangles;
+  }
+}
+
+void MeshLODRenderTest::trianglesBegin() {
+  setBenchmarkName("triangles drawn");
+  numTriangles_ = 0;
+}
+
+std::uint64_t MeshLODRenderTest::trianglesEnd() {
+  return numTriangles_;
+}
+
+}  // namespace
+}  // namespace Test
+
+CORRADE_TEST_MAIN(Test::MeshLODRenderTest)
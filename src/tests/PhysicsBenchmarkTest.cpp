@@ -0,0 +1,194 @@
+// Copyright (c) Facebook, Inc. and its affiliates.
+// This source code is licensed under the MIT license found in the
+// LICENSE file in the root directory of this source tree.
+
+#include <Corrade/Containers/Array.h>
+#include <Corrade/TestSuite/Compare/Numeric.h>
+#include <Corrade/TestSuite/Tester.h>
+#include <Corrade/Utility/Directory.h>
+#include <Magnum/Math/Quaternion.h>
+#include <string>
+
+#include "esp/assets/ResourceManager.h"
+#include "esp/gfx/WindowlessContext.h"
+#include "esp/physics/PhysicsManager.h"
+#ifdef ESP_BUILD_WITH_BULLET
+#include "esp/physics/bullet/BulletPhysicsManager.h"
+#endif
+#include "esp/scene/SceneManager.h"
+#include "esp/sim/Simulator.h"
+
+#include "configure.h"
+
+namespace Cr = Corrade;
+namespace Mn = Magnum;
+
+using esp::assets::ResourceManager;
+using esp::metadata::MetadataMediator;
+using esp::metadata::attributes::ObjectAttributes;
+using esp::physics::PhysicsManager;
+using esp::scene::SceneManager;
+
+namespace Test {
+// on GCC and Clang, the following namespace causes useful warnings to be
+// printed when you have accidentally unused variables or functions in the test
+namespace {
+
+const std::string physicsConfigFile =
+    Cr::Utility::Directory::join(DATA_DIR, "default.physics_config.json");
+const std::string stageFile =
+    Cr::Utility::Directory::join(TEST_ASSETS, "scenes/plane.glb");
+const std::string boxFile =
+    Cr::Utility::Directory::join(TEST_ASSETS, "objects/transform_box.glb");
+
+constexpr struct {
+  const char* name;
+  bool multithreaded;
+} WorldData[]{{"single-threaded", false}, {"multithreaded", true}};
+
+struct PhysicsBenchmarkTest : Cr::TestSuite::Tester {
+  explicit PhysicsBenchmarkTest();
+
+  // tests
+  void boxFalls();
+
+  // benchmarks
+  void benchmarkStep();
+
+ protected:
+  // creates a physics manager with the plane stage, returns false if there
+  // is no Bullet to simulate with
+  bool initWorld(bool multithreaded);
+
+  // whether the world created by initWorld() is the multithreaded one
+  bool isMultithreadedWorld() const;
+
+  // adds a 2x2x2 box at the given translation and rotation
+  int addBox(const Mn::Vector3& translation, const Mn::Quaternion& rotation);
+
+  esp::gfx::WindowlessContext::uptr context_ = nullptr;
+  // must declare these in this order due to avoid deallocation errors
+  std::shared_ptr<MetadataMediator> metadataMediator_ = nullptr;
+  std::unique_ptr<ResourceManager> resourceManager_ = nullptr;
+  SceneManager::uptr sceneManager_ = nullptr;
+  int sceneID_ = esp::ID_UNDEFINED;
+  PhysicsManager::ptr physicsManager_ = nullptr;
+};
+
+PhysicsBenchmarkTest::PhysicsBenchmarkTest() {
+  addInstancedTests({&PhysicsBenchmarkTest::boxFalls},
+                    Cr::Containers::arraySize(WorldData));
+
+  addInstancedBenchmarks({&PhysicsBenchmarkTest::benchmarkStep}, 10,
+                         Cr::Containers::arraySize(WorldData));
+
+  context_ = esp::gfx::WindowlessContext::create_unique(0);
+  auto cfg = esp::sim::SimulatorConfiguration{};
+  metadataMediator_ = MetadataMediator::create(cfg);
+  resourceManager_ = std::make_unique<ResourceManager>(metadataMediator_);
+  sceneManager_ = SceneManager::create_unique();
+  sceneID_ = sceneManager_->initSceneGraph();
+
+  ObjectAttributes::ptr boxAttributes = ObjectAttributes::create();
+  boxAttributes->setRenderAssetHandle(boxFile);
+  boxAttributes->setMargin(0.0);
+  metadataMediator_->getObjectAttributesManager()->registerObject(boxAttributes,
+                                                                  boxFile);
+}
+
+bool PhysicsBenchmarkTest::initWorld(bool multithreaded) {
+  auto& rootNode = sceneManager_->getSceneGraph(sceneID_).getRootNode();
+
+  auto physicsManagerAttributes =
+      metadataMediator_->getPhysicsAttributesManager()->createObject(
+          physicsConfigFile, true);
+  physicsManagerAttributes->setMultithreaded(multithreaded);
+  auto stageAttributesMgr = metadataMediator_->getStageAttributesManager();
+  stageAttributesMgr->setCurrPhysicsManagerAttributesHandle(
+      physicsManagerAttributes->getHandle());
+  auto stageAttributes = stageAttributesMgr->createObject(stageFile, true);
+
+  physicsManager_.reset();
+  resourceManager_->initPhysicsManager(physicsManager_, true, &rootNode,
+                                       physicsManagerAttributes);
+  std::vector<int> tempIDs{sceneID_, esp::ID_UNDEFINED};
+  resourceManager_->loadStage(stageAttributes, physicsManager_,
+                              sceneManager_.get(), tempIDs, false);
+  return physicsManager_->getPhysicsSimulationLibrary() ==
+         PhysicsManager::PhysicsSimulationLibrary::BULLET;
+}
+
+bool PhysicsBenchmarkTest::isMultithreadedWorld() const {
+#ifdef ESP_BUILD_WITH_BULLET
+  return static_cast<esp::physics::BulletPhysicsManager&>(*physicsManager_)
+      .isMultithreaded();
+#else
+  return false;
+#endif
+}
+
+int PhysicsBenchmarkTest::addBox(const Mn::Vector3& translation,
+                                 const Mn::Quaternion& rotation) {
+  const int objectId = physicsManager_->addObject(boxFile, nullptr);
+  physicsManager_->setTranslation(objectId, translation);
+  physicsManager_->setRotation(objectId, rotation);
+  return objectId;
+}
+
+void PhysicsBenchmarkTest::boxFalls() {
+  auto&& data = WorldData[testCaseInstanceId()];
+  setTestCaseDescription(data.name);
+  if (!initWorld(data.multithreaded))
+    CORRADE_SKIP("Bullet is not available.");
+#ifdef ESP_BUILD_WITH_BULLET
+  if (data.multithreaded &&
+      !esp::physics::BulletPhysicsManager::isMultithreadingAvailable())
+    CORRADE_SKIP("Bullet was built without BULLET2_MULTITHREADING.");
+#endif
+  CORRADE_COMPARE(isMultithreadedWorld(), data.multithreaded);
+
+  // a box dropped from 5 above the ground comes to rest on it
+  const int objectId = addBox({0.0f, 5.0f, 0.0f}, Mn::Quaternion{});
+  for (int i = 0; i < 300; ++i) {
+    physicsManager_->stepPhysics(1.0 / 60.0);
+  }
+  const Mn::Vector3 translation = physicsManager_->getTranslation(objectId);
+  CORRADE_COMPARE_WITH(translation.y(), 1.0f,
+                       Cr::TestSuite::Compare::around(0.05f));
+  CORRADE_COMPARE_WITH(translation.x(), 0.0f,
+                       Cr::TestSuite::Compare::around(0.05f));
+  CORRADE_COMPARE_WITH(translation.z(), 0.0f,
+                       Cr::TestSuite::Compare::around(0.05f));
+}
+
+void PhysicsBenchmarkTest::benchmarkStep() {
+  auto&& data = WorldData[testCaseInstanceId()];
+  setTestCaseDescription(data.name);
+  if (!initWorld(data.multithreaded))
+    CORRADE_SKIP("Bullet is not available.");
+  if (data.multithreaded && !isMultithreadedWorld())
+    CORRADE_SKIP("Bullet was built without BULLET2_MULTITHREADING.");
+
+  // 8x8 piles of 6 boxes, tilted so that they topple into each other
+  for (int i = 0; i < 8; ++i) {
+    for (int j = 0; j < 8; ++j) {
+      for (int k = 0; k < 6; ++k) {
+        addBox({2.5f * (i - 3.5f), 1.05f + 2.1f * k, 2.5f * (j - 3.5f)},
+               Mn::Quaternion::rotation(Mn::Deg(5.0f * (k % 3)),
+                                        Mn::Vector3{1.0f, 0.0f, 1.0f}
+                                            .normalized()));
+      }
+    }
+  }
+  // let the piles start colliding
+  for (int i = 0; i < 30; ++i) {
+    physicsManager_->stepPhysics(1.0 / 60.0);
+  }
+
+  CORRADE_BENCHMARK(10) { physicsManager_->stepPhysics(1.0 / 60.0); }
+}
+
+}  // namespace
+}  // namespace Test
+
+CORRADE_TEST_MAIN(Test::PhysicsBenchmarkTest)
@@ -4,6 +4,7 @@
 
 #include <Corrade/Utility/Directory.h>
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <string>
 
 #include "esp/sim/Simulator.h"
@@ -49,7 +50,8 @@ class PhysicsManagerTest : public testing::Test {
         metadataMediator_->getPhysicsAttributesManager();
   };
 
-  void initStage(const std::string stageFile) {
+  void initStage(const std::string stageFile,
+                 const std::string& stageBvhCacheDirectory = "") {
     auto& sceneGraph = sceneManager_.getSceneGraph(sceneID_);
     auto& rootNode = sceneGraph.getRootNode();
 
@@ -58,6 +60,8 @@ class PhysicsManagerTest : public testing::Test {
         physicsAttributesManager_->createObject(physicsConfigFile, true);
     auto stageAttributesMgr = metadataMediator_->getStageAttributesManager();
     if (physicsManagerAttributes != nullptr) {
+      physicsManagerAttributes->setStageBvhCacheDirectory(
+          stageBvhCacheDirectory);
       stageAttributesMgr->setCurrPhysicsManagerAttributesHandle(
           physicsManagerAttributes->getHandle());
     }
@@ -296,6 +300,174 @@ TEST_F(PhysicsManagerTest, DiscreteContactTest) {
   }
 }
 
+TEST_F(PhysicsManagerTest, BatchedContactTest) {
+  LOG(INFO) << "Starting physics test: BatchedContactTest";
+
+  std::string stageFile =
+      Cr::Utility::Directory::join(dataDir, "test_assets/scenes/plane.glb");
+  std::string objectFile = Cr::Utility::Directory::join(
+      dataDir, "test_assets/objects/transform_box.glb");
+
+  initStage(stageFile);
+
+  if (physicsManager_->getPhysicsSimulationLibrary() ==
+      PhysicsManager::PhysicsSimulationLibrary::BULLET) {
+    ObjectAttributes::ptr ObjectAttributes = ObjectAttributes::create();
+    ObjectAttributes->setRenderAssetHandle(objectFile);
+    ObjectAttributes->setMargin(0.0);
+    auto objectAttributesManager =
+        metadataMediator_->getObjectAttributesManager();
+    objectAttributesManager->registerObject(ObjectAttributes, objectFile);
+
+    // three 2x2x2 boxes, collision free 0.1 above the ground and 0.2 apart
+    std::vector<int> objectIds;
+    for (int i = 0; i < 3; ++i) {
+      objectIds.push_back(physicsManager_->addObject(objectFile, nullptr));
+      physicsManager_->setTranslation(objectIds.back(),
+                                      Magnum::Vector3{2.2f * i, 1.1, 0});
+    }
+    ASSERT_EQ(physicsManager_->contactTestBatch(objectIds),
+              (std::vector<bool>{false, false, false}));
+    ASSERT_TRUE(physicsManager_->getContactPairs().empty());
+
+    // move box 0 into the floor and box 2 into box 1
+    physicsManager_->setTranslation(objectIds[0], Magnum::Vector3{0, 0.9, 0});
+    physicsManager_->setTranslation(objectIds[2], Magnum::Vector3{3.3, 1.1, 0});
+    const std::vector<bool> batched =
+        physicsManager_->contactTestBatch(objectIds);
+    ASSERT_EQ(batched, (std::vector<bool>{true, true, true}));
+    for (std::size_t i = 0; i < objectIds.size(); ++i) {
+      ASSERT_EQ(physicsManager_->contactTest(objectIds[i]), batched[i]);
+    }
+
+    // the order of the queries is kept, duplicates are allowed
+    ASSERT_EQ(physicsManager_->contactTestBatch({objectIds[2], objectIds[0],
+                                                 objectIds[2]}),
+              (std::vector<bool>{true, true, true}));
+
+    // box 0 with the stage, boxes 1 and 2 together
+    std::vector<esp::physics::ContactPairInfo> pairs =
+        physicsManager_->getContactPairs();
+    ASSERT_EQ(pairs.size(), 2u);
+    int stagePairs = 0;
+    for (const esp::physics::ContactPairInfo& pair : pairs) {
+      ASSERT_GT(pair.numContactPoints, 0);
+      const int idA = std::min(pair.objectIdA, pair.objectIdB);
+      const int idB = std::max(pair.objectIdA, pair.objectIdB);
+      if (idA == -1) {
+        ++stagePairs;
+        ASSERT_EQ(idB, objectIds[0]);
+      } else {
+        ASSERT_EQ(idA, std::min(objectIds[1], objectIds[2]));
+        ASSERT_EQ(idB, std::max(objectIds[1], objectIds[2]));
+      }
+    }
+    ASSERT_EQ(stagePairs, 1);
+
+    // move box 2 to 0.005 from box 1, closer than the contact breaking
+    // threshold: the manifold keeps points there, but the boxes do not touch
+    physicsManager_->setTranslation(objectIds[2],
+                                    Magnum::Vector3{4.205, 1.1, 0});
+    const std::vector<bool> nearMiss =
+        physicsManager_->contactTestBatch(objectIds);
+    ASSERT_EQ(nearMiss, (std::vector<bool>{true, false, false}));
+    for (std::size_t i = 0; i < objectIds.size(); ++i) {
+      ASSERT_EQ(physicsManager_->contactTest(objectIds[i]), nearMiss[i]);
+    }
+    pairs = physicsManager_->getContactPairs();
+    ASSERT_EQ(pairs.size(), 1u);
+    ASSERT_EQ(std::min(pairs[0].objectIdA, pairs[0].objectIdB), -1);
+
+    // move box 2 back into box 1 and set the stage to non-collidable
+    physicsManager_->setTranslation(objectIds[2], Magnum::Vector3{3.3, 1.1, 0});
+    physicsManager_->setStageIsCollidable(false);
+    ASSERT_EQ(physicsManager_->contactTestBatch(objectIds),
+              (std::vector<bool>{false, true, true}));
+    ASSERT_EQ(physicsManager_->getContactPairs().size(), 1u);
+  }
+}
+
+TEST_F(PhysicsManagerTest, BatchedRaycastTest) {
+  // test that casting a batch of rays gives the hits of casting them one by
+  // one
+  LOG(INFO) << "Starting physics test: BatchedRaycastTest";
+
+  std::string stageFile =
+      Cr::Utility::Directory::join(dataDir, "test_assets/scenes/plane.glb");
+  std::string objectFile = Cr::Utility::Directory::join(
+      dataDir, "test_assets/objects/transform_box.glb");
+
+  initStage(stageFile);
+
+  if (physicsManager_->getPhysicsSimulationLibrary() ==
+      PhysicsManager::PhysicsSimulationLibrary::BULLET) {
+    ObjectAttributes::ptr ObjectAttributes = ObjectAttributes::create();
+    ObjectAttributes->setRenderAssetHandle(objectFile);
+    ObjectAttributes->setMargin(0.0);
+    auto objectAttributesManager =
+        metadataMediator_->getObjectAttributesManager();
+    objectAttributesManager->registerObject(ObjectAttributes, objectFile);
+
+    // two 2x2x2 boxes above the ground, one of them rotated
+    std::vector<int> objectIds;
+    for (int i = 0; i < 2; ++i) {
+      objectIds.push_back(physicsManager_->addObject(objectFile, nullptr));
+      physicsManager_->setTranslation(objectIds.back(),
+                                      Magnum::Vector3{3.0f * i, 1.1, 0});
+    }
+    physicsManager_->setRotation(
+        objectIds[1], Magnum::Quaternion::rotation(Magnum::Deg(45.0f),
+                                                   Magnum::Vector3::yAxis()));
+
+    // rays down through both boxes and the ground, sideways through both boxes
+    // and a zero length ray
+    std::vector<esp::geo::Ray> rays;
+    for (int i = 0; i < 200; ++i) {
+      const float x = -2.0f + 0.04f * i;
+      rays.push_back(esp::geo::Ray{{x, 5.0f, 0.1f}, {0.0f, -1.0f, 0.0f}});
+      rays.push_back(
+          esp::geo::Ray{{-5.0f, 0.025f + 0.05f * i, 0.2f}, {2.0f, 0, 0}});
+    }
+    rays.push_back(esp::geo::Ray{{0, 5.0f, 0}, {0, 0, 0}});
+
+    for (const bool closestHitOnly : {false, true}) {
+      const esp::physics::RaycastBatchResults batch =
+          physicsManager_->castRays(rays, 10.0, closestHitOnly);
+      ASSERT_EQ(batch.numRays(), int(rays.size()));
+      ASSERT_EQ(batch.rayHitOffsets.front(), 0);
+      const std::size_t numHits = batch.rayHitOffsets.back();
+      ASSERT_EQ(batch.objectIds.size(), numHits);
+      ASSERT_EQ(batch.points.size(), numHits);
+      ASSERT_EQ(batch.normals.size(), numHits);
+      ASSERT_EQ(batch.rayDistances.size(), numHits);
+
+      int objectHits = 0;
+      for (std::size_t i = 0; i < rays.size(); ++i) {
+        const esp::physics::RaycastResults results =
+            physicsManager_->castRay(rays[i], 10.0);
+        const std::size_t expectedHits =
+            closestHitOnly ? std::min<std::size_t>(results.hits.size(), 1)
+                           : results.hits.size();
+        ASSERT_EQ(batch.numHits(i), int(expectedHits));
+        for (std::size_t j = 0; j < expectedHits; ++j) {
+          const int hitIndex = batch.rayHitOffsets[i] + j;
+          const esp::physics::RayHitInfo& hit = results.hits[j];
+          ASSERT_EQ(batch.objectIds[hitIndex], hit.objectId);
+          ASSERT_NEAR(batch.rayDistances[hitIndex], hit.rayDistance, 1.0e-5);
+          ASSERT_LE((batch.points[hitIndex] - hit.point).length(), 1.0e-4);
+          ASSERT_LE((batch.normals[hitIndex] - hit.normal).length(), 1.0e-4);
+          if (hit.objectId != -1) {
+            ++objectHits;
+          }
+        }
+      }
+      ASSERT_GT(objectHits, 0);
+      // the zero length ray has no hits
+      ASSERT_EQ(batch.numHits(int(rays.size()) - 1), 0);
+    }
+  }
+}
+
 TEST_F(PhysicsManagerTest, BulletCompoundShapeMargins) {
   // test that all different construction methods for a simple shape result in
   // the same Aabb for the given margin
@@ -360,6 +532,106 @@ TEST_F(PhysicsManagerTest, BulletCompoundShapeMargins) {
     ASSERT_EQ(AabbOb2, objectGroundTruth);
   }
 }
+
+TEST_F(PhysicsManagerTest, BulletStageBvhCache) {
+  // test that a stage loads the same from its cached bounding volume
+  // hierarchies as when building them
+  LOG(INFO) << "Starting physics test: BulletStageBvhCache";
+
+  std::string stageFile = Cr::Utility::Directory::join(
+      dataDir, "test_assets/scenes/simple_room.glb");
+  const std::string cacheDirectory = Cr::Utility::Directory::join(
+      Cr::Utility::Directory::tmp(), "PhysicsTest_BulletStageBvhCache");
+  for (const std::string& file : Cr::Utility::Directory::list(
+           cacheDirectory, Cr::Utility::Directory::Flag::SkipDotAndDotDot)) {
+    Cr::Utility::Directory::rm(
+        Cr::Utility::Directory::join(cacheDirectory, file));
+  }
+
+  initStage(stageFile, cacheDirectory);
+  if (physicsManager_->getPhysicsSimulationLibrary() ==
+      PhysicsManager::PhysicsSimulationLibrary::BULLET) {
+    auto* bPhysManager =
+        static_cast<esp::physics::BulletPhysicsManager*>(physicsManager_.get());
+    const Magnum::Range3D builtAabb =
+        bPhysManager->getStageCollisionShapeAabb();
+
+    // the hierarchies are stored
+    ASSERT_FALSE(Cr::Utility::Directory::list(
+                     cacheDirectory,
+                     Cr::Utility::Directory::Flag::SkipDotAndDotDot)
+                     .empty());
+
+    // a new physics manager loads them
+    physicsManager_.reset();
+    initStage(stageFile, cacheDirectory);
+    bPhysManager =
+        static_cast<esp::physics::BulletPhysicsManager*>(physicsManager_.get());
+    ASSERT_EQ(bPhysManager->getStageCollisionShapeAabb(), builtAabb);
+
+    // and queries against the loaded hierarchies hit the stage
+    esp::geo::Ray ray{{builtAabb.center().x(), builtAabb.max().y() + 1.0f,
+                       builtAabb.center().z()},
+                      {0.0, -1.0, 0.0}};
+    ASSERT_TRUE(physicsManager_->castRay(ray, 100.0).hasHits());
+  }
+}
+
+TEST_F(PhysicsManagerTest, BulletSharedCollisionShapes) {
+  // test that instances of an object sharing their convex hulls keep their
+  // own margins and scales
+  LOG(INFO) << "Starting physics test: BulletSharedCollisionShapes";
+
+  std::string objectFile = Cr::Utility::Directory::join(
+      dataDir, "test_assets/objects/nested_box.glb");
+
+  initStage(objectFile);
+
+  if (physicsManager_->getPhysicsSimulationLibrary() ==
+      PhysicsManager::PhysicsSimulationLibrary::BULLET) {
+    ObjectAttributes::ptr ObjectAttributes = ObjectAttributes::create();
+    ObjectAttributes->setRenderAssetHandle(objectFile);
+    ObjectAttributes->setMargin(0.0);
+
+    auto objectAttributesManager =
+        metadataMediator_->getObjectAttributesManager();
+    objectAttributesManager->registerObject(ObjectAttributes, objectFile);
+
+    auto* drawables = &sceneManager_.getSceneGraph(sceneID_).getDrawables();
+
+    int objectId0 = physicsManager_->addObject(objectFile, drawables);
+    int objectId1 = physicsManager_->addObject(objectFile, drawables);
+
+    ObjectAttributes::ptr objectTemplate =
+        objectAttributesManager->getObjectCopyByHandle(objectFile);
+    objectTemplate->setScale({2.0, 2.0, 2.0});
+    objectAttributesManager->registerObject(objectTemplate);
+    int objectId2 = physicsManager_->addObject(objectFile, drawables);
+
+    esp::physics::BulletPhysicsManager* bPhysManager =
+        static_cast<esp::physics::BulletPhysicsManager*>(physicsManager_.get());
+
+    Magnum::Range3D objectGroundTruth({-1.0, -1.0, -1.0}, {1.0, 1.0, 1.0});
+    ASSERT_EQ(bPhysManager->getCollisionShapeAabb(objectId0),
+              objectGroundTruth);
+    ASSERT_EQ(bPhysManager->getCollisionShapeAabb(objectId1),
+              objectGroundTruth);
+    ASSERT_EQ(bPhysManager->getCollisionShapeAabb(objectId2),
+              Magnum::Range3D({-2.0, -2.0, -2.0}, {2.0, 2.0, 2.0}));
+
+    // changing the margin of an instance leaves the others untouched
+    bPhysManager->setMargin(objectId0, 0.1);
+    ASSERT_NE(bPhysManager->getCollisionShapeAabb(objectId0),
+              objectGroundTruth);
+    ASSERT_EQ(bPhysManager->getCollisionShapeAabb(objectId1),
+              objectGroundTruth);
+
+    // new instances get the hulls as they were built
+    int objectId3 = physicsManager_->addObject(objectFile, drawables);
+    ASSERT_EQ(bPhysManager->getCollisionShapeAabb(objectId3),
+              Magnum::Range3D({-2.0, -2.0, -2.0}, {2.0, 2.0, 2.0}));
+  }
+}
 #endif
 
 TEST_F(PhysicsManagerTest, ConfigurableScaling) {
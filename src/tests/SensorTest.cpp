@@ -3,9 +3,15 @@
 // LICENSE file in the root directory of this source tree.
 #include <Corrade/TestSuite/Tester.h>
 #include <Magnum/Magnum.h>
+#include <cstring>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "esp/scene/SceneManager.h"
 #include "esp/scene/SceneNode.h"
+#include "esp/sensor/RedwoodNoiseModelCPU.h"
 #include "esp/sensor/Sensor.h"
 #include "esp/sensor/SensorFactory.h"
 
@@ -18,11 +24,13 @@ struct SensorTest : Cr::TestSuite::Tester {
   explicit SensorTest();
 
   void testSensorFactory();
+  void testRedwoodNoiseModelThreadCount();
 };
 
 SensorTest::SensorTest() {
   // clang-format off
-  addTests({&SensorTest::testSensorFactory});
+  addTests({&SensorTest::testSensorFactory,
+            &SensorTest::testRedwoodNoiseModelThreadCount});
   // clang-format on
 }
 
@@ -98,4 +106,42 @@ void SensorTest::testSensorFactory() {
   CORRADE_VERIFY(sensorSuite_.getSensors().size() == 0);
 }
 
+void SensorTest::testRedwoodNoiseModelThreadCount() {
+#ifndef _OPENMP
+  CORRADE_SKIP("Built without OpenMP, the noise is simulated on one thread.");
+#else
+  // a distortion model that leaves the depth as is, the noise drawn does not
+  // depend on it
+  const Eigen::RowMatrixXf model = Eigen::RowMatrixXf::Ones(80, 100 * 4);
+  Eigen::RowMatrixXf depth(97, 131);
+  for (int j = 0; j < depth.rows(); ++j) {
+    for (int i = 0; i < depth.cols(); ++i) {
+      depth(j, i) = 0.5f + 12.0f * (j * depth.cols() + i) / depth.size();
+    }
+  }
+
+  const int maxThreads = omp_get_max_threads();
+  std::vector<Eigen::RowMatrixXf> reference;
+  for (const int numThreads : {1, 2, 3, 8}) {
+    CORRADE_ITERATION(numThreads);
+    omp_set_num_threads(numThreads);
+    RedwoodNoiseModelCPUImpl noiseModel{model, 1.0f, 42};
+    for (int k = 0; k < 3; ++k) {
+      Eigen::RowMatrixXf noisyDepth = noiseModel.simulate(depth);
+      if (numThreads == 1) {
+        reference.emplace_back(std::move(noisyDepth));
+      } else {
+        // bit-identical, not just close
+        CORRADE_VERIFY(std::memcmp(noisyDepth.data(), reference[k].data(),
+                                   sizeof(float) * noisyDepth.size()) == 0);
+      }
+    }
+  }
+  omp_set_num_threads(maxThreads);
+
+  // the noise is there to compare in the first place
+  CORRADE_VERIFY(!reference[0].isApprox(reference[1]));
+#endif
+}
+
 CORRADE_TEST_MAIN(SensorTest)
@@ -13,6 +13,7 @@
 #include <string>
 
 #include "esp/assets/ResourceManager.h"
+#include "esp/gfx/RenderTarget.h"
 #include "esp/physics/RigidObject.h"
 #include "esp/sensor/CameraSensor.h"
 #include "esp/sim/Simulator.h"
@@ -126,6 +127,8 @@ struct SimTest : Cr::TestSuite::Tester {
   void loadingObjectTemplates();
   void buildingPrimAssetObjectTemplates();
   void addSensorToObject();
+  void fusedSensorObservations();
+  void asyncSensorObservations();
 
   // TODO: remove outlier pixels from image and lower maxThreshold
   const Magnum::Float maxThreshold = 255.f;
@@ -164,7 +167,9 @@ SimTest::SimTest() {
             &SimTest::recomputeNavmeshWithStaticObjects,
             &SimTest::loadingObjectTemplates,
             &SimTest::buildingPrimAssetObjectTemplates,
-            &SimTest::addSensorToObject}, Cr::Containers::arraySize(SimulatorBuilder) );
+            &SimTest::addSensorToObject,
+            &SimTest::fusedSensorObservations,
+            &SimTest::asyncSensorObservations}, Cr::Containers::arraySize(SimulatorBuilder) );
   // clang-format on
 }
 
@@ -778,6 +783,124 @@ void SimTest::addSensorToObject() {
       Cr::Utility::Directory::join(screenshotDir, "SimTestExpectedScene.png"),
       (Mn::DebugTools::CompareImageToFile{maxThreshold, 0.75f}));
 }
+
+void SimTest::fusedSensorObservations() {
+  Corrade::Utility::Debug() << "Starting Test : fusedSensorObservations ";
+  auto&& data = SimulatorBuilder[testCaseInstanceId()];
+  setTestCaseDescription(data.name);
+  auto simulator = data.creator(*this, vangogh, esp::NO_LIGHT_KEY);
+
+  // co-located color, depth and semantic sensors with the same intrinsics
+  auto uuid = [](SensorType type) {
+    return "sensor" + std::to_string(static_cast<int>(type));
+  };
+  AgentConfiguration agentConfig{};
+  for (SensorType type :
+       {SensorType::Color, SensorType::Depth, SensorType::Semantic}) {
+    auto spec = SensorSpec::create();
+    spec->uuid = uuid(type);
+    spec->sensorSubType = esp::sensor::SensorSubType::Pinhole;
+    spec->sensorType = type;
+    spec->position = {1.0f, 1.5f, 1.0f};
+    spec->resolution = {128, 128};
+    agentConfig.sensorSpecifications.push_back(spec);
+  }
+  Agent::ptr agent = simulator->addAgent(agentConfig);
+  agent->setInitialState(AgentState{});
+
+  esp::sensor::SensorSuite& sensors = agent->getSensorSuite();
+  auto& color =
+      dynamic_cast<CameraSensor&>(*sensors.get(uuid(SensorType::Color)));
+  auto& depth =
+      dynamic_cast<CameraSensor&>(*sensors.get(uuid(SensorType::Depth)));
+  CORRADE_VERIFY(depth.canShareObservationDraw(*simulator, color));
+
+  // the observations read from a shared frame are the ones drawn alone
+  simulator->setFusedSensorRenderingEnabled(false);
+  std::map<std::string, Observation> observations;
+  CORRADE_COMPARE(simulator->getAgentObservations(0, observations), 3);
+  std::map<std::string, std::vector<uint8_t>> expected;
+  for (const auto& observation : observations) {
+    expected[observation.first] =
+        std::vector<uint8_t>(observation.second.buffer->data.begin(),
+                             observation.second.buffer->data.end());
+  }
+
+  simulator->setFusedSensorRenderingEnabled(true);
+  CORRADE_COMPARE(simulator->getAgentObservations(0, observations), 3);
+  for (const auto& observation : observations) {
+    CORRADE_ITERATION(observation.first);
+    CORRADE_VERIFY(
+        std::vector<uint8_t>(observation.second.buffer->data.begin(),
+                             observation.second.buffer->data.end()) ==
+        expected[observation.first]);
+  }
+}
+
+void SimTest::asyncSensorObservations() {
+  Corrade::Utility::Debug() << "Starting Test : asyncSensorObservations ";
+  auto&& data = SimulatorBuilder[testCaseInstanceId()];
+  setTestCaseDescription(data.name);
+  auto simulator = data.creator(*this, vangogh, esp::NO_LIGHT_KEY);
+  // every sensor draws into and reads from its own render target, so each
+  // one rotates through its own pixel and memory buffers below
+  simulator->setFusedSensorRenderingEnabled(false);
+
+  AgentConfiguration agentConfig{};
+  for (SensorType type :
+       {SensorType::Color, SensorType::Depth, SensorType::Semantic}) {
+    auto spec = SensorSpec::create();
+    spec->uuid = "sensor" + std::to_string(static_cast<int>(type));
+    spec->sensorSubType = esp::sensor::SensorSubType::Pinhole;
+    spec->sensorType = type;
+    spec->position = {1.0f, 1.5f, 1.0f};
+    spec->resolution = {128, 128};
+    agentConfig.sensorSpecifications.push_back(spec);
+  }
+  Agent::ptr agent = simulator->addAgent(agentConfig);
+  agent->setInitialState(AgentState{});
+
+  // the synchronous reads are the reference
+  std::map<std::string, Observation> observations;
+  CORRADE_COMPARE(simulator->getAgentObservations(0, observations), 3);
+  std::map<std::string, std::vector<uint8_t>> expected;
+  for (const auto& observation : observations) {
+    CORRADE_VERIFY(!observation.second.pending);
+    expected[observation.first] =
+        std::vector<uint8_t>(observation.second.buffer->data.begin(),
+                             observation.second.buffer->data.end());
+  }
+
+  // three reads of the same frame in flight: the first two go into different
+  // pixel and memory buffers, the third reuses the ones of the first and
+  // finishes it before
+  std::map<std::string, Observation> asyncObservations[3];
+  for (auto& asyncObservation : asyncObservations) {
+    CORRADE_COMPARE(
+        simulator->getAgentObservationsAsync(0, asyncObservation), 3);
+  }
+
+  for (const auto& reference : expected) {
+    CORRADE_ITERATION(reference.first);
+    const Observation& first = asyncObservations[0][reference.first];
+    const Observation& second = asyncObservations[1][reference.first];
+    const Observation& third = asyncObservations[2][reference.first];
+    CORRADE_VERIFY(first.pending && second.pending && third.pending);
+    CORRADE_VERIFY(first.buffer != second.buffer);
+    CORRADE_VERIFY(first.buffer == third.buffer);
+    CORRADE_VERIFY(first.pending->isDone());
+
+    for (const Observation* observation : {&second, &third}) {
+      observation->pending->wait();
+      CORRADE_VERIFY(observation->pending->isDone());
+      CORRADE_VERIFY(
+          std::vector<uint8_t>(observation->buffer->data.begin(),
+                               observation->buffer->data.end()) ==
+          reference.second);
+    }
+  }
+}
+
 }  // namespace
 
 CORRADE_TEST_MAIN(SimTest)
@@ -146,3 +146,105 @@ def test_navmesh_area(test_scene):
             assert math.isclose(recomputedNavMeshArea1, 565.1781616210938)
         elif test_scene.endswith("van-gogh-room.glb"):
             assert math.isclose(recomputedNavMeshArea1, 9.17772102355957)
+
+
+@pytest.mark.parametrize("test_scene", test_scenes)
+def test_recompute_tiled_navmesh(test_scene):
+    if not osp.exists(test_scene):
+        pytest.skip(f"{test_scene} not found")
+
+    cfg_settings = examples.settings.default_sim_settings.copy()
+    cfg_settings["scene"] = test_scene
+    hab_cfg = examples.settings.make_cfg(cfg_settings)
+    with habitat_sim.Simulator(hab_cfg) as sim:
+        navmesh_settings = habitat_sim.NavMeshSettings()
+        navmesh_settings.set_defaults()
+        assert sim.recompute_navmesh(sim.pathfinder, navmesh_settings)
+        single_tile_area = sim.pathfinder.navigable_area
+
+        samples = []
+        for _ in range(100):
+            samples.append(
+                (
+                    sim.pathfinder.get_random_navigable_point(),
+                    sim.pathfinder.get_random_navigable_point(),
+                )
+            )
+        single_tile_results = get_shortest_path(sim, samples)
+
+        # tiles need to be larger than the border they're built with
+        for tile_size in [0.5, 4]:
+            navmesh_settings.tile_size = tile_size
+            assert not sim.recompute_navmesh(sim.pathfinder, navmesh_settings)
+
+        navmesh_settings.tile_size = 64
+        assert sim.recompute_navmesh(sim.pathfinder, navmesh_settings)
+        assert sim.pathfinder.is_loaded
+
+        # Tile borders split polygons but should not change what is navigable
+        assert math.isclose(
+            sim.pathfinder.navigable_area, single_tile_area, rel_tol=0.05
+        )
+
+        tiled_results = get_shortest_path(sim, samples)
+        num_agree = sum(
+            single[0] == tiled[0]
+            for single, tiled in zip(single_tile_results, tiled_results)
+        )
+        assert num_agree >= 0.9 * len(samples)
+
+
+@pytest.mark.skipif(
+    not osp.exists("data/scene_datasets/habitat-test-scenes/skokloster-castle.glb")
+    or not osp.exists("data/objects/"),
+    reason="Requires the habitat-test-scenes and habitat test objects",
+)
+def test_update_navmesh_tiles():
+    cfg_settings = examples.settings.default_sim_settings.copy()
+    cfg_settings[
+        "scene"
+    ] = "data/scene_datasets/habitat-test-scenes/skokloster-castle.glb"
+    cfg_settings["enable_physics"] = True
+    hab_cfg = examples.settings.make_cfg(cfg_settings)
+    with habitat_sim.Simulator(hab_cfg) as sim:
+        obj_mgr = sim.get_object_template_manager()
+        obj_mgr.load_configs("data/objects/", True)
+        obj_handle = obj_mgr.get_template_handles("cheezit")[0]
+
+        navmesh_settings = habitat_sim.NavMeshSettings()
+        navmesh_settings.set_defaults()
+        navmesh_settings.tile_size = 64
+        assert sim.recompute_navmesh(
+            sim.pathfinder, navmesh_settings, include_static_objects=True
+        )
+
+        # nothing changed, nothing to rebuild
+        assert sim.update_navmesh_tiles(sim.pathfinder)
+
+        object_id = sim.add_object_by_handle(obj_handle)
+        sim.set_object_motion_type(habitat_sim.physics.MotionType.STATIC, object_id)
+        sim.set_translation(sim.pathfinder.get_random_navigable_point(), object_id)
+        assert sim.update_navmesh_tiles(sim.pathfinder)
+        assert sim.pathfinder.is_loaded
+        updated_area = sim.pathfinder.navigable_area
+
+        assert sim.recompute_navmesh(
+            sim.pathfinder, navmesh_settings, include_static_objects=True
+        )
+        assert math.isclose(
+            updated_area, sim.pathfinder.navigable_area, rel_tol=1e-3
+        )
+
+        # a navmesh computed without static objects stays without them, and
+        # each pathfinder is updated against the objects it was computed with
+        pathfinder = habitat_sim.PathFinder()
+        assert not sim.update_navmesh_tiles(pathfinder)
+        assert sim.recompute_navmesh(
+            pathfinder, navmesh_settings, include_static_objects=False
+        )
+        area_without_objects = pathfinder.navigable_area
+        sim.set_translation(sim.pathfinder.get_random_navigable_point(), object_id)
+        assert sim.update_navmesh_tiles(pathfinder)
+        assert pathfinder.navigable_area == area_without_objects
+        assert sim.update_navmesh_tiles(sim.pathfinder)
+        assert sim.pathfinder.navigable_area < area_without_objects
@@ -17,6 +17,16 @@ from habitat_sim.sensors.noise_models.redwood_depth_noise_model import (
 )
 
 
+def _load_redwood_model():
+    return np.load(
+        osp.join(
+            osp.dirname(redwood_depth_noise_model.__file__),
+            "data",
+            "redwood-depth-dist-model.npy",
+        )
+    )
+
+
 @pytest.mark.gfxtest
 @pytest.mark.skipif(not habitat_sim.cuda_enabled, reason="Test requires cuda")
 @pytest.mark.parametrize("noise_multiplier,tolerance", [(0.0, 1e-5), (1.0, 5e-2)])
@@ -27,14 +37,7 @@ def test_compare_gpu_cpu_redwood_depth(noise_multiplier: float, tolerance: float
         noise_multiplier=noise_multiplier, gpu_device_id=0
     )
     cpu_impl = RedwoodNoiseModelCPUImpl(
-        np.load(
-            osp.join(
-                osp.dirname(redwood_depth_noise_model.__file__),
-                "data",
-                "redwood-depth-dist-model.npy",
-            )
-        ),
-        noise_multiplier=noise_multiplier,
+        _load_redwood_model(), noise_multiplier=noise_multiplier
     )
 
     NUM_SIMS = 20
@@ -45,3 +48,54 @@ def test_compare_gpu_cpu_redwood_depth(noise_multiplier: float, tolerance: float
     cpu_depth = np.mean(np.stack(cpu_depths, 0), 0)
 
     assert np.abs(cuda_depth - cpu_depth).mean() <= tolerance
+
+
+def test_redwood_depth_cpu_seed():
+    depth = np.linspace(0, 20, num=(256 * 256), dtype=np.float32).reshape(256, 256)
+    model = _load_redwood_model()
+
+    first = RedwoodNoiseModelCPUImpl(model, noise_multiplier=1.0, seed=7)
+    second = RedwoodNoiseModelCPUImpl(model, noise_multiplier=1.0, seed=7)
+    first_depths = [first.simulate(depth) for _ in range(3)]
+    second_depths = [second.simulate(depth) for _ in range(3)]
+
+    # the same seed draws the same sequence of noise, every call new noise
+    for first_depth, second_depth in zip(first_depths, second_depths):
+        assert np.array_equal(first_depth, second_depth)
+    assert not np.array_equal(first_depths[0], first_depths[1])
+
+    first.set_seed(7)
+    assert np.array_equal(first.simulate(depth), first_depths[0])
+    first.set_seed(8)
+    assert not np.array_equal(first.simulate(depth), first_depths[0])
+
+    # the sensor returns nothing beyond 10 meters
+    assert (first_depths[0][depth >= 10.0] == 0.0).all()
+
+
+def test_redwood_depth_cpu_noise():
+    depth = np.full((256, 256), 2.0, dtype=np.float32)
+    model = _load_redwood_model()
+
+    noiseless = RedwoodNoiseModelCPUImpl(model, noise_multiplier=0.0).simulate(depth)
+    noisy = RedwoodNoiseModelCPUImpl(model, noise_multiplier=1.0).simulate(depth)
+
+    assert noisy.shape == depth.shape
+    assert noisy.std() > noiseless.std()
+    assert abs(noisy.mean() - noiseless.mean()) < 5e-2
+
+
+@pytest.mark.skipif(habitat_sim.cuda_enabled, reason="Test requires the CPU model")
+def test_redwood_depth_default_seed():
+    depth = np.linspace(0, 20, num=(256 * 256), dtype=np.float32).reshape(256, 256)
+
+    # without a seed, the noise follows numpy's global random state
+    np.random.seed(3)
+    first = RedwoodDepthNoiseModel()
+    np.random.seed(3)
+    second = RedwoodDepthNoiseModel()
+    np.random.seed(4)
+    third = RedwoodDepthNoiseModel()
+    first_depth = first.simulate(depth)
+    assert np.array_equal(first_depth, second.simulate(depth))
+    assert not np.array_equal(first_depth, third.simulate(depth))
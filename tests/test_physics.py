@@ -413,6 +413,33 @@ def test_raycast():
             assert abs(raycast_results.hits[0].ray_distance - 2.8935) < 0.001
             assert raycast_results.hits[0].object_id == 0
 
+            # a batch of rays gives the same hits in flat arrays
+            test_ray_2 = habitat_sim.geo.Ray()
+            test_ray_2.direction = mn.Vector3(0, 0, 1.0)
+            batch_results = sim.cast_rays([test_ray_1, test_ray_2])
+            assert batch_results.num_rays() == 2
+            assert batch_results.num_hits(0) == 2
+            offsets = batch_results.ray_hit_offsets
+            assert offsets[0] == 0 and offsets[1] == 2
+            assert len(batch_results.object_ids) == offsets[2]
+            assert batch_results.points.shape == (offsets[2], 3)
+            assert batch_results.normals.shape == (offsets[2], 3)
+            assert len(batch_results.ray_distances) == offsets[2]
+            for i, hit in enumerate(raycast_results.hits):
+                assert batch_results.object_ids[i] == hit.object_id
+                assert np.allclose(batch_results.points[i], hit.point, atol=1e-4)
+                assert np.allclose(batch_results.normals[i], hit.normal, atol=1e-4)
+                assert abs(batch_results.ray_distances[i] - hit.ray_distance) < 1e-4
+            ray_2_hits = sim.cast_ray(test_ray_2).hits
+            assert batch_results.num_hits(1) == len(ray_2_hits)
+
+            batch_results = sim.cast_rays(
+                [test_ray_1, test_ray_2], closest_hit_only=True
+            )
+            assert batch_results.num_hits(0) == 1
+            assert batch_results.object_ids[0] == 0
+            assert batch_results.num_hits(1) == min(len(ray_2_hits), 1)
+
             # test raycast against a non-collidable object.
             # should not register a hit with the object.
             sim.set_object_is_collidable(False, cube_obj_id)